@@ -0,0 +1,33 @@
+#include "BenchmarkApplication.hpp"
+
+#include "Application.hpp"
+#include "common/Args.hpp"
+#include "providers/emoji/Emojis.hpp"
+#include "singletons/Emotes.hpp"
+#include "singletons/Paths.hpp"
+#include "singletons/Settings.hpp"
+
+#include <QStandardPaths>
+
+namespace chatterino {
+
+Application &benchmarkApplication()
+{
+    // Never destroyed, like in the real application
+    static auto *app = [] {
+        QStandardPaths::setTestModeEnabled(true);
+        initArgs(*qApp);
+
+        auto *paths = new Paths;
+        auto *settings = new Settings(paths->settingsDirectory);
+        auto *app = new Application(*settings, *paths);
+
+        app->emotes->emojis.load();
+
+        return app;
+    }();
+
+    return *app;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QApplication>
+
+#include <utility>
+
+namespace chatterino {
+
+class Application;
+
+// Creates the application singletons (settings, fonts, themes, the Twitch
+// server, ...) without connecting to anything or opening windows. Settings
+// and caches are kept in Qt's test locations, away from the user's.
+//
+// Must be called from the GUI thread. Returns the same instance every time.
+Application &benchmarkApplication();
+
+// Everything that uses getApp() has to run in the GUI thread, benchmarks run
+// on a separate one (see main.cpp)
+template <typename Fn>
+void runInGuiThread(Fn &&fn)
+{
+    QMetaObject::invokeMethod(qApp, std::forward<Fn>(fn),
+                              Qt::BlockingQueuedConnection);
+}
+
+}  // namespace chatterino
@@ -0,0 +1,160 @@
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Generated capture, used if CHATTERINO_BENCHMARK_IRC_LOG isn't set
+constexpr int GENERATED_LINE_COUNT = 20'000;
+
+std::vector<QByteArray> generateCapture()
+{
+    std::mt19937 rng(1337);
+
+    const std::vector<QByteArray> texts{
+        "Kappa Kappa hello chat",
+        "LUL that was so bad",
+        "what is going on here, can someone explain the last 5 minutes?",
+        "PogChamp",
+        "\xc3\xa4\xc3\xb6\xc3\xbc unicode \xf0\x9f\x90\xa7 test",
+    };
+    const std::vector<QByteArray> emotes{
+        "25:0-4,6-10",
+        "",
+        "",
+        "305954156:0-7",
+        "",
+    };
+
+    std::vector<QByteArray> lines;
+    lines.reserve(GENERATED_LINE_COUNT);
+
+    for (int i = 0; i < GENERATED_LINE_COUNT; i++)
+    {
+        auto user = "chatter" + QByteArray::number(int(rng() % 2000));
+        auto text = rng() % texts.size();
+        auto kind = rng() % 100;
+
+        if (kind < 90)
+        {
+            lines.push_back(
+                "@badge-info=subscriber/" + QByteArray::number(i % 48) +
+                ";badges=subscriber/12,premium/1;client-nonce=" +
+                QByteArray::number(i) + ";color=#FF0000;display-name=" + user +
+                ";emotes=" + emotes[text] +
+                ";first-msg=0;flags=;id=c5fd49c7-ecbc-46dd-a790-" +
+                QByteArray::number(i) +
+                ";mod=0;room-id=11148817;subscriber=1;tmi-sent-ts="
+                "1567282184553;turbo=0;user-id=125608098;user-type= :" +
+                user + "!" + user + "@" + user +
+                ".tmi.twitch.tv PRIVMSG #pajlada :" + texts[text]);
+        }
+        else if (kind < 95)
+        {
+            lines.push_back(
+                "@badge-info=;badges=premium/1;color=;display-name=" + user +
+                ";emotes=;flags=;id=" + QByteArray::number(i) +
+                ";login=" + user +
+                ";mod=0;msg-id=resub;msg-param-cumulative-months=3;"
+                "room-id=11148817;system-msg=" +
+                user +
+                "\\ssubscribed\\sat\\sTier\\s1.;tmi-sent-ts=1567282184553;"
+                "user-id=1;user-type= :tmi.twitch.tv USERNOTICE #pajlada :" +
+                texts[text]);
+        }
+        else if (kind < 98)
+        {
+            lines.push_back("@ban-duration=600;room-id=11148817;"
+                            "target-user-id=1;tmi-sent-ts=1567282184553 "
+                            ":tmi.twitch.tv CLEARCHAT #pajlada :" +
+                            user);
+        }
+        else
+        {
+            lines.push_back(":" + user + "!" + user + "@" + user +
+                            ".tmi.twitch.tv JOIN #pajlada");
+        }
+    }
+
+    return lines;
+}
+
+const std::vector<QByteArray> &capture()
+{
+    static auto lines = [] {
+        auto path = qEnvironmentVariable("CHATTERINO_BENCHMARK_IRC_LOG");
+        if (path.isEmpty())
+        {
+            return generateCapture();
+        }
+
+        // One raw IRC line per line, e.g. recorded with IRC_DEBUG=1
+        std::vector<QByteArray> lines;
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly))
+        {
+            while (!file.atEnd())
+            {
+                auto line = file.readLine().trimmed();
+                if (!line.isEmpty())
+                {
+                    lines.push_back(line);
+                }
+            }
+        }
+        return lines;
+    }();
+
+    return lines;
+}
+
+void setLinesPerSecond(benchmark::State &state, size_t lineCount)
+{
+    state.counters["lines_per_second"] =
+        benchmark::Counter(double(state.iterations()) * double(lineCount),
+                           benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+// Parses every line with Communi and splits badges and emotes the way
+// TwitchMessageBuilder does
+static void BM_IrcReplayCommuni(benchmark::State &state)
+{
+    const auto &lines = capture();
+
+    for (auto _ : state)
+    {
+        for (const auto &line : lines)
+        {
+            std::unique_ptr<Communi::IrcMessage> message(
+                Communi::IrcMessage::fromData(line, nullptr));
+
+            auto tags = message->tags();
+            auto badges =
+                tags.value("badges").toString().split(',', Qt::SkipEmptyParts);
+            for (const auto &badge : badges)
+            {
+                benchmark::DoNotOptimize(badge.split('/'));
+            }
+            auto emotes = tags.value("emotes").toString().split('/');
+            for (const auto &emote : emotes)
+            {
+                benchmark::DoNotOptimize(emote.split(':'));
+            }
+            benchmark::DoNotOptimize(message->nick());
+            benchmark::DoNotOptimize(message->parameters());
+        }
+    }
+
+    setLinesPerSecond(state, lines.size());
+}
+
+BENCHMARK(BM_IrcReplayCommuni)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,367 @@
+#include "Application.hpp"
+#include "BenchmarkApplication.hpp"
+#include "messages/Emote.hpp"
+#include "messages/Image.hpp"
+#include "messages/ImageSet.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/MessageElement.hpp"
+#include "messages/Selection.hpp"
+#include "messages/layouts/MessageLayout.hpp"
+#include "messages/layouts/TextRunCache.hpp"
+#include "singletons/Settings.hpp"
+#include "singletons/WindowManager.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QTime>
+
+#include <climits>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+constexpr int CORPUS_SIZE = 50;
+
+enum class MessageKind {
+    EmoteDense,
+    LongText,
+    ManyBadges,
+    RtlAndEmoji,
+};
+
+const MessageElementFlags LAYOUT_FLAGS = [] {
+    MessageElementFlags flags(MessageElementFlag::Default);
+    flags.set(MessageElementFlag::EmojiImage);
+    flags.set(MessageElementFlag::BoldUsername);
+    return flags;
+}();
+
+EmotePtr makeEmote(const QString &name, QSize size, QColor color)
+{
+    // Local images, so nothing is downloaded
+    QPixmap pixmap(size);
+    pixmap.fill(color);
+
+    return std::make_shared<const Emote>(Emote{
+        EmoteName{name},
+        ImageSet{Image::fromPixmap(pixmap), Image::fromPixmap(pixmap, 0.5),
+                 Image::fromPixmap(pixmap, 0.25)},
+        Tooltip{name},
+        Url{},
+    });
+}
+
+MessagePtr makeMessage(MessageKind kind, int index)
+{
+    static const auto emote = makeEmote("Kappa", {28, 28}, Qt::gray);
+    static const auto wideEmote = makeEmote("catJAM", {84, 28}, Qt::blue);
+    static const auto emoji = makeEmote(":penguin:", {20, 20}, Qt::black);
+    static const auto badge = makeEmote("subscriber", {18, 18}, Qt::red);
+
+    MessageBuilder builder;
+    builder.emplace<TimestampElement>(QTime(12, 34, index % 60));
+
+    int badgeCount = kind == MessageKind::ManyBadges ? 8 : 2;
+    for (int i = 0; i < badgeCount; i++)
+    {
+        builder.emplace<BadgeElement>(badge,
+                                      MessageElementFlag::BadgeSubscription);
+    }
+
+    builder
+        .emplace<TextElement>("chatter" + QString::number(index) + ":",
+                              MessageElementFlag::Username,
+                              MessageColor(QColor("#ff7f50")),
+                              FontStyle::ChatMediumBold)
+        ->setLink({Link::UserInfo, "chatter" + QString::number(index)});
+
+    switch (kind)
+    {
+        case MessageKind::EmoteDense: {
+            for (int i = 0; i < 30; i++)
+            {
+                builder.emplace<EmoteElement>(
+                    i % 5 == 0 ? wideEmote : emote,
+                    MessageElementFlag::TwitchEmote);
+                if (i % 7 == 0)
+                {
+                    builder.emplace<TextElement>("LUL",
+                                                 MessageElementFlag::Text);
+                }
+            }
+        }
+        break;
+
+        case MessageKind::LongText: {
+            QString text;
+            for (int i = 0; text.length() < 400; i++)
+            {
+                text += (i % 3 == 0 ? "something " : "what ") +
+                        QString::number(index + i) + " ";
+            }
+            builder.emplace<TextElement>(text, MessageElementFlag::Text);
+        }
+        break;
+
+        case MessageKind::ManyBadges: {
+            builder.emplace<TextElement>("hello chat, how is everyone doing",
+                                         MessageElementFlag::Text);
+        }
+        break;
+
+        case MessageKind::RtlAndEmoji: {
+            builder.emplace<TextElement>(
+                QString::fromUtf8("\xd9\x85\xd8\xb1\xd8\xad\xd8\xa8\xd8\xa7 "
+                                  "\xd8\xa8\xd8\xa7\xd9\x84\xd8\xb9\xd8\xa7"
+                                  "\xd9\x84\xd9\x85 \xd7\xa9\xd7\x9c\xd7\x95"
+                                  "\xd7\x9d"),
+                MessageElementFlag::Text);
+            for (int i = 0; i < 6; i++)
+            {
+                builder.emplace<EmoteElement>(emoji,
+                                              MessageElementFlag::EmojiAll);
+            }
+            builder.emplace<TextElement>(
+                QString::fromUtf8("\xe2\x9c\x85 unicode \xc3\xa4\xc3\xb6 "
+                                  "\xe4\xbd\xa0\xe5\xa5\xbd "
+                                  "\xf0\x9f\x91\x8b\xf0\x9f\x8f\xbd"),
+                MessageElementFlag::Text);
+        }
+        break;
+    }
+
+    return builder.release();
+}
+
+std::vector<MessagePtr> makeMessages(MessageKind kind)
+{
+    std::vector<MessagePtr> messages;
+    messages.reserve(CORPUS_SIZE);
+
+    for (int i = 0; i < CORPUS_SIZE; i++)
+    {
+        messages.push_back(makeMessage(kind, i));
+    }
+
+    return messages;
+}
+
+std::vector<MessageLayoutPtr> makeLayouts(
+    const std::vector<MessagePtr> &messages)
+{
+    std::vector<MessageLayoutPtr> layouts;
+    layouts.reserve(messages.size());
+
+    for (const auto &message : messages)
+    {
+        layouts.push_back(std::make_shared<MessageLayout>(message));
+    }
+
+    return layouts;
+}
+
+std::vector<MessageLayoutPtr> makeLayouts(MessageKind kind)
+{
+    return makeLayouts(makeMessages(kind));
+}
+
+void layoutAll(const std::vector<MessageLayoutPtr> &layouts, int width,
+               float scale)
+{
+    for (const auto &layout : layouts)
+    {
+        layout->layout(width, scale, LAYOUT_FLAGS);
+    }
+}
+
+void setMessagesPerSecond(benchmark::State &state)
+{
+    state.counters["messages_per_second"] = benchmark::Counter(
+        double(state.iterations()) * CORPUS_SIZE, benchmark::Counter::kIsRate);
+}
+
+// The benchmark loops run in the GUI thread, laying out and painting messages
+// uses getApp()
+template <typename Fn>
+void runBenchmark(benchmark::State &state, Fn &&fn)
+{
+    runInGuiThread([&] {
+        benchmarkApplication();
+        fn();
+    });
+}
+
+}  // namespace
+
+// Lays out all messages from scratch, like after a font or emote change.
+// Arguments: message kind, width, scale in percent.
+static void BM_MessageLayout(benchmark::State &state)
+{
+    runBenchmark(state, [&] {
+        auto layouts = makeLayouts(MessageKind(state.range(0)));
+        auto width = int(state.range(1));
+        auto scale = float(state.range(2)) / 100.f;
+
+        for (auto _ : state)
+        {
+            // Forces a layout without using the layouts shared between views
+            getApp()->windows->incGeneration();
+            layoutAll(layouts, width, scale);
+        }
+
+        setMessagesPerSecond(state);
+    });
+}
+
+// Alternates between two widths, like while resizing a split
+static void BM_MessageRelayoutWidthChange(benchmark::State &state)
+{
+    runBenchmark(state, [&] {
+        auto layouts = makeLayouts(MessageKind(state.range(0)));
+        layoutAll(layouts, 500, 1.f);
+
+        int width = 500;
+        for (auto _ : state)
+        {
+            width = width == 500 ? 480 : 500;
+            layoutAll(layouts, width, 1.f);
+        }
+
+        setMessagesPerSecond(state);
+    });
+}
+
+// A second view showing the same messages
+static void BM_MessageLayoutShared(benchmark::State &state)
+{
+    runBenchmark(state, [&] {
+        auto messages = makeMessages(MessageKind(state.range(0)));
+        auto layouts = makeLayouts(messages);
+        layoutAll(layouts, 500, 1.f);
+
+        for (auto _ : state)
+        {
+            for (const auto &message : messages)
+            {
+                MessageLayout other(message);
+                other.layout(500, 1.f, LAYOUT_FLAGS);
+                benchmark::DoNotOptimize(other.getHeight());
+            }
+        }
+
+        setMessagesPerSecond(state);
+    });
+}
+
+// Paints all messages into an image, redrawing their buffers.
+// Arguments: message kind, whether text runs are cached (see TextRunCache).
+static void BM_MessagePaint(benchmark::State &state)
+{
+    runBenchmark(state, [&] {
+        // The containers paint with the settings they were laid out with
+        getSettings()->cacheTextRuns.setValue(state.range(1) != 0);
+        TextRunCache::instance().clear();
+
+        auto layouts = makeLayouts(MessageKind(state.range(0)));
+        constexpr int width = 500;
+        layoutAll(layouts, width, 1.f);
+
+        QImage image(width, 200, QImage::Format_ARGB32_Premultiplied);
+        Selection selection;
+
+        for (auto _ : state)
+        {
+            QPainter painter(&image);
+            for (size_t i = 0; i < layouts.size(); i++)
+            {
+                layouts[i]->invalidateBuffer();
+                layouts[i]->paint(painter, width, 0, int(i), selection, false,
+                                  true, false);
+            }
+        }
+
+        setMessagesPerSecond(state);
+        getSettings()->cacheTextRuns.setValue(true);
+    });
+}
+
+// Copies the text of all messages, like selecting everything and pressing
+// ctrl+c
+static void BM_MessageSelectionText(benchmark::State &state)
+{
+    runBenchmark(state, [&] {
+        auto layouts = makeLayouts(MessageKind(state.range(0)));
+        layoutAll(layouts, 500, 1.f);
+
+        for (auto _ : state)
+        {
+            QString text;
+            for (const auto &layout : layouts)
+            {
+                layout->addSelectionText(text, 0, INT_MAX,
+                                         CopyMode::Everything);
+                text += '\n';
+            }
+            benchmark::DoNotOptimize(text);
+        }
+
+        setMessagesPerSecond(state);
+    });
+}
+
+const std::initializer_list<MessageKind> MESSAGE_KINDS = {
+    MessageKind::EmoteDense,
+    MessageKind::LongText,
+    MessageKind::ManyBadges,
+    MessageKind::RtlAndEmoji,
+};
+
+static void messageKinds(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgName("kind");
+    for (auto kind : MESSAGE_KINDS)
+    {
+        benchmark->Arg(int(kind));
+    }
+}
+
+static void paintArguments(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgNames({"kind", "textRunCache"});
+    for (auto kind : MESSAGE_KINDS)
+    {
+        for (auto cache : {0, 1})
+        {
+            benchmark->Args({int(kind), cache});
+        }
+    }
+}
+
+static void layoutArguments(benchmark::internal::Benchmark *benchmark)
+{
+    benchmark->ArgNames({"kind", "width", "scale"});
+    for (auto kind : MESSAGE_KINDS)
+    {
+        for (auto width : {250, 500, 1000})
+        {
+            for (auto scale : {100, 200})
+            {
+                benchmark->Args({int(kind), width, scale});
+            }
+        }
+    }
+}
+
+BENCHMARK(BM_MessageLayout)->Apply(layoutArguments);
+BENCHMARK(BM_MessageRelayoutWidthChange)->Apply(messageKinds);
+BENCHMARK(BM_MessageLayoutShared)->Apply(messageKinds);
+BENCHMARK(BM_MessagePaint)->Apply(paintArguments);
+BENCHMARK(BM_MessageSelectionText)->Apply(messageKinds);
@@ -0,0 +1,151 @@
+#include "messages/Message.hpp"
+#include "util/InternString.hpp"
+
+#include <benchmark/benchmark.h>
+#include <QString>
+
+#include <random>
+#include <unordered_set>
+
+using namespace chatterino;
+
+namespace {
+
+constexpr int CORPUS_SIZE = 100'000;
+constexpr int CHATTER_COUNT = 2'000;
+
+// Mirrors what TwitchMessageBuilder does with the strings it gets from the
+// IRC line: every message gets freshly parsed strings, which are then
+// optionally interned
+QString parsed(const QByteArray &source, bool intern)
+{
+    auto string = QString::fromUtf8(source);
+    return intern ? internString(string) : string;
+}
+
+std::vector<std::shared_ptr<Message>> buildCorpus(bool intern)
+{
+    std::mt19937 rng(1337);
+    // A few chatters write most of the messages
+    std::geometric_distribution<int> chatterDistribution(0.005);
+    std::uniform_int_distribution<int> wordCount(1, 20);
+
+    const QByteArray channelName = "pajlada";
+    const std::vector<QByteArray> words{
+        "Kappa", "PogChamp", "hello", "what", "is", "going", "on",
+        "LUL",   "xD",       "true",  "no",   "way", "chat",  "pog",
+    };
+
+    std::vector<std::shared_ptr<Message>> corpus;
+    corpus.reserve(CORPUS_SIZE);
+
+    for (int i = 0; i < CORPUS_SIZE; i++)
+    {
+        int chatter = chatterDistribution(rng) % CHATTER_COUNT;
+        auto login = "chatter" + QByteArray::number(chatter);
+
+        auto message = std::make_shared<Message>();
+        message->id = QString::number(i);
+        message->loginName = parsed(login, intern);
+        message->displayName = parsed(login.toUpper(), intern);
+        message->channelName = parsed(channelName, intern);
+
+        QByteArray text;
+        for (int j = wordCount(rng); j > 0; j--)
+        {
+            text += words[rng() % words.size()] + ' ';
+        }
+        message->messageText = QString::fromUtf8(text.trimmed());
+        message->searchText = message->loginName + ": " + message->messageText;
+
+        if (chatter % 3 == 0)
+        {
+            auto months = QByteArray::number(chatter % 48 + 1);
+            message->badges.emplace_back(parsed("subscriber", intern),
+                                         parsed(months, intern));
+            message->badgeInfos.emplace(parsed("subscriber", intern),
+                                        parsed(months, intern));
+        }
+        if (chatter % 5 == 0)
+        {
+            message->badges.emplace_back(parsed("premium", intern),
+                                         parsed("1", intern));
+        }
+        if (chatter % 50 == 0)
+        {
+            message->badges.emplace_back(parsed("moderator", intern),
+                                         parsed("1", intern));
+        }
+
+        corpus.push_back(std::move(message));
+    }
+
+    return corpus;
+}
+
+// Approximate heap usage of a corpus. Implicitly shared string data is only
+// counted once
+size_t corpusBytes(const std::vector<std::shared_ptr<Message>> &corpus)
+{
+    std::unordered_set<const void *> seen;
+
+    auto stringBytes = [&](const QString &string) -> size_t {
+        if (string.isNull() || !seen.insert(string.constData()).second)
+        {
+            return 0;
+        }
+        // QArrayData header + utf16 payload
+        return sizeof(QArrayData) + (size_t(string.capacity()) + 1) * 2;
+    };
+
+    size_t total = 0;
+    for (const auto &message : corpus)
+    {
+        total += sizeof(Message);
+        total += stringBytes(message->id);
+        total += stringBytes(message->searchText);
+        total += stringBytes(message->messageText);
+        total += stringBytes(message->loginName);
+        total += stringBytes(message->displayName);
+        total += stringBytes(message->localizedName);
+        total += stringBytes(message->timeoutUser);
+        total += stringBytes(message->channelName);
+
+        total += message->badges.capacity() * sizeof(Badge);
+        for (const auto &badge : message->badges)
+        {
+            total += stringBytes(badge.key_);
+            total += stringBytes(badge.value_);
+        }
+
+        total += message->badgeInfos.capacity() *
+                 sizeof(MessageBadgeInfos::value_type);
+        for (const auto &[key, value] : message->badgeInfos)
+        {
+            total += stringBytes(key);
+            total += stringBytes(value);
+        }
+    }
+
+    return total;
+}
+
+}  // namespace
+
+// Arg 0: strings as parsed, Arg 1: interned strings
+static void BM_MessageMemory(benchmark::State &state)
+{
+    bool intern = state.range(0) != 0;
+    size_t bytes = 0;
+
+    for (auto _ : state)
+    {
+        auto corpus = buildCorpus(intern);
+        bytes = corpusBytes(corpus);
+        benchmark::DoNotOptimize(corpus);
+    }
+
+    state.counters["bytes_per_message"] = double(bytes) / CORPUS_SIZE;
+}
+
+BENCHMARK(BM_MessageMemory)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
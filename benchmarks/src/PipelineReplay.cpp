@@ -0,0 +1,545 @@
+#include "Application.hpp"
+#include "BenchmarkApplication.hpp"
+#include "common/Channel.hpp"
+#include "providers/twitch/IrcMessageHandler.hpp"
+#include "providers/twitch/TwitchIrcServer.hpp"
+#include "singletons/Settings.hpp"
+#include "widgets/helper/ChannelView.hpp"
+
+#include <benchmark/benchmark.h>
+#include <IrcMessage>
+#include <QApplication>
+#include <QByteArray>
+#include <QFile>
+#include <QImage>
+
+#ifdef Q_OS_WIN
+#    define NOMINMAX
+#    include <Windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <random>
+#include <thread>
+#include <vector>
+
+#ifndef CHATTERINO_BENCHMARK_COUNT_ALLOCATIONS
+// Replacing the allocator affects every benchmark in the same executable
+#    error "Only built into chatterino-pipeline-benchmark, see CMakeLists.txt"
+#endif
+
+using namespace chatterino;
+
+static std::atomic<uint64_t> allocationCount{0};
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+// Counts every heap allocation in chatterino-pipeline-benchmark. Qt's
+// containers and strings allocate with malloc directly, operator new ends up
+// here as well. The executable's malloc takes precedence over the one in libc
+// for all shared libraries.
+constexpr bool COUNTS_MALLOC = true;
+
+extern "C" {
+
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+
+}  // extern "C"
+#else
+// Without a way to replace malloc only allocations made through operator
+// new are counted, Qt's containers and strings aren't included
+constexpr bool COUNTS_MALLOC = false;
+
+void *operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (auto *ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+namespace {
+
+constexpr int GENERATED_LINE_COUNT = 9'000;
+// Lines per second of the generated capture, a busy channel during a raid
+constexpr double GENERATED_LINE_RATE = 150;
+
+constexpr int VIEW_WIDTH = 500;
+constexpr int VIEW_HEIGHT = 800;
+// The view is painted at most this often, like a 60 Hz screen would
+constexpr int64_t FRAME_INTERVAL_NS = 16'666'667;
+
+struct CaptureLine {
+    QByteArray data;
+    // Milliseconds since the first line
+    int64_t offsetMs;
+};
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+int64_t sentTimestamp(const QByteArray &line)
+{
+    static const QByteArray tag = "tmi-sent-ts=";
+
+    auto start = line.indexOf(tag);
+    if (start == -1)
+    {
+        return -1;
+    }
+    start += tag.size();
+
+    auto end = start;
+    while (end < line.size() && line[end] >= '0' && line[end] <= '9')
+    {
+        end++;
+    }
+    return line.mid(start, end - start).toLongLong();
+}
+
+std::vector<CaptureLine> generateCapture()
+{
+    std::mt19937 rng(1337);
+    std::exponential_distribution<double> interval(GENERATED_LINE_RATE /
+                                                   1000.0);
+
+    const std::vector<QByteArray> texts{
+        "Kappa Kappa hello chat",
+        "LUL that was so bad",
+        "what is going on here, can someone explain the last 5 minutes?",
+        "PogChamp",
+        "\xc3\xa4\xc3\xb6\xc3\xbc unicode \xf0\x9f\x90\xa7 test",
+        "@chatter12 no way :) https://chatterino.com",
+    };
+    const std::vector<QByteArray> emotes{
+        "25:0-4,6-10", "", "", "305954156:0-7", "", "1:20-21",
+    };
+
+    std::vector<CaptureLine> lines;
+    lines.reserve(GENERATED_LINE_COUNT);
+
+    double offset = 0;
+    for (int i = 0; i < GENERATED_LINE_COUNT; i++)
+    {
+        // The middle third is a raid, five times as busy
+        bool raid = i > GENERATED_LINE_COUNT / 3 &&
+                    i < GENERATED_LINE_COUNT * 2 / 3;
+        offset += interval(rng) / (raid ? 5 : 1);
+
+        auto ts = QByteArray::number(1567282184553 + int64_t(offset));
+        auto user = "chatter" + QByteArray::number(int(rng() % 2000));
+        auto text = rng() % texts.size();
+        auto kind = rng() % 100;
+        QByteArray line;
+
+        if (kind < 90)
+        {
+            line = "@badge-info=subscriber/" + QByteArray::number(i % 48) +
+                   ";badges=subscriber/12,premium/1;color=#FF0000;"
+                   "display-name=" +
+                   user + ";emotes=" + emotes[text] + ";first-msg=0;flags=;" +
+                   "id=msg-" + QByteArray::number(i) +
+                   ";mod=0;room-id=11148817;subscriber=1;tmi-sent-ts=" + ts +
+                   ";turbo=0;user-id=125608098;user-type= :" + user + "!" +
+                   user + "@" + user + ".tmi.twitch.tv PRIVMSG #pajlada :" +
+                   texts[text];
+        }
+        else if (kind < 94)
+        {
+            line = "@badge-info=;badges=premium/1;color=;display-name=" + user +
+                   ";emotes=;flags=;id=" + QByteArray::number(i) +
+                   ";login=" + user +
+                   ";mod=0;msg-id=resub;msg-param-cumulative-months=3;"
+                   "room-id=11148817;system-msg=" +
+                   user +
+                   "\\ssubscribed\\sat\\sTier\\s1.;tmi-sent-ts=" + ts +
+                   ";user-id=1;user-type= :tmi.twitch.tv USERNOTICE #pajlada "
+                   ":" +
+                   texts[text];
+        }
+        else if (kind < 97)
+        {
+            line = "@ban-duration=600;room-id=11148817;target-user-id=1;"
+                   "tmi-sent-ts=" +
+                   ts + " :tmi.twitch.tv CLEARCHAT #pajlada :" + user;
+        }
+        else
+        {
+            // Deletes one of the recent messages
+            auto target = std::max(0, i - int(rng() % 50));
+            line = "@login=" + user + ";room-id=;target-msg-id=msg-" +
+                   QByteArray::number(target) + ";tmi-sent-ts=" + ts +
+                   " :tmi.twitch.tv CLEARMSG #pajlada :" + texts[text];
+        }
+
+        lines.push_back({line, int64_t(offset)});
+    }
+
+    return lines;
+}
+
+const std::vector<CaptureLine> &capture()
+{
+    static auto lines = [] {
+        auto path = qEnvironmentVariable("CHATTERINO_BENCHMARK_IRC_LOG");
+        if (path.isEmpty())
+        {
+            return generateCapture();
+        }
+
+        // One raw IRC line per line, timed by their tmi-sent-ts tags
+        std::vector<CaptureLine> lines;
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly))
+        {
+            int64_t first = -1;
+            int64_t offset = 0;
+            while (!file.atEnd())
+            {
+                auto line = file.readLine().trimmed();
+                if (line.isEmpty())
+                {
+                    continue;
+                }
+
+                auto ts = sentTimestamp(line);
+                if (ts != -1)
+                {
+                    if (first == -1)
+                    {
+                        first = ts;
+                    }
+                    // Lines are recorded in the order they arrived
+                    offset = std::max(offset, ts - first);
+                }
+                lines.push_back({line, offset});
+            }
+        }
+        return lines;
+    }();
+
+    return lines;
+}
+
+// Sets up a channel and an offscreen view showing it. Never destroyed, like
+// the application itself.
+struct ReplayEnvironment {
+    ReplayEnvironment()
+        : app(&benchmarkApplication())
+    {
+        // Images would be downloaded while painting, which makes the results
+        // depend on the network
+        getSettings()->enableEmoteImages.setValue(false);
+
+        this->channel = this->app->twitch->getOrAddChannel("pajlada");
+
+        // Connected before the view, so this runs once the message is built
+        // and before the view lays it out
+        this->channel->messageAppended.connect([this](auto &, auto) {
+            this->appendedAt = nowNs();
+        });
+
+        this->view = new ChannelView();
+        this->view->setAttribute(Qt::WA_DontShowOnScreen);
+        this->view->resize(VIEW_WIDTH, VIEW_HEIGHT);
+        this->view->show();
+        this->view->setChannel(this->channel);
+
+        this->frame = QImage(this->view->size(),
+                             QImage::Format_ARGB32_Premultiplied);
+    }
+
+    Application *app;
+    ChannelPtr channel;
+    ChannelView *view;
+    QImage frame;
+
+    int64_t appendedAt = -1;
+};
+
+ReplayEnvironment &environment()
+{
+    static auto *environment = new ReplayEnvironment;
+    return *environment;
+}
+
+struct ReplayStats {
+    std::vector<int64_t> parseNs;
+    std::vector<int64_t> buildNs;
+    std::vector<int64_t> layoutNs;
+    std::vector<int64_t> paintNs;
+    // From the time a line was due until it was on screen
+    std::vector<int64_t> latencyNs;
+
+    int64_t lines = 0;
+    // Time spent working, without waiting for lines to be due
+    int64_t busyNs = 0;
+    int64_t maxLagNs = 0;
+    uint64_t allocations = 0;
+};
+
+void dispatch(Communi::IrcMessage *message, TwitchIrcServer &server)
+{
+    // Same as TwitchIrcServer does for messages of the read connection
+    auto &handler = IrcMessageHandler::instance();
+    const auto &command = message->command();
+
+    if (message->type() == Communi::IrcMessage::Type::Private)
+    {
+        handler.handlePrivMessage(
+            static_cast<Communi::IrcPrivateMessage *>(message), server);
+    }
+    else if (command == "USERNOTICE")
+    {
+        handler.handleUserNoticeMessage(message, server);
+    }
+    else if (command == "CLEARCHAT")
+    {
+        handler.handleClearChatMessage(message);
+    }
+    else if (command == "CLEARMSG")
+    {
+        handler.handleClearMessageMessage(message);
+    }
+    else if (command == "ROOMSTATE")
+    {
+        handler.handleRoomStateMessage(message);
+    }
+    else if (command == "USERSTATE")
+    {
+        handler.handleUserStateMessage(message);
+    }
+    else if (command == "NOTICE")
+    {
+        handler.handleNoticeMessage(
+            static_cast<Communi::IrcNoticeMessage *>(message));
+    }
+}
+
+// Replays the capture at speed times real time, or as fast as possible if
+// speed is 0. Must run in the GUI thread.
+void replay(const std::vector<CaptureLine> &lines, double speed,
+            ReplayEnvironment &env, ReplayStats &stats)
+{
+    auto &server = *env.app->twitch;
+
+    std::vector<int64_t> unpainted;
+    auto paint = [&] {
+        auto start = nowNs();
+        env.view->render(&env.frame);
+        auto end = nowNs();
+
+        stats.paintNs.push_back(end - start);
+        stats.busyNs += end - start;
+        for (auto due : unpainted)
+        {
+            stats.latencyNs.push_back(end - due);
+        }
+        unpainted.clear();
+        return end;
+    };
+
+    auto allocationsBefore = allocationCount.load();
+    auto begin = nowNs();
+    auto lastPaint = begin;
+
+    for (const auto &line : lines)
+    {
+        auto start = nowNs();
+        auto due = speed > 0 ? begin + int64_t(line.offsetMs * 1e6 / speed)
+                             : start;
+
+        // Keep painting frames while waiting for the line
+        while (start < due)
+        {
+            auto nextFrame = lastPaint + FRAME_INTERVAL_NS;
+            if (!unpainted.empty() && start >= nextFrame)
+            {
+                lastPaint = paint();
+            }
+            else
+            {
+                auto wakeUp =
+                    unpainted.empty() ? due : std::min(due, nextFrame);
+                std::this_thread::sleep_for(
+                    std::chrono::nanoseconds(wakeUp - start));
+            }
+            start = nowNs();
+        }
+        stats.maxLagNs = std::max(stats.maxLagNs, start - due);
+
+        std::unique_ptr<Communi::IrcMessage> message(
+            Communi::IrcMessage::fromData(line.data, nullptr));
+        auto parsed = nowNs();
+
+        env.appendedAt = -1;
+        dispatch(message.get(), server);
+        auto handled = nowNs();
+
+        stats.parseNs.push_back(parsed - start);
+        if (env.appendedAt != -1)
+        {
+            stats.buildNs.push_back(env.appendedAt - parsed);
+            stats.layoutNs.push_back(handled - env.appendedAt);
+        }
+        stats.busyNs += handled - start;
+        stats.lines++;
+        unpainted.push_back(due);
+
+        if (handled - lastPaint >= FRAME_INTERVAL_NS)
+        {
+            lastPaint = paint();
+        }
+    }
+
+    if (!unpainted.empty())
+    {
+        paint();
+    }
+
+    stats.allocations += allocationCount.load() - allocationsBefore;
+}
+
+size_t peakRssBytes()
+{
+#ifdef Q_OS_WIN
+    PROCESS_MEMORY_COUNTERS counters;
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#    ifdef Q_OS_MACOS
+    return size_t(usage.ru_maxrss);
+#    else
+    // Kilobytes on Linux
+    return size_t(usage.ru_maxrss) * 1024;
+#    endif
+#endif
+}
+
+double percentileUs(std::vector<int64_t> values, double percentile)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+
+    auto index = size_t(percentile * double(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return double(values[index]) / 1000.0;
+}
+
+void setPercentiles(benchmark::State &state, const char *stage,
+                    const std::vector<int64_t> &values)
+{
+    state.counters[std::string(stage) + "_p50_us"] =
+        percentileUs(values, 0.5);
+    state.counters[std::string(stage) + "_p99_us"] =
+        percentileUs(values, 0.99);
+}
+
+}  // namespace
+
+// Replays an IRC capture through IrcMessageHandler, TwitchMessageBuilder, the
+// channel and an offscreen ChannelView. The argument is the replay speed as a
+// multiple of real time, 0 replays as fast as possible.
+//
+// Set CHATTERINO_BENCHMARK_IRC_LOG to replay a recorded session instead of
+// the generated one.
+static void BM_PipelineReplay(benchmark::State &state)
+{
+    const auto &lines = capture();
+    auto speed = double(state.range(0));
+    ReplayStats stats;
+
+    for (auto _ : state)
+    {
+        runInGuiThread([&] {
+            replay(lines, speed, environment(), stats);
+        });
+    }
+
+    state.counters["messages_per_second"] =
+        stats.busyNs > 0 ? double(stats.lines) * 1e9 / double(stats.busyNs)
+                         : 0;
+    state.counters["max_lag_ms"] = double(stats.maxLagNs) / 1e6;
+    // Named after what was actually counted, see COUNTS_MALLOC
+    state.counters[COUNTS_MALLOC ? "allocations_per_message"
+                                 : "operator_new_per_message"] =
+        stats.lines > 0 ? double(stats.allocations) / double(stats.lines) : 0;
+    state.counters["peak_rss"] = benchmark::Counter(
+        double(peakRssBytes()), benchmark::Counter::kDefaults,
+        benchmark::Counter::OneK::kIs1024);
+
+    setPercentiles(state, "parse", stats.parseNs);
+    setPercentiles(state, "build", stats.buildNs);
+    setPercentiles(state, "layout", stats.layoutNs);
+    setPercentiles(state, "paint", stats.paintNs);
+    setPercentiles(state, "latency", stats.latencyNs);
+}
+
+BENCHMARK(BM_PipelineReplay)
+    ->Apply([](benchmark::internal::Benchmark *benchmark) {
+        benchmark->Arg(0)->Arg(10)->Arg(100);
+
+        // e.g. CHATTERINO_BENCHMARK_REPLAY_SPEED=1 to replay in real time
+        auto speed = qEnvironmentVariableIntValue(
+            "CHATTERINO_BENCHMARK_REPLAY_SPEED");
+        if (speed > 0)
+        {
+            benchmark->Arg(speed);
+        }
+    })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -4,6 +4,13 @@
 
 int main(int argc, char **argv)
 {
+    // Layout and paint benchmarks render into images, they don't need a
+    // display
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+    {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
     QApplication app(argc, argv);
 
     ::benchmark::Initialize(&argc, argv);
@@ -150,6 +150,7 @@ SOURCES += \
     src/controllers/commands/Command.cpp \
     src/controllers/commands/CommandController.cpp \
     src/controllers/commands/CommandModel.cpp \
+    src/controllers/filters/FilterCache.cpp \
     src/controllers/filters/FilterModel.cpp \
     src/controllers/filters/parser/FilterParser.cpp \
     src/controllers/filters/parser/Tokenizer.cpp \
@@ -173,19 +174,23 @@ SOURCES += \
     src/controllers/notifications/NotificationModel.cpp \
     src/controllers/pings/MutedChannelModel.cpp \
     src/debug/Benchmark.cpp \
+    src/debug/Trace.cpp \
     src/main.cpp \
     src/messages/Emote.cpp \
     src/messages/Image.cpp \
     src/messages/ImageSet.cpp \
     src/messages/layouts/MessageLayout.cpp \
+    src/messages/layouts/MessageLayoutCache.cpp \
     src/messages/layouts/MessageLayoutContainer.cpp \
     src/messages/layouts/MessageLayoutElement.cpp \
+    src/messages/layouts/TextRunCache.cpp \
     src/messages/Link.cpp \
     src/messages/Message.cpp \
     src/messages/MessageBuilder.cpp \
     src/messages/MessageColor.cpp \
     src/messages/MessageContainer.cpp \
     src/messages/MessageElement.cpp \
+    src/messages/MessageIndex.cpp \
     src/messages/search/AuthorPredicate.cpp \
     src/messages/search/ChannelPredicate.cpp \
     src/messages/search/LinkPredicate.cpp \
@@ -208,6 +213,7 @@ SOURCES += \
     src/providers/irc/IrcConnection2.cpp \
     src/providers/irc/IrcMessageBuilder.cpp \
     src/providers/irc/IrcServer.cpp \
+    src/providers/irc/JoinScheduler.cpp \
     src/providers/IvrApi.cpp \
     src/providers/LinkResolver.cpp \
     src/providers/twitch/api/Helix.cpp \
@@ -223,6 +229,7 @@ SOURCES += \
     src/providers/twitch/pubsubmessages/Listen.cpp \
     src/providers/twitch/pubsubmessages/Unlisten.cpp \
     src/providers/twitch/pubsubmessages/Whisper.cpp \
+    src/providers/twitch/RecentMessagesReader.cpp \
     src/providers/twitch/TwitchAccount.cpp \
     src/providers/twitch/TwitchAccountManager.cpp \
     src/providers/twitch/TwitchBadge.cpp \
@@ -232,7 +239,9 @@ SOURCES += \
     src/providers/twitch/TwitchHelpers.cpp \
     src/providers/twitch/TwitchIrcServer.cpp \
     src/providers/twitch/TwitchMessageBuilder.cpp \
+    src/providers/twitch/TwitchSendQueue.cpp \
     src/providers/twitch/TwitchUser.cpp \
+    src/providers/twitch/UserDecorationCache.cpp \
     src/RunGui.cpp \
     src/singletons/Badges.cpp \
     src/singletons/Emotes.cpp \
@@ -244,6 +253,7 @@ SOURCES += \
     src/singletons/Paths.cpp \
     src/singletons/Resources.cpp \
     src/singletons/Settings.cpp \
+    src/singletons/SettingsSnapshot.cpp \
     src/singletons/Theme.cpp \
     src/singletons/Toasts.cpp \
     src/singletons/TooltipPreviewImage.cpp \
@@ -251,15 +261,19 @@ SOURCES += \
     src/singletons/WindowManager.cpp \
     src/util/AttachToConsole.cpp \
     src/util/Clipboard.cpp \
+    src/util/ConsistentHash.cpp \
     src/util/DebugCount.cpp \
     src/util/DisplayBadge.cpp \
     src/util/FormatTime.cpp \
     src/util/FunctionEventFilter.cpp \
     src/util/FuzzyConvert.cpp \
     src/util/Helpers.cpp \
+    src/util/ImageUploader.cpp \
     src/util/IncognitoBrowser.cpp \
+    src/util/InternString.cpp \
     src/util/InitUpdateButton.cpp \
     src/util/LayoutHelper.cpp \
+    src/util/MonotonicArena.cpp \
     src/util/NuulsUploader.cpp \
     src/util/RapidjsonHelpers.cpp \
     src/util/RatelimitBucket.cpp \
@@ -302,6 +316,8 @@ SOURCES += \
     src/widgets/helper/DebugPopup.cpp \
     src/widgets/helper/EditableModelView.cpp \
     src/widgets/helper/EffectLabel.cpp \
+    src/widgets/helper/EmoteGrid.cpp \
+    src/widgets/helper/EmoteGridModel.cpp \
     src/widgets/helper/NotebookButton.cpp \
     src/widgets/helper/NotebookTab.cpp \
     src/widgets/helper/QColorPicker.cpp \
@@ -390,6 +406,7 @@ HEADERS += \
     src/controllers/commands/Command.hpp \
     src/controllers/commands/CommandController.hpp \
     src/controllers/commands/CommandModel.hpp \
+    src/controllers/filters/FilterCache.hpp \
     src/controllers/filters/FilterModel.hpp \
     src/controllers/filters/FilterRecord.hpp \
     src/controllers/filters/FilterSet.hpp \
@@ -421,13 +438,16 @@ HEADERS += \
     src/controllers/pings/MutedChannelModel.hpp \
     src/debug/AssertInGuiThread.hpp \
     src/debug/Benchmark.hpp \
+    src/debug/Trace.hpp \
     src/ForwardDecl.hpp \
     src/messages/Emote.hpp \
     src/messages/Image.hpp \
     src/messages/ImageSet.hpp \
     src/messages/layouts/MessageLayout.hpp \
+    src/messages/layouts/MessageLayoutCache.hpp \
     src/messages/layouts/MessageLayoutContainer.hpp \
     src/messages/layouts/MessageLayoutElement.hpp \
+    src/messages/layouts/TextRunCache.hpp \
     src/messages/LimitedQueue.hpp \
     src/messages/LimitedQueueSnapshot.hpp \
     src/messages/Link.hpp \
@@ -436,6 +456,7 @@ HEADERS += \
     src/messages/MessageColor.hpp \
     src/messages/MessageContainer.hpp \
     src/messages/MessageElement.hpp \
+    src/messages/MessageIndex.hpp \
     src/messages/MessageParseArgs.hpp \
     src/messages/search/AuthorPredicate.hpp \
     src/messages/search/ChannelPredicate.hpp \
@@ -462,6 +483,7 @@ HEADERS += \
     src/providers/irc/IrcConnection2.hpp \
     src/providers/irc/IrcMessageBuilder.hpp \
     src/providers/irc/IrcServer.hpp \
+    src/providers/irc/JoinScheduler.hpp \
     src/providers/IvrApi.hpp \
     src/providers/LinkResolver.hpp \
     src/providers/twitch/api/Helix.hpp \
@@ -484,6 +506,7 @@ HEADERS += \
     src/providers/twitch/pubsubmessages/Unlisten.hpp \
     src/providers/twitch/pubsubmessages/Whisper.hpp \
     src/providers/twitch/PubSubWebsocket.hpp \
+    src/providers/twitch/RecentMessagesReader.hpp \
     src/providers/twitch/TwitchAccount.hpp \
     src/providers/twitch/TwitchAccountManager.hpp \
     src/providers/twitch/TwitchBadge.hpp \
@@ -494,7 +517,9 @@ HEADERS += \
     src/providers/twitch/TwitchHelpers.hpp \
     src/providers/twitch/TwitchIrcServer.hpp \
     src/providers/twitch/TwitchMessageBuilder.hpp \
+    src/providers/twitch/TwitchSendQueue.hpp \
     src/providers/twitch/TwitchUser.hpp \
+    src/providers/twitch/UserDecorationCache.hpp \
     src/RunGui.hpp \
     src/singletons/Badges.hpp \
     src/singletons/Emotes.hpp \
@@ -506,6 +531,7 @@ HEADERS += \
     src/singletons/Paths.hpp \
     src/singletons/Resources.hpp \
     src/singletons/Settings.hpp \
+    src/singletons/SettingsSnapshot.hpp \
     src/singletons/Theme.hpp \
     src/singletons/Toasts.hpp \
     src/singletons/TooltipPreviewImage.hpp \
@@ -516,6 +542,7 @@ HEADERS += \
     src/util/Clipboard.hpp \
     src/util/CombinePath.hpp \
     src/util/ConcurrentMap.hpp \
+    src/util/ConsistentHash.hpp \
     src/util/DebugCount.hpp \
     src/util/DisplayBadge.hpp \
     src/util/DistanceBetweenPoints.hpp \
@@ -524,12 +551,15 @@ HEADERS += \
     src/util/FunctionEventFilter.hpp \
     src/util/FuzzyConvert.hpp \
     src/util/Helpers.hpp \
+    src/util/ImageUploader.hpp \
     src/util/IncognitoBrowser.hpp \
+    src/util/InternString.hpp \
     src/util/InitUpdateButton.hpp \
     src/util/IrcHelpers.hpp \
     src/util/IsBigEndian.hpp \
     src/util/LayoutCreator.hpp \
     src/util/LayoutHelper.hpp \
+    src/util/MonotonicArena.hpp \
     src/util/NuulsUploader.hpp \
     src/util/Overloaded.hpp \
     src/util/PersistSignalVector.hpp \
@@ -586,6 +616,8 @@ HEADERS += \
     src/widgets/helper/DebugPopup.hpp \
     src/widgets/helper/EditableModelView.hpp \
     src/widgets/helper/EffectLabel.hpp \
+    src/widgets/helper/EmoteGrid.hpp \
+    src/widgets/helper/EmoteGridModel.hpp \
     src/widgets/helper/Line.hpp \
     src/widgets/helper/NotebookButton.hpp \
     src/widgets/helper/NotebookTab.hpp \
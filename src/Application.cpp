@@ -20,6 +20,7 @@
 #include "providers/twitch/PubSubManager.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "providers/twitch/TwitchMessageBuilder.hpp"
+#include "providers/twitch/UserDecorationCache.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/Fonts.hpp"
 #include "singletons/Logging.hpp"
@@ -173,6 +174,9 @@ int Application::run(QApplication &qtApp)
     getSettings()->highlightedUsers.delayedItemsChanged.connect([this] {
         this->windows->forceLayoutChannelViews();
     });
+    getSettings()->nicknames.delayedItemsChanged.connect([] {
+        UserDecorationCache::invalidate();
+    });
 
     getSettings()->removeSpacesBetweenEmotes.connect([this] {
         this->windows->forceLayoutChannelViews();
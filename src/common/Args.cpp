@@ -39,12 +39,18 @@ Args::Args(const QApplication &app)
                                       "allowing you to see debug output."});
     crashRecoveryOption.setFlags(QCommandLineOption::HiddenFromHelp);
 
+    // Tracing
+    QCommandLineOption traceOption(
+        "trace", "Records a trace of message handling, layout and painting. "
+                 "Use /debug-trace dump to write it to a file.");
+
     parser.addOptions({
         {{"V", "version"}, "Displays version information."},
         crashRecoveryOption,
         parentWindowOption,
         parentWindowIdOption,
         verboseOption,
+        traceOption,
     });
     parser.addOption(QCommandLineOption(
         {"c", "channels"},
@@ -77,6 +83,7 @@ Args::Args(const QApplication &app)
     }
 
     this->verbose = parser.isSet(verboseOption);
+    this->trace = parser.isSet(traceOption);
 
     this->printVersion = parser.isSet("V");
     this->crashRecovery = parser.isSet("crash-recovery");
@@ -24,6 +24,8 @@ public:
     bool dontLoadMainWindow{};
     boost::optional<WindowLayout> customChannelLayout;
     bool verbose{};
+    // Records spans of the message pipeline from startup, see debug/Trace.hpp
+    bool trace{};
 
 private:
     void applyCustomChannelLayout(const QString &argValue);
@@ -1,6 +1,7 @@
 #include "common/Channel.hpp"
 
 #include "Application.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
@@ -78,6 +79,8 @@ LimitedQueueSnapshot<MessagePtr> Channel::getMessageSnapshot()
 void Channel::addMessage(MessagePtr message,
                          boost::optional<MessageFlags> overridingFlags)
 {
+    TraceScope trace("Channel::addMessage");
+
     auto app = getApp();
     MessagePtr deleted;
 
@@ -88,8 +91,12 @@ void Channel::addMessage(MessagePtr message,
         app->logging->addMessage(this->name_, message);
     }
 
-    if (this->messages_.pushBack(message, deleted))
+    bool removed = this->messages_.pushBack(message, deleted);
+    this->messageIndex_.pushBack(message);
+
+    if (removed)
     {
+        this->messageIndex_.popFront(deleted);
         this->messageRemovedFromStart.invoke(deleted);
     }
 
@@ -169,7 +176,8 @@ void Channel::addOrReplaceTimeout(MessagePtr message)
     }
 
     // disable the messages from the user
-    for (int i = 0; i < snapshotLength; i++)
+    snapshot = this->getMessageSnapshot();
+    for (auto i : this->messageIndex_.findByUser(message->timeoutUser))
     {
         auto &s = snapshot[i];
         if (s->loginName == message->timeoutUser &&
@@ -213,6 +221,7 @@ void Channel::addMessagesAtStart(std::vector<MessagePtr> &_messages)
 {
     std::vector<MessagePtr> addedMessages =
         this->messages_.pushFront(_messages);
+    this->messageIndex_.pushFront(addedMessages);
 
     if (addedMessages.size() != 0)
     {
@@ -222,18 +231,31 @@ void Channel::addMessagesAtStart(std::vector<MessagePtr> &_messages)
 
 void Channel::replaceMessage(MessagePtr message, MessagePtr replacement)
 {
-    int index = this->messages_.replaceItem(message, replacement);
+    auto index = this->messageIndex_.positionOf(message.get());
+    if (!index)
+    {
+        return;
+    }
 
-    if (index >= 0)
+    if (this->messages_.replaceItem(*index, replacement))
     {
-        this->messageReplaced.invoke((size_t)index, replacement);
+        this->messageIndex_.replace(message, replacement);
+        this->messageReplaced.invoke(*index, replacement);
     }
 }
 
 void Channel::replaceMessage(size_t index, MessagePtr replacement)
 {
+    auto snapshot = this->getMessageSnapshot();
+    if (index >= snapshot.size())
+    {
+        return;
+    }
+    auto message = snapshot[index];
+
     if (this->messages_.replaceItem(index, replacement))
     {
+        this->messageIndex_.replace(message, replacement);
         this->messageReplaced.invoke(index, replacement);
     }
 }
@@ -248,21 +270,26 @@ void Channel::deleteMessage(QString messageID)
 }
 MessagePtr Channel::findMessage(QString messageID)
 {
-    LimitedQueueSnapshot<MessagePtr> snapshot = this->getMessageSnapshot();
-    int snapshotLength = snapshot.size();
+    auto index = this->messageIndex_.findById(messageID);
+    if (!index)
+    {
+        return nullptr;
+    }
 
-    int end = std::max(0, snapshotLength - 200);
+    return this->getMessageSnapshot()[*index];
+}
 
-    for (int i = snapshotLength - 1; i >= end; --i)
-    {
-        auto &s = snapshot[i];
+std::vector<MessagePtr> Channel::findMessagesByUser(const QString &userName)
+{
+    auto snapshot = this->getMessageSnapshot();
+    std::vector<MessagePtr> messages;
 
-        if (s->id == messageID)
-        {
-            return s;
-        }
+    for (auto i : this->messageIndex_.findByUser(userName))
+    {
+        messages.push_back(snapshot[i]);
     }
-    return nullptr;
+
+    return messages;
 }
 
 bool Channel::canSendMessage() const
@@ -3,6 +3,7 @@
 #include "common/CompletionModel.hpp"
 #include "common/FlagsEnum.hpp"
 #include "messages/LimitedQueue.hpp"
+#include "messages/MessageIndex.hpp"
 
 #include <QDate>
 #include <QString>
@@ -79,6 +80,9 @@ public:
     void replaceMessage(size_t index, MessagePtr replacement);
     void deleteMessage(QString messageID);
     MessagePtr findMessage(QString messageID);
+    // Messages sent by the user, moderation messages targeting them and
+    // their subscription announcements, oldest first
+    std::vector<MessagePtr> findMessagesByUser(const QString &userName);
 
     bool hasMessages() const;
 
@@ -105,6 +109,8 @@ protected:
 private:
     const QString name_;
     LimitedQueue<MessagePtr> messages_;
+    // Positions in messages_ by message id and user, updated with it
+    MessageIndex messageIndex_;
     Type type_;
     QTimer clearCompletionModelTimer_;
 };
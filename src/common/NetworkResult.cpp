@@ -53,6 +53,19 @@ rapidjson::Document NetworkResult::parseRapidJson() const
     return ret;
 }
 
+bool NetworkResult::checkParseResult(const rapidjson::ParseResult &result)
+{
+    if (result.IsError())
+    {
+        qCWarning(chatterinoCommon)
+            << "JSON parse error:" << rapidjson::GetParseError_En(result.Code())
+            << "(" << result.Offset() << ")";
+        return false;
+    }
+
+    return true;
+}
+
 const QByteArray &NetworkResult::getData() const
 {
     return this->data_;
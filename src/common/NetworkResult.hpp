@@ -1,6 +1,7 @@
 #pragma once
 
 #include <rapidjson/document.h>
+#include <rapidjson/reader.h>
 #include <QJsonArray>
 #include <QJsonObject>
 
@@ -19,12 +20,25 @@ public:
     QJsonArray parseJsonArray() const;
     /// Parses the result as json and returns the document.
     rapidjson::Document parseRapidJson() const;
+    /// Parses the result as json and feeds it into the given rapidjson SAX
+    /// handler, without building a document.
+    /// Returns false if parsing failed or was aborted by the handler.
+    template <typename Handler>
+    bool parseRapidJsonSax(Handler &handler) const
+    {
+        rapidjson::Reader reader;
+        rapidjson::StringStream stream(this->data_.constData());
+
+        return checkParseResult(reader.Parse(stream, handler));
+    }
     const QByteArray &getData() const;
     int status() const;
 
     static constexpr int timedoutStatus = -2;
 
 private:
+    static bool checkParseResult(const rapidjson::ParseResult &result);
+
     QByteArray data_;
     int status_;
 };
@@ -4,12 +4,27 @@
 #include <QTimer>
 #include <boost/noncopyable.hpp>
 #include <pajlada/signals/signal.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include "debug/AssertInGuiThread.hpp"
 
 namespace chatterino {
 
+namespace detail {
+
+    inline uint64_t nextSignalVectorId()
+    {
+        static std::atomic<uint64_t> id{0};
+        return ++id;
+    }
+
+}  // namespace detail
+
 template <typename T>
 struct SignalVectorItemEvent {
     const T &item;
@@ -27,6 +42,7 @@ public:
 
     SignalVector()
         : readOnly_(new std::vector<T>())
+        , id_(detail::nextSignalVectorId())
     {
         QObject::connect(&this->itemsChangedTimer_, &QTimer::timeout, [this] {
             this->delayedItemsChanged.invoke();
@@ -49,9 +65,31 @@ public:
     /// A read-only version of the vector which can be used concurrently.
     std::shared_ptr<const std::vector<T>> readOnly()
     {
+        std::lock_guard<std::mutex> lock(this->readOnlyMutex_);
         return this->readOnly_;
     }
 
+    /// A read-only version of the vector which can be used concurrently.
+    ///
+    /// Unlike readOnly(), this doesn't copy the shared pointer unless the
+    /// vector changed since the calling thread last read it, each thread
+    /// keeps its own copy. The reference stays valid until the calling
+    /// thread calls snapshot() on this vector again after it changed, so it
+    /// must not be kept beyond the message being processed.
+    const std::vector<T> &snapshot() const
+    {
+        auto &cached = cachedSnapshot(this->id_);
+
+        if (cached.version != this->version_.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(this->readOnlyMutex_);
+            cached.items = this->readOnly_;
+            cached.version = this->version_.load(std::memory_order_relaxed);
+        }
+
+        return *cached.items;
+    }
+
     /// This may only be called from the GUI thread.
     ///
     ///	@param item
@@ -124,11 +162,6 @@ public:
         return this->items_;
     }
 
-    [[deprecated]] std::vector<T> cloneVector()
-    {
-        return *this->readOnly();
-    }
-
     // mirror vector functions
     auto begin() const
     {
@@ -164,11 +197,45 @@ private:
         }
 
         // update concurrent version
-        this->readOnly_ = std::make_shared<const std::vector<T>>(this->items_);
+        auto readOnly = std::make_shared<const std::vector<T>>(this->items_);
+        {
+            std::lock_guard<std::mutex> lock(this->readOnlyMutex_);
+            this->readOnly_.swap(readOnly);
+            this->version_.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    struct CachedSnapshot {
+        uint64_t vectorId;
+        uint64_t version;
+        std::shared_ptr<const std::vector<T>> items;
+    };
+
+    // Snapshots of all vectors of this type that the calling thread read.
+    // Entries of destroyed vectors are kept until the thread exits, which is
+    // fine since most vectors live as long as the application.
+    static CachedSnapshot &cachedSnapshot(uint64_t vectorId)
+    {
+        thread_local std::vector<CachedSnapshot> cache;
+
+        for (auto &entry : cache)
+        {
+            if (entry.vectorId == vectorId)
+            {
+                return entry;
+            }
+        }
+
+        cache.push_back({vectorId, 0, nullptr});
+        return cache.back();
     }
 
     std::vector<T> items_;
     std::shared_ptr<const std::vector<T>> readOnly_;
+    mutable std::mutex readOnlyMutex_;
+    // Starts at 1 so that new CachedSnapshot entries are outdated
+    std::atomic<uint64_t> version_{1};
+    const uint64_t id_;
     QTimer itemsChangedTimer_;
     std::function<bool(const T &, const T &)> itemCompare_;
 };
@@ -6,6 +6,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/commands/Command.hpp"
 #include "controllers/commands/CommandModel.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "messages/MessageElement.hpp"
@@ -29,6 +30,7 @@
 #include "widgets/splits/Split.hpp"
 
 #include <QApplication>
+#include <QDateTime>
 #include <QDesktopServices>
 #include <QFile>
 #include <QRegularExpression>
@@ -464,6 +466,80 @@ void CommandController::initialize(Settings &, Paths &paths)
         return "";
     });
 
+    this->registerCommand("/debug-trace", [](const QStringList &words,
+                                             ChannelPtr channel) {
+        auto action = words.value(1).toLower();
+
+        if (action == "on" || action == "start")
+        {
+            Trace::clear();
+            Trace::setEnabled(true);
+            channel->addMessage(makeSystemMessage("Tracing enabled."));
+        }
+        else if (action == "off" || action == "stop")
+        {
+            Trace::setEnabled(false);
+            channel->addMessage(makeSystemMessage("Tracing disabled."));
+        }
+        else if (action == "dump")
+        {
+            QString path = words.mid(2).join(' ');
+            if (path.isEmpty())
+            {
+                auto timestamp =
+                    QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss");
+                path = combinePath(getPaths()->miscDirectory,
+                                   "trace-" + timestamp + ".json");
+            }
+
+            if (Trace::dump(path))
+            {
+                channel->addMessage(
+                    makeSystemMessage("Trace written to " + path));
+            }
+            else
+            {
+                channel->addMessage(
+                    makeSystemMessage("Unable to write trace to " + path));
+            }
+        }
+        else
+        {
+            channel->addMessage(makeSystemMessage(
+                QString("Usage: /debug-trace <on|off|dump> [file] - "
+                        "Records spans of message handling, layout and "
+                        "painting and writes them as a Chrome trace file. "
+                        "Tracing is currently %1.")
+                    .arg(Trace::isEnabled() ? "on" : "off")));
+        }
+
+        return "";
+    });
+
+    this->registerCommand("/debug-connections", [](const auto & /*words*/,
+                                                   ChannelPtr channel) {
+        auto stats = getApp()->twitch->getReadConnectionStats();
+
+        for (size_t i = 0; i < stats.size(); i++)
+        {
+            const auto &stat = stats[i];
+            auto lag = stat.lagMs < 0 ? QString("unknown")
+                                      : QString("%1 ms").arg(stat.lagMs);
+
+            channel->addMessage(makeSystemMessage(
+                QString("Read connection %1: %2, %3 channels, %4 messages, "
+                        "%5 reconnects, lag %6")
+                    .arg(i + 1)
+                    .arg(stat.connected ? "connected" : "disconnected")
+                    .arg(stat.channelCount)
+                    .arg(stat.messagesReceived)
+                    .arg(stat.reconnects)
+                    .arg(lag)));
+        }
+
+        return "";
+    });
+
     this->registerCommand("/uptime", [](const auto & /*words*/, auto channel) {
         auto *twitchChannel = dynamic_cast<TwitchChannel *>(channel.get());
         if (twitchChannel == nullptr)
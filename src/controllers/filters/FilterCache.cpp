@@ -0,0 +1,127 @@
+#include "controllers/filters/FilterCache.hpp"
+
+namespace chatterino {
+
+namespace {
+
+    bool isSameMessage(const std::weak_ptr<const Message> &cached,
+                       const MessagePtr &message)
+    {
+        // Compares the control blocks, which stay alive as long as the cache
+        // references them, so a different message can't have the same one
+        return !cached.owner_before(message) && !message.owner_before(cached);
+    }
+
+}  // namespace
+
+FilterCache::FilterCache(size_t capacity)
+    : capacity_(capacity)
+{
+}
+
+FilterCache &FilterCache::instance()
+{
+    static FilterCache instance;
+    return instance;
+}
+
+size_t FilterCache::KeyHash::operator()(const Key &key) const
+{
+    auto hash = std::hash<const Message *>()(key.message);
+    hash ^= std::hash<uint64_t>()(key.filterVersion) + 0x9e3779b9 +
+            (hash << 6) + (hash >> 2);
+    return hash ^
+           (size_t(key.context.live) << 1 | size_t(key.context.watching));
+}
+
+boost::optional<bool> FilterCache::get(const MessagePtr &message,
+                                       const FilterRecord &filter,
+                                       const Context &context) const
+{
+    std::lock_guard<std::mutex> guard(this->mutex_);
+
+    auto it =
+        this->entries_.find({message.get(), filter.getVersion(), context});
+    if (it == this->entries_.end() ||
+        !isSameMessage(it->second.message, message))
+    {
+        return boost::none;
+    }
+
+    return it->second.result;
+}
+
+void FilterCache::insert(const MessagePtr &message, const FilterRecord &filter,
+                         const Context &context, bool result)
+{
+    std::lock_guard<std::mutex> guard(this->mutex_);
+
+    Key key{message.get(), filter.getVersion(), context};
+    bool inserted =
+        this->entries_.insert_or_assign(key, Entry{message, result}).second;
+    if (!inserted)
+    {
+        // Replaced the result of a deleted message at the same address (or
+        // another thread was faster), the key is already in order_
+        return;
+    }
+
+    this->order_.push_back(key);
+
+    while (this->order_.size() > this->capacity_)
+    {
+        this->entries_.erase(this->order_.front());
+        this->order_.pop_front();
+    }
+}
+
+size_t FilterCache::size() const
+{
+    std::lock_guard<std::mutex> guard(this->mutex_);
+
+    return this->entries_.size();
+}
+
+void FilterCache::clear()
+{
+    std::lock_guard<std::mutex> guard(this->mutex_);
+
+    this->entries_.clear();
+    this->order_.clear();
+}
+
+bool filterMessage(
+    FilterCache &cache, const QList<FilterRecordPtr> &filters,
+    const MessagePtr &message, const FilterCache::Context &context,
+    const std::function<filterparser::ContextMap()> &buildContext)
+{
+    boost::optional<filterparser::ContextMap> contextMap;
+
+    for (const auto &filter : filters)
+    {
+        if (!filter->valid())
+        {
+            return false;
+        }
+
+        auto result = cache.get(message, *filter, context);
+        if (!result)
+        {
+            if (!contextMap)
+            {
+                contextMap = buildContext();
+            }
+            result = filter->filter(*contextMap);
+            cache.insert(message, *filter, context, *result);
+        }
+
+        if (!*result)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "controllers/filters/FilterRecord.hpp"
+
+#include <boost/optional.hpp>
+#include <QList>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+
+namespace chatterino {
+
+/**
+ * @brief Remembers the result of running a filter on a message
+ *
+ * Splits that show the same channel with the same filters get the same
+ * messages, so all views share one cache and a filter only runs once per
+ * message. Results are keyed by the message, the filter's version, which
+ * is unique to every FilterRecord, and the parts of the filter's context
+ * that don't come from the message (see Context). Editing a filter replaces
+ * its record, so results of the old filter are never used again and simply
+ * age out.
+ *
+ * The cache holds no strong references to messages. The oldest results are
+ * dropped once it's full.
+ *
+ * Thread-safe.
+ **/
+class FilterCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 20'000;
+
+    // The variables a filter sees that depend on the view showing the
+    // message and on time, not only on the message itself
+    struct Context {
+        // channel.live
+        bool live = false;
+        // channel.watching
+        bool watching = false;
+
+        bool operator==(const Context &other) const
+        {
+            return this->live == other.live &&
+                   this->watching == other.watching;
+        }
+    };
+
+    explicit FilterCache(size_t capacity = DEFAULT_CAPACITY);
+
+    // Cache shared by all channel views
+    static FilterCache &instance();
+
+    boost::optional<bool> get(const MessagePtr &message,
+                              const FilterRecord &filter,
+                              const Context &context) const;
+    void insert(const MessagePtr &message, const FilterRecord &filter,
+                const Context &context, bool result);
+
+    size_t size() const;
+    void clear();
+
+private:
+    struct Key {
+        const Message *message;
+        uint64_t filterVersion;
+        Context context;
+
+        bool operator==(const Key &other) const
+        {
+            return this->message == other.message &&
+                   this->filterVersion == other.filterVersion &&
+                   this->context == other.context;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Entry {
+        // Tells apart a new message that happens to be at the address of a
+        // deleted one
+        std::weak_ptr<const Message> message;
+        bool result;
+    };
+
+    const size_t capacity_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, Entry, KeyHash> entries_;
+    // Insertion order, used to drop the oldest results
+    std::deque<Key> order_;
+};
+
+/**
+ * @brief Runs all filters on a message, using and filling the cache
+ *
+ * buildContext is only called if a filter actually has to run, it must
+ * build a map that agrees with context. Returns whether the message passes
+ * all filters.
+ **/
+bool filterMessage(
+    FilterCache &cache, const QList<FilterRecordPtr> &filters,
+    const MessagePtr &message, const FilterCache::Context &context,
+    const std::function<filterparser::ContextMap()> &buildContext);
+
+}  // namespace chatterino
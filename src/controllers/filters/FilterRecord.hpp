@@ -11,6 +11,7 @@
 #include <QUuid>
 #include <pajlada/serialize.hpp>
 
+#include <atomic>
 #include <memory>
 
 namespace chatterino {
@@ -55,6 +56,13 @@ public:
         return this->id_;
     }
 
+    // Unique for every record. Editing a filter replaces its record, so this
+    // changes whenever the filter does.
+    uint64_t getVersion() const
+    {
+        return this->version_;
+    }
+
     bool valid() const
     {
         return this->parser_->valid();
@@ -71,6 +79,13 @@ private:
     QUuid id_;
 
     std::unique_ptr<filterparser::FilterParser> parser_;
+    uint64_t version_ = nextVersion();
+
+    static uint64_t nextVersion()
+    {
+        static std::atomic<uint64_t> version{0};
+        return ++version;
+    }
 };
 
 using FilterRecordPtr = std::shared_ptr<FilterRecord>;
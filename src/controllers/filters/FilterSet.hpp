@@ -1,5 +1,6 @@
 #pragma once
 
+#include "controllers/filters/FilterCache.hpp"
 #include "controllers/filters/FilterRecord.hpp"
 #include "singletons/Settings.hpp"
 
@@ -41,15 +42,16 @@ public:
         if (this->filters_.size() == 0)
             return true;
 
-        filterparser::ContextMap context =
-            filterparser::buildContextMap(m, channel.get());
-        for (const auto &f : this->filters_.values())
-        {
-            if (!f->valid() || !f->filter(context))
-                return false;
-        }
+        FilterCache::Context context{
+            filterparser::isChannelLive(channel.get()),
+            filterparser::isWatchingChannel(m),
+        };
 
-        return true;
+        return filterMessage(FilterCache::instance(), this->filters_.values(),
+                             m, context, [&] {
+                                 return filterparser::buildContextMap(
+                                     m, context.live, context.watching);
+                             });
     }
 
     const QList<QUuid> filterIds() const
@@ -57,6 +59,13 @@ public:
         return this->filters_.keys();
     }
 
+    // The records are immutable, so the returned list can be used on other
+    // threads while this set gets reloaded
+    QList<FilterRecordPtr> filters() const
+    {
+        return this->filters_.values();
+    }
+
 private:
     QMap<QUuid, FilterRecordPtr> filters_;
     pajlada::Signals::Connection listener_;
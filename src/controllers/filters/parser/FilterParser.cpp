@@ -8,9 +8,34 @@
 namespace filterparser {
 
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
+{
+    return buildContextMap(m, isChannelLive(channel), isWatchingChannel(m));
+}
+
+bool isChannelLive(chatterino::Channel *channel)
+{
+    using namespace chatterino;
+
+    auto *tc = dynamic_cast<TwitchChannel *>(channel);
+    return channel && !channel->isEmpty() && tc && tc->isLive();
+}
+
+bool isWatchingChannel(const MessagePtr &m)
 {
     auto watchingChannel = chatterino::getApp()->twitch->watchingChannel.get();
 
+    return isWatchingChannel(m, watchingChannel->getName());
+}
+
+bool isWatchingChannel(const MessagePtr &m, const QString &watchingChannelName)
+{
+    return !watchingChannelName.isEmpty() &&
+           watchingChannelName.compare(m->channelName, Qt::CaseInsensitive) ==
+               0;
+}
+
+ContextMap buildContextMap(const MessagePtr &m, bool live, bool watching)
+{
     /* Known Identifiers
      *
      * author.badges
@@ -20,6 +45,7 @@ ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
      * author.subbed
      * author.sub_length
      *
+     * channel.live
      * channel.name
      * channel.watching
      *
@@ -45,10 +71,6 @@ ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
         badges << e.key_;
     }
 
-    bool watching = !watchingChannel->getName().isEmpty() &&
-                    watchingChannel->getName().compare(
-                        m->channelName, Qt::CaseInsensitive) == 0;
-
     bool subscribed = false;
     int subLength = 0;
     for (const QString &subBadge : {"subscriber", "founder"})
@@ -71,6 +93,7 @@ ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
         {"author.subbed", subscribed},
         {"author.sub_length", subLength},
 
+        {"channel.live", live},
         {"channel.name", m->channelName},
         {"channel.watching", watching},
 
@@ -86,18 +109,6 @@ ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel)
         {"message.content", m->messageText},
         {"message.length", m->messageText.length()},
     };
-    {
-        using namespace chatterino;
-        auto *tc = dynamic_cast<TwitchChannel *>(channel);
-        if (channel && !channel->isEmpty() && tc)
-        {
-            vars["channel.live"] = tc->isLive();
-        }
-        else
-        {
-            vars["channel.live"] = false;
-        }
-    }
     return vars;
 }
 
@@ -12,6 +12,15 @@ class Channel;
 namespace filterparser {
 
 ContextMap buildContextMap(const MessagePtr &m, chatterino::Channel *channel);
+// Doesn't look at the channel or the watching channel, so it can be used on
+// other threads
+ContextMap buildContextMap(const MessagePtr &m, bool live, bool watching);
+
+// channel.live
+bool isChannelLive(chatterino::Channel *channel);
+// channel.watching
+bool isWatchingChannel(const MessagePtr &m);
+bool isWatchingChannel(const MessagePtr &m, const QString &watchingChannelName);
 
 class FilterParser
 {
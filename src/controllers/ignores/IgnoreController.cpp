@@ -11,8 +11,7 @@ bool isIgnoredMessage(IgnoredMessageParameters &&params)
     if (!params.message.isEmpty())
     {
         // TODO(pajlada): Do we need to check if the phrase is valid first?
-        auto phrases = getCSettings().ignoredMessages.readOnly();
-        for (const auto &phrase : *phrases)
+        for (const auto &phrase : getCSettings().ignoredMessages.snapshot())
         {
             if (phrase.isBlock() && phrase.isMatch(params.message))
             {
@@ -0,0 +1,238 @@
+#include "debug/Trace.hpp"
+
+#include "common/QLogging.hpp"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QThread>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace chatterino {
+
+namespace {
+
+    struct TraceEvent {
+        const char *name;
+        int64_t timestampUs;
+        // duration for spans, value for counters
+        int64_t value;
+        char phase;
+    };
+
+    struct ThreadBuffer {
+        explicit ThreadBuffer(int _threadId, QString _threadName)
+            : threadId(_threadId)
+            , threadName(std::move(_threadName))
+        {
+            this->events.resize(Trace::RING_SIZE);
+        }
+
+        void push(const TraceEvent &event)
+        {
+            // Only contended while dumping
+            std::lock_guard<std::mutex> lock(this->mutex);
+
+            this->events[this->next] = event;
+            this->next = (this->next + 1) % this->events.size();
+            if (this->next == 0)
+            {
+                this->wrapped = true;
+            }
+        }
+
+        const int threadId;
+        const QString threadName;
+
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        size_t next = 0;
+        bool wrapped = false;
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        // Buffers stay alive after their thread exits so they can be dumped
+        std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    };
+
+    Registry &registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+
+    ThreadBuffer &localBuffer()
+    {
+        thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+            auto &reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+
+            auto *thread = QThread::currentThread();
+            QString name = thread->objectName();
+            if (QCoreApplication::instance() != nullptr &&
+                thread == QCoreApplication::instance()->thread())
+            {
+                name = "GUI";
+            }
+            else if (name.isEmpty())
+            {
+                name = QString("Thread %1").arg(reg.buffers.size());
+            }
+
+            auto newBuffer = std::make_shared<ThreadBuffer>(
+                int(reg.buffers.size()) + 1, name);
+            reg.buffers.push_back(newBuffer);
+            return newBuffer;
+        }();
+
+        return *buffer;
+    }
+
+    void appendEscaped(QByteArray &out, const QByteArray &text)
+    {
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+            }
+            out += c;
+        }
+    }
+
+}  // namespace
+
+std::atomic<bool> Trace::enabled_{false};
+
+void Trace::setEnabled(bool enabled)
+{
+    // make sure the time origin is set before the first event
+    Trace::nowUs();
+
+    enabled_.store(enabled, std::memory_order_relaxed);
+
+    qCDebug(chatterinoBenchmark)
+        << "Tracing" << (enabled ? "enabled" : "disabled");
+}
+
+void Trace::counter(const char *name, int64_t value)
+{
+    if (!Trace::isEnabled())
+    {
+        return;
+    }
+
+    localBuffer().push({name, Trace::nowUs(), value, 'C'});
+}
+
+void Trace::span(const char *name, int64_t startUs, int64_t durationUs)
+{
+    localBuffer().push({name, startUs, durationUs, 'X'});
+}
+
+int64_t Trace::nowUs()
+{
+    static const auto origin = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now() - origin)
+        .count();
+}
+
+void Trace::clear()
+{
+    auto &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    for (auto &buffer : reg.buffers)
+    {
+        std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+        buffer->next = 0;
+        buffer->wrapped = false;
+    }
+}
+
+bool Trace::dump(const QString &path)
+{
+    QByteArray out;
+    out.reserve(1024 * 1024);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    auto separator = [&] {
+        if (!first)
+        {
+            out += ",\n";
+        }
+        first = false;
+    };
+
+    {
+        auto &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        for (auto &buffer : reg.buffers)
+        {
+            std::lock_guard<std::mutex> bufferLock(buffer->mutex);
+            auto tid = QByteArray::number(buffer->threadId);
+
+            separator();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+            out += tid;
+            out += ",\"args\":{\"name\":\"";
+            appendEscaped(out, buffer->threadName.toUtf8());
+            out += "\"}}";
+
+            size_t count =
+                buffer->wrapped ? buffer->events.size() : buffer->next;
+            size_t start = buffer->wrapped ? buffer->next : 0;
+
+            for (size_t i = 0; i < count; i++)
+            {
+                const auto &event =
+                    buffer->events[(start + i) % buffer->events.size()];
+
+                separator();
+                out += "{\"name\":\"";
+                appendEscaped(out, event.name);
+                out += "\",\"cat\":\"chatterino\",\"ph\":\"";
+                out += event.phase;
+                out += "\",\"pid\":1,\"tid\":";
+                out += tid;
+                out += ",\"ts\":";
+                out += QByteArray::number(qlonglong(event.timestampUs));
+
+                if (event.phase == 'X')
+                {
+                    out += ",\"dur\":";
+                    out += QByteArray::number(qlonglong(event.value));
+                    out += '}';
+                }
+                else
+                {
+                    out += ",\"args\":{\"value\":";
+                    out += QByteArray::number(qlonglong(event.value));
+                    out += "}}";
+                }
+            }
+        }
+    }
+
+    out += "]}\n";
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qCWarning(chatterinoBenchmark)
+            << "Unable to open" << path << "for writing the trace";
+        return false;
+    }
+
+    return file.write(out) == out.size();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QString>
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstdint>
+
+namespace chatterino {
+
+/**
+ * @brief Low-overhead tracing of the message pipeline
+ *
+ * Spans and counters are recorded into a fixed-size ring buffer per thread,
+ * so recording never allocates after the first event on a thread and never
+ * contends with other threads. Recording is off by default and can be toggled
+ * at runtime (--trace argument, /debug-trace command).
+ *
+ * The recorded events can be written to a Chrome trace-format JSON file,
+ * which can be opened in chrome://tracing or https://ui.perfetto.dev
+ **/
+class Trace
+{
+public:
+    // Amount of events kept per thread before the oldest ones get overwritten
+    static constexpr size_t RING_SIZE = 1 << 16;
+
+    static bool isEnabled()
+    {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief Records a sample of a counter (e.g. a queue length)
+     *
+     * @param name must point to a string that outlives the recording, e.g. a string literal
+     **/
+    static void counter(const char *name, int64_t value);
+
+    /**
+     * @brief Records a finished span. Prefer using TraceScope
+     *
+     * @param name must point to a string that outlives the recording, e.g. a string literal
+     **/
+    static void span(const char *name, int64_t startUs, int64_t durationUs);
+
+    // Microseconds since the first call to this function
+    static int64_t nowUs();
+
+    // Drops all recorded events
+    static void clear();
+
+    /**
+     * @brief Writes all recorded events of all threads in the Chrome trace format
+     *
+     * @returns false if the file could not be written
+     **/
+    static bool dump(const QString &path);
+
+private:
+    static std::atomic<bool> enabled_;
+};
+
+// Records a span for the lifetime of the object if tracing is enabled
+class TraceScope : boost::noncopyable
+{
+public:
+    explicit TraceScope(const char *name)
+        : name_(name)
+        , startUs_(Trace::isEnabled() ? Trace::nowUs() : -1)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (this->startUs_ >= 0)
+        {
+            Trace::span(this->name_, this->startUs_,
+                        Trace::nowUs() - this->startUs_);
+        }
+    }
+
+private:
+    const char *name_;
+    int64_t startUs_;
+};
+
+}  // namespace chatterino
@@ -10,6 +10,7 @@
 #include "common/Modes.hpp"
 #include "common/QLogging.hpp"
 #include "common/Version.hpp"
+#include "debug/Trace.hpp"
 #include "providers/IvrApi.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "singletons/Paths.hpp"
@@ -80,6 +81,11 @@ int main(int argc, char **argv)
             attachToConsole();
         }
 
+        if (getArgs().trace)
+        {
+            Trace::setEnabled(true);
+        }
+
         IvrApi::initialize();
         Helix::initialize();
 
@@ -119,6 +119,11 @@ namespace detail {
         return this->items_.size() > 1;
     }
 
+    int Frames::index() const
+    {
+        return this->index_;
+    }
+
     boost::optional<QPixmap> Frames::current() const
     {
         if (this->items_.size() == 0)
@@ -199,7 +204,9 @@ namespace detail {
         }
 
 #ifndef CHATTERINO_TEST
-        getApp()->windows->forceLayoutChannelViews();
+        // Only layouts that used one of these images while it was loading get
+        // laid out again, see MessageLayoutContainer::hasLoadedPendingImages
+        getApp()->windows->layoutChannelViews();
 #endif
         loadedEventQueued = false;
     }
@@ -376,6 +383,13 @@ bool Image::animated() const
     return this->frames_->animated();
 }
 
+int Image::frameIndex() const
+{
+    assertInGuiThread();
+
+    return this->frames_->index();
+}
+
 int Image::width() const
 {
     assertInGuiThread();
@@ -30,6 +30,7 @@ namespace detail {
         ~Frames();
 
         bool animated() const;
+        int index() const;
         void advance();
         boost::optional<QPixmap> current() const;
         boost::optional<QPixmap> first() const;
@@ -69,6 +70,8 @@ public:
     int width() const;
     int height() const;
     bool animated() const;
+    // Index of the current frame, changes when an animated image advances
+    int frameIndex() const;
 
     bool operator==(const Image &image) const;
     bool operator!=(const Image &image) const;
@@ -179,35 +179,25 @@ public:
     {
         std::lock_guard<std::mutex> lock(this->mutex_);
 
-        size_t x = 0;
+        // skip whole chunks, only the first one can have a different size
+        index += this->firstChunkOffset_;
 
         for (size_t i = 0; i < this->chunks_->size(); i++)
         {
             auto &chunk = this->chunks_->at(i);
 
-            size_t start = i == 0 ? this->firstChunkOffset_ : 0;
-            size_t end =
-                i == chunk->size() - 1 ? this->lastChunkEnd_ : chunk->size();
+            size_t end = i == this->chunks_->size() - 1 ? this->lastChunkEnd_
+                                                        : chunk->size();
 
-            for (size_t j = start; j < end; j++)
+            if (index < end)
             {
-                if (x == index)
-                {
-                    auto newChunk = std::make_shared<Chunk>();
-                    newChunk->resize(chunk->size());
-
-                    for (size_t k = 0; k < chunk->size(); k++)
-                    {
-                        newChunk->at(k) = chunk->at(k);
-                    }
-
-                    newChunk->at(j) = replacement;
-                    this->chunks_->at(i) = newChunk;
+                auto newChunk = std::make_shared<Chunk>(*chunk);
+                newChunk->at(index) = replacement;
+                chunk = newChunk;
 
-                    return true;
-                }
-                x++;
+                return true;
             }
+            index -= chunk->size();
         }
         return false;
     }
@@ -228,6 +218,11 @@ public:
         return this->limit_ - this->space() == 0;
     }
 
+    size_t limit() const
+    {
+        return this->limit_;
+    }
+
 private:
     qsizetype space() const
     {
@@ -2,9 +2,11 @@
 
 #include "common/FlagsEnum.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
+#include "util/MonotonicArena.hpp"
 #include "widgets/helper/ScrollbarHighlight.hpp"
 
 #include <QTime>
+#include <boost/container/flat_map.hpp>
 #include <boost/noncopyable.hpp>
 #include <cinttypes>
 #include <memory>
@@ -42,6 +44,10 @@ enum class MessageFlag : uint32_t {
 };
 using MessageFlags = FlagsEnum<MessageFlag>;
 
+// Messages rarely carry more than one or two badge infos, so a sorted vector
+// is both smaller and faster to search than a node based map
+using MessageBadgeInfos = boost::container::flat_map<QString, QString>;
+
 struct Message : boost::noncopyable {
     Message();
     ~Message();
@@ -65,10 +71,12 @@ struct Message : boost::noncopyable {
     QColor usernameColor;
     QDateTime serverReceivedTime;
     std::vector<Badge> badges;
-    std::map<QString, QString> badgeInfos;
+    MessageBadgeInfos badgeInfos;
     std::shared_ptr<QColor> highlightColor;
     uint32_t count = 1;
-    std::vector<std::unique_ptr<MessageElement>> elements;
+    // Owns the elements, which are released together with the message
+    MonotonicArena elementArena{512};
+    std::vector<MessageElement *> elements;
 
     ScrollbarHighlight getScrollBarHighlight() const;
 };
@@ -461,9 +461,14 @@ std::weak_ptr<Message> MessageBuilder::weakOf()
     return this->message_;
 }
 
-void MessageBuilder::append(std::unique_ptr<MessageElement> element)
+void MessageBuilder::append(MessageElement *element)
 {
-    this->message().elements.push_back(std::move(element));
+    this->message().elements.push_back(element);
+}
+
+MonotonicArena &MessageBuilder::elementArena()
+{
+    return this->message().elementArena;
 }
 
 QString MessageBuilder::matchLink(const QString &string)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "messages/MessageElement.hpp"
+#include "util/MonotonicArena.hpp"
 
 #include <QRegularExpression>
 #include <ctime>
@@ -58,7 +59,8 @@ public:
     MessagePtr release();
     std::weak_ptr<Message> weakOf();
 
-    void append(std::unique_ptr<MessageElement> element);
+    // element must have been created in elementArena()
+    void append(MessageElement *element);
     QString matchLink(const QString &string);
     void addLink(const QString &origLink, const QString &matchedLink);
 
@@ -71,13 +73,15 @@ public:
         static_assert(std::is_base_of<MessageElement, T>::value,
                       "T must extend MessageElement");
 
-        auto unique = std::make_unique<T>(std::forward<Args>(args)...);
-        auto pointer = unique.get();
-        this->append(std::move(unique));
+        auto pointer =
+            this->elementArena().create<T>(std::forward<Args>(args)...);
+        this->append(pointer);
         return pointer;
     }
 
 private:
+    MonotonicArena &elementArena();
+
     // Helper method that emplaces some text stylized as system text
     // and then appends that text to the QString parameter "toUpdate".
     // Returns the TextElement that was emplaced.
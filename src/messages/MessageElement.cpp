@@ -127,7 +127,9 @@ void ImageElement::addToContainer(MessageLayoutContainer &container,
         auto size = QSize(this->image_->width() * container.getScale(),
                           this->image_->height() * container.getScale());
 
-        container.addElement((new ImageLayoutElement(*this, this->image_, size))
+        container.addElement(container
+                                 .createElement<ImageLayoutElement>(
+                                     *this, this->image_, size)
                                  ->setLink(this->getLink()));
     }
 }
@@ -167,8 +169,9 @@ void EmoteElement::addToContainer(MessageLayoutContainer &container,
                 QSize(int(container.getScale() * image->width() * emoteScale),
                       int(container.getScale() * image->height() * emoteScale));
 
-            container.addElement(this->makeImageLayoutElement(image, size)
-                                     ->setLink(this->getLink()));
+            container.addElement(
+                this->makeImageLayoutElement(container, image, size)
+                    ->setLink(this->getLink()));
         }
         else
         {
@@ -182,9 +185,10 @@ void EmoteElement::addToContainer(MessageLayoutContainer &container,
 }
 
 MessageLayoutElement *EmoteElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
-    return new ImageLayoutElement(*this, image, size);
+    return container.createElement<ImageLayoutElement>(*this, image, size);
 }
 
 // BADGE
@@ -208,7 +212,8 @@ void BadgeElement::addToContainer(MessageLayoutContainer &container,
         auto size = QSize(int(container.getScale() * image->width()),
                           int(container.getScale() * image->height()));
 
-        container.addElement(this->makeImageLayoutElement(image, size));
+        container.addElement(
+            this->makeImageLayoutElement(container, image, size));
     }
 }
 
@@ -218,10 +223,12 @@ EmotePtr BadgeElement::getEmote() const
 }
 
 MessageLayoutElement *BadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
     auto element =
-        (new ImageLayoutElement(*this, image, size))->setLink(this->getLink());
+        container.createElement<ImageLayoutElement>(*this, image, size)
+            ->setLink(this->getLink());
 
     return element;
 }
@@ -234,12 +241,14 @@ ModBadgeElement::ModBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *ModBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
     static const QColor modBadgeBackgroundColor("#34AE0A");
 
-    auto element = (new ImageWithBackgroundLayoutElement(
-                        *this, image, size, modBadgeBackgroundColor))
+    auto element = container
+                       .createElement<ImageWithBackgroundLayoutElement>(
+                           *this, image, size, modBadgeBackgroundColor)
                        ->setLink(this->getLink());
 
     return element;
@@ -253,10 +262,12 @@ VipBadgeElement::VipBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *VipBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
     auto element =
-        (new ImageLayoutElement(*this, image, size))->setLink(this->getLink());
+        container.createElement<ImageLayoutElement>(*this, image, size)
+            ->setLink(this->getLink());
 
     return element;
 }
@@ -270,11 +281,13 @@ FfzBadgeElement::FfzBadgeElement(const EmotePtr &data,
 }
 
 MessageLayoutElement *FfzBadgeElement::makeImageLayoutElement(
-    const ImagePtr &image, const QSize &size)
+    MessageLayoutContainer &container, const ImagePtr &image,
+    const QSize &size)
 {
-    auto element =
-        (new ImageWithBackgroundLayoutElement(*this, image, size, this->color))
-            ->setLink(this->getLink());
+    auto element = container
+                       .createElement<ImageWithBackgroundLayoutElement>(
+                           *this, image, size, this->color)
+                       ->setLink(this->getLink());
 
     return element;
 }
@@ -286,7 +299,10 @@ TextElement::TextElement(const QString &text, MessageElementFlags flags,
     , color_(color)
     , style_(style)
 {
-    for (const auto &word : text.split(' '))
+    auto words = text.split(' ');
+    this->words_.reserve(words.size());
+
+    for (const auto &word : words)
     {
         this->words_.push_back({word, -1});
         // fourtf: add logic to store multiple spaces after message
@@ -310,9 +326,10 @@ void TextElement::addToContainer(MessageLayoutContainer &container,
                 auto color = this->color_.getColor(*app->themes);
                 app->themes->normalizeColor(color);
 
-                auto e = (new TextLayoutElement(
-                              *this, text, QSize(width, metrics.height()),
-                              color, this->style_, container.getScale()))
+                auto e = container
+                             .createElement<TextLayoutElement>(
+                                 *this, text, QSize(width, metrics.height()),
+                                 color, this->style_, container.getScale())
                              ->setLink(this->getLink());
                 e->setTrailingSpace(hasTrailingSpace);
                 e->setText(text);
@@ -442,21 +459,23 @@ void TwitchModerationElement::addToContainer(MessageLayoutContainer &container,
     {
         QSize size(int(container.getScale() * 16),
                    int(container.getScale() * 16));
-        auto actions = getCSettings().moderationActions.readOnly();
-        for (const auto &action : *actions)
+        for (const auto &action : getCSettings().moderationActions.snapshot())
         {
             if (auto image = action.getImage())
             {
                 container.addElement(
-                    (new ImageLayoutElement(*this, image.get(), size))
+                    container
+                        .createElement<ImageLayoutElement>(*this, image.get(),
+                                                           size)
                         ->setLink(Link(Link::UserAction, action.getAction())));
             }
             else
             {
                 container.addElement(
-                    (new TextIconLayoutElement(*this, action.getLine1(),
-                                               action.getLine2(),
-                                               container.getScale(), size))
+                    container
+                        .createElement<TextIconLayoutElement>(
+                            *this, action.getLine1(), action.getLine2(),
+                            container.getScale(), size)
                         ->setLink(Link(Link::UserAction, action.getAction())));
             }
         }
@@ -497,8 +516,9 @@ void ScalingImageElement::addToContainer(MessageLayoutContainer &container,
         auto size = QSize(image->width() * container.getScale(),
                           image->height() * container.getScale());
 
-        container.addElement((new ImageLayoutElement(*this, image, size))
-                                 ->setLink(this->getLink()));
+        container.addElement(
+            container.createElement<ImageLayoutElement>(*this, image, size)
+                ->setLink(this->getLink()));
     }
 }
 
@@ -246,8 +246,9 @@ public:
     EmotePtr getEmote() const;
 
 protected:
-    virtual MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                         const QSize &size);
+    virtual MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size);
 
 private:
     std::unique_ptr<TextElement> textElement_;
@@ -265,8 +266,9 @@ public:
     EmotePtr getEmote() const;
 
 protected:
-    virtual MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                         const QSize &size);
+    virtual MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size);
 
 private:
     EmotePtr emote_;
@@ -278,8 +280,9 @@ public:
     ModBadgeElement(const EmotePtr &data, MessageElementFlags flags_);
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 const QSize &size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size) override;
 };
 
 class VipBadgeElement : public BadgeElement
@@ -288,8 +291,9 @@ public:
     VipBadgeElement(const EmotePtr &data, MessageElementFlags flags_);
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 const QSize &size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size) override;
 };
 
 class FfzBadgeElement : public BadgeElement
@@ -299,8 +303,9 @@ public:
                     QColor &color);
 
 protected:
-    MessageLayoutElement *makeImageLayoutElement(const ImagePtr &image,
-                                                 const QSize &size) override;
+    MessageLayoutElement *makeImageLayoutElement(
+        MessageLayoutContainer &container, const ImagePtr &image,
+        const QSize &size) override;
     QColor color;
 };
 
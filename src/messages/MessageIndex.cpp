@@ -0,0 +1,247 @@
+#include "messages/MessageIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <algorithm>
+
+namespace chatterino {
+
+namespace {
+
+    // Keeps the newest message if there are several with the same key
+    template <typename Map, typename Key>
+    void setNewest(Map &map, const Key &key, int64_t sequence)
+    {
+        auto it = map.find(key);
+        if (it == map.end())
+        {
+            map.emplace(key, sequence);
+        }
+        else if (it->second < sequence)
+        {
+            it->second = sequence;
+        }
+    }
+
+    template <typename Map, typename Key>
+    void eraseIfEqual(Map &map, const Key &key, int64_t sequence)
+    {
+        auto it = map.find(key);
+        if (it != map.end() && it->second == sequence)
+        {
+            map.erase(it);
+        }
+    }
+
+    // The lower case names of the users a message is related to
+    std::vector<QString> relatedUsers(const Message &message)
+    {
+        std::vector<QString> users;
+        auto add = [&users](const QString &name) {
+            auto key = name.toLower();
+            if (!key.isEmpty() &&
+                std::find(users.begin(), users.end(), key) == users.end())
+            {
+                users.push_back(std::move(key));
+            }
+        };
+
+        add(message.loginName);
+        add(message.timeoutUser);
+
+        // Subscription announcements start with the subscriber's name
+        if (message.flags.has(MessageFlag::Subscription) &&
+            message.loginName.isEmpty())
+        {
+            add(message.messageText.section(' ', 0, 0));
+        }
+
+        return users;
+    }
+
+}  // namespace
+
+void MessageIndex::pushBack(const MessagePtr &message)
+{
+    this->add(message, this->endSequence_++);
+}
+
+void MessageIndex::popFront(const MessagePtr &message)
+{
+    if (this->size() == 0)
+    {
+        return;
+    }
+
+    this->remove(message.get(), this->firstSequence_++);
+}
+
+void MessageIndex::pushFront(const std::vector<MessagePtr> &messages)
+{
+    for (auto it = messages.rbegin(); it != messages.rend(); ++it)
+    {
+        this->add(*it, --this->firstSequence_);
+    }
+}
+
+void MessageIndex::replace(const MessagePtr &message,
+                           const MessagePtr &replacement)
+{
+    auto it = this->sequences_.find(message.get());
+    if (it == this->sequences_.end())
+    {
+        return;
+    }
+
+    auto sequence = it->second;
+    this->remove(message.get(), sequence);
+    this->add(replacement, sequence);
+}
+
+void MessageIndex::clear()
+{
+    this->firstSequence_ = 0;
+    this->endSequence_ = 0;
+    this->sequences_.clear();
+    this->ids_.clear();
+    this->users_.clear();
+}
+
+size_t MessageIndex::size() const
+{
+    return size_t(this->endSequence_ - this->firstSequence_);
+}
+
+boost::optional<size_t> MessageIndex::positionOf(const Message *message) const
+{
+    auto it = this->sequences_.find(message);
+    if (it == this->sequences_.end())
+    {
+        return boost::none;
+    }
+
+    return size_t(it->second - this->firstSequence_);
+}
+
+boost::optional<size_t> MessageIndex::findById(const QString &id) const
+{
+    auto it = this->ids_.find(id);
+    if (it == this->ids_.end())
+    {
+        return boost::none;
+    }
+
+    return size_t(it->second - this->firstSequence_);
+}
+
+std::vector<size_t> MessageIndex::findByUser(const QString &userName) const
+{
+    std::vector<size_t> positions;
+
+    auto it = this->users_.find(userName.toLower());
+    if (it == this->users_.end())
+    {
+        return positions;
+    }
+
+    positions.reserve(it->second.size());
+    for (auto sequence : it->second)
+    {
+        positions.push_back(size_t(sequence - this->firstSequence_));
+    }
+
+    return positions;
+}
+
+void MessageIndex::add(const MessagePtr &message, int64_t sequence)
+{
+    if (message == nullptr)
+    {
+        return;
+    }
+
+    setNewest(this->sequences_, message.get(), sequence);
+
+    if (!message->id.isEmpty())
+    {
+        setNewest(this->ids_, message->id, sequence);
+    }
+
+    for (const auto &user : relatedUsers(*message))
+    {
+        this->addUser(user, sequence);
+    }
+}
+
+void MessageIndex::remove(const Message *message, int64_t sequence)
+{
+    if (message == nullptr)
+    {
+        return;
+    }
+
+    eraseIfEqual(this->sequences_, message, sequence);
+
+    if (!message->id.isEmpty())
+    {
+        eraseIfEqual(this->ids_, message->id, sequence);
+    }
+
+    for (const auto &user : relatedUsers(*message))
+    {
+        this->removeUser(user, sequence);
+    }
+}
+
+void MessageIndex::addUser(const QString &key, int64_t sequence)
+{
+    auto &sequences = this->users_[key];
+
+    if (sequences.empty() || sequences.back() < sequence)
+    {
+        sequences.push_back(sequence);
+    }
+    else if (sequences.front() > sequence)
+    {
+        sequences.push_front(sequence);
+    }
+    else
+    {
+        // A replacement in the middle of the queue
+        sequences.insert(
+            std::lower_bound(sequences.begin(), sequences.end(), sequence),
+            sequence);
+    }
+}
+
+void MessageIndex::removeUser(const QString &key, int64_t sequence)
+{
+    auto it = this->users_.find(key);
+    if (it == this->users_.end())
+    {
+        return;
+    }
+
+    auto &sequences = it->second;
+    if (sequences.front() == sequence)
+    {
+        // Evicted, the common case
+        sequences.pop_front();
+    }
+    else
+    {
+        auto found =
+            std::lower_bound(sequences.begin(), sequences.end(), sequence);
+        if (found != sequences.end() && *found == sequence)
+        {
+            sequences.erase(found);
+        }
+    }
+
+    if (sequences.empty())
+    {
+        this->users_.erase(it);
+    }
+}
+
+}  // namespace chatterino
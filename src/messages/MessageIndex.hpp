@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QString>
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace chatterino {
+
+struct Message;
+using MessagePtr = std::shared_ptr<const Message>;
+
+/**
+ * @brief Finds messages in a channel's LimitedQueue by id and by user
+ *
+ * Moderation events and the user info popup used to scan the queue to find
+ * the messages they affect. The index is updated together with the queue
+ * and returns positions in it, so a timeout costs O(k) in the number of the
+ * user's messages instead of O(n) in the number of messages.
+ *
+ * Every message gets a sequence number that never changes: appended
+ * messages count up, messages added at the start count down. The position
+ * of a message is its sequence number minus the one of the first message.
+ *
+ * Must be updated from the same thread as the queue, right after it.
+ **/
+class MessageIndex
+{
+public:
+    // message was appended to the queue
+    void pushBack(const MessagePtr &message);
+    // message was the first one in the queue and got evicted
+    void popFront(const MessagePtr &message);
+    // messages were added to the start of the queue, oldest first
+    void pushFront(const std::vector<MessagePtr> &messages);
+    // message was replaced by replacement at the same position
+    void replace(const MessagePtr &message, const MessagePtr &replacement);
+    void clear();
+
+    size_t size() const;
+
+    boost::optional<size_t> positionOf(const Message *message) const;
+    // Returns the position of the newest message with this id
+    boost::optional<size_t> findById(const QString &id) const;
+    // Returns the positions of all messages related to the user, oldest
+    // first: sent by them, moderation messages targeting them and their
+    // subscription announcements. Ignores case.
+    std::vector<size_t> findByUser(const QString &userName) const;
+
+private:
+    void add(const MessagePtr &message, int64_t sequence);
+    void remove(const Message *message, int64_t sequence);
+    void addUser(const QString &key, int64_t sequence);
+    void removeUser(const QString &key, int64_t sequence);
+
+    int64_t firstSequence_ = 0;
+    int64_t endSequence_ = 0;
+
+    std::unordered_map<const Message *, int64_t> sequences_;
+    std::unordered_map<QString, int64_t> ids_;
+    // By lower case user name, sorted, oldest first
+    std::unordered_map<QString, std::deque<int64_t>> users_;
+};
+
+}  // namespace chatterino
@@ -7,6 +7,7 @@
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
 #include "singletons/Settings.hpp"
+#include "singletons/SettingsSnapshot.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Helpers.hpp"
 #include "util/Qt.hpp"
@@ -19,14 +20,14 @@ namespace chatterino {
 
 namespace {
 
-    QUrl getFallbackHighlightSound()
+    QUrl getFallbackHighlightSound(const SettingsSnapshot &settings)
     {
-        QString path = getSettings()->pathHighlightSound;
+        const QString &path = settings.pathHighlightSound;
         bool fileExists = QFileInfo::exists(path) && QFileInfo(path).isFile();
 
         // Use fallback sound when checkbox is not checked
         // or custom file doesn't exist
-        if (getSettings()->customHighlightSound && fileExists)
+        if (settings.customHighlightSound && fileExists)
         {
             return QUrl::fromLocalFile(path);
         }
@@ -74,6 +75,7 @@ SharedMessageBuilder::SharedMessageBuilder(
     , tags(this->ircMessage->tags())
     , originalMessage_(_ircMessage->content())
     , action_(_ircMessage->isAction())
+    , settings_(getSettingsSnapshot())
 {
 }
 
@@ -86,6 +88,7 @@ SharedMessageBuilder::SharedMessageBuilder(
     , tags(this->ircMessage->tags())
     , originalMessage_(content)
     , action_(isAction)
+    , settings_(getSettingsSnapshot())
 {
 }
 
@@ -112,7 +115,7 @@ bool SharedMessageBuilder::isIgnored() const
 
 void SharedMessageBuilder::parseUsernameColor()
 {
-    if (getSettings()->colorizeNicknames)
+    if (this->settings_->colorizeNicknames)
     {
         this->usernameColor_ = getRandomColor(this->ircMessage->nick());
     }
@@ -137,26 +140,28 @@ void SharedMessageBuilder::parseHighlights()
     }
 
     // Highlight because it's a whisper
-    if (this->args.isReceivedWhisper && getSettings()->enableWhisperHighlight)
+    if (this->args.isReceivedWhisper &&
+        this->settings_->enableWhisperHighlight)
     {
-        if (getSettings()->enableWhisperHighlightTaskbar)
+        if (this->settings_->enableWhisperHighlightTaskbar)
         {
             this->highlightAlert_ = true;
         }
 
-        if (getSettings()->enableWhisperHighlightSound)
+        if (this->settings_->enableWhisperHighlightSound)
         {
             this->highlightSound_ = true;
 
             // Use custom sound if set, otherwise use fallback
-            if (!getSettings()->whisperHighlightSoundUrl.getValue().isEmpty())
+            if (!this->settings_->whisperHighlightSoundUrl.isEmpty())
             {
                 this->highlightSoundUrl_ =
-                    QUrl(getSettings()->whisperHighlightSoundUrl.getValue());
+                    QUrl(this->settings_->whisperHighlightSoundUrl);
             }
             else
             {
-                this->highlightSoundUrl_ = getFallbackHighlightSound();
+                this->highlightSoundUrl_ =
+                    getFallbackHighlightSound(*this->settings_);
             }
         }
 
@@ -170,8 +175,8 @@ void SharedMessageBuilder::parseHighlights()
     }
 
     // Highlight because of sender
-    auto userHighlights = getCSettings().highlightedUsers.readOnly();
-    for (const HighlightPhrase &userHighlight : *userHighlights)
+    for (const HighlightPhrase &userHighlight :
+         getCSettings().highlightedUsers.snapshot())
     {
         if (!userHighlight.isMatch(this->ircMessage->nick()))
         {
@@ -183,7 +188,7 @@ void SharedMessageBuilder::parseHighlights()
 
         this->message().flags.set(MessageFlag::Highlighted);
         if (!(this->message().flags.has(MessageFlag::Subscription) &&
-              getSettings()->enableSubHighlight))
+              this->settings_->enableSubHighlight))
         {
             this->message().highlightColor = userHighlight.getColor();
         }
@@ -208,7 +213,8 @@ void SharedMessageBuilder::parseHighlights()
             }
             else
             {
-                this->highlightSoundUrl_ = getFallbackHighlightSound();
+                this->highlightSoundUrl_ =
+                    getFallbackHighlightSound(*this->settings_);
             }
         }
 
@@ -234,26 +240,27 @@ void SharedMessageBuilder::parseHighlights()
 
     // Highlight because it's a subscription
     if (this->message().flags.has(MessageFlag::Subscription) &&
-        getSettings()->enableSubHighlight)
+        this->settings_->enableSubHighlight)
     {
-        if (getSettings()->enableSubHighlightTaskbar)
+        if (this->settings_->enableSubHighlightTaskbar)
         {
             this->highlightAlert_ = true;
         }
 
-        if (getSettings()->enableSubHighlightSound)
+        if (this->settings_->enableSubHighlightSound)
         {
             this->highlightSound_ = true;
 
             // Use custom sound if set, otherwise use fallback
-            if (!getSettings()->subHighlightSoundUrl.getValue().isEmpty())
+            if (!this->settings_->subHighlightSoundUrl.isEmpty())
             {
                 this->highlightSoundUrl_ =
-                    QUrl(getSettings()->subHighlightSoundUrl.getValue());
+                    QUrl(this->settings_->subHighlightSoundUrl);
             }
             else
             {
-                this->highlightSoundUrl_ = getFallbackHighlightSound();
+                this->highlightSoundUrl_ =
+                    getFallbackHighlightSound(*this->settings_);
             }
         }
 
@@ -262,34 +269,16 @@ void SharedMessageBuilder::parseHighlights()
             ColorProvider::instance().color(ColorType::Subscription);
     }
 
-    // TODO: This vector should only be rebuilt upon highlights being changed
-    // fourtf: should be implemented in the HighlightsController
-    std::vector<HighlightPhrase> activeHighlights =
-        getSettings()->highlightedMessages.cloneVector();
-
-    if (!currentUser->isAnon() && getSettings()->enableSelfHighlight &&
-        currentUsername.size() > 0)
-    {
-        HighlightPhrase selfHighlight(
-            currentUsername, getSettings()->showSelfHighlightInMentions,
-            getSettings()->enableSelfHighlightTaskbar,
-            getSettings()->enableSelfHighlightSound, false, false,
-            getSettings()->selfHighlightSoundUrl.getValue(),
-            ColorProvider::instance().color(ColorType::SelfHighlight));
-        activeHighlights.emplace_back(std::move(selfHighlight));
-    }
-
-    // Highlight because of message
-    for (const HighlightPhrase &highlight : activeHighlights)
-    {
+    // Returns true once no further attributes can be applied
+    auto applyHighlight = [this](const HighlightPhrase &highlight) {
         if (!highlight.isMatch(this->originalMessage_))
         {
-            continue;
+            return false;
         }
 
         this->message().flags.set(MessageFlag::Highlighted);
         if (!(this->message().flags.has(MessageFlag::Subscription) &&
-              getSettings()->enableSubHighlight))
+              this->settings_->enableSubHighlight))
         {
             this->message().highlightColor = highlight.getColor();
         }
@@ -317,25 +306,48 @@ void SharedMessageBuilder::parseHighlights()
             }
             else
             {
-                this->highlightSoundUrl_ = getFallbackHighlightSound();
+                this->highlightSoundUrl_ =
+                    getFallbackHighlightSound(*this->settings_);
             }
         }
 
-        if (this->highlightAlert_ && this->highlightSound_)
+        /*
+         * Stop once no further attributes (taskbar, sound) can be
+         * applied.
+         */
+        return this->highlightAlert_ && this->highlightSound_;
+    };
+
+    // Highlight because of message
+    bool highlightsDone = false;
+    for (const HighlightPhrase &highlight :
+         getCSettings().highlightedMessages.snapshot())
+    {
+        if (applyHighlight(highlight))
         {
-            /*
-             * Break once no further attributes (taskbar, sound) can be
-             * applied.
-             */
+            highlightsDone = true;
             break;
         }
     }
 
+    // Highlight because of the current user's name, after the phrases
+    if (!highlightsDone && !currentUser->isAnon() &&
+        this->settings_->enableSelfHighlight && currentUsername.size() > 0)
+    {
+        HighlightPhrase selfHighlight(
+            currentUsername, this->settings_->showSelfHighlightInMentions,
+            this->settings_->enableSelfHighlightTaskbar,
+            this->settings_->enableSelfHighlightSound, false, false,
+            this->settings_->selfHighlightSoundUrl,
+            ColorProvider::instance().color(ColorType::SelfHighlight));
+        applyHighlight(selfHighlight);
+    }
+
     // Highlight because of badge
     auto badges = parseBadges(this->tags);
-    auto badgeHighlights = getCSettings().highlightedBadges.readOnly();
     bool badgeHighlightSet = false;
-    for (const HighlightBadge &highlight : *badgeHighlights)
+    for (const HighlightBadge &highlight :
+         getCSettings().highlightedBadges.snapshot())
     {
         for (const Badge &badge : badges)
         {
@@ -348,7 +360,7 @@ void SharedMessageBuilder::parseHighlights()
             {
                 this->message().flags.set(MessageFlag::Highlighted);
                 if (!(this->message().flags.has(MessageFlag::Subscription) &&
-                      getSettings()->enableSubHighlight))
+                      this->settings_->enableSubHighlight))
                 {
                     this->message().highlightColor = highlight.getColor();
                 }
@@ -367,9 +379,10 @@ void SharedMessageBuilder::parseHighlights()
             {
                 this->highlightSound_ = true;
                 // Use custom sound if set, otherwise use fallback sound
-                this->highlightSoundUrl_ = highlight.hasCustomSound()
-                                               ? highlight.getSoundUrl()
-                                               : getFallbackHighlightSound();
+                this->highlightSoundUrl_ =
+                    highlight.hasCustomSound()
+                        ? highlight.getSoundUrl()
+                        : getFallbackHighlightSound(*this->settings_);
             }
 
             if (this->highlightAlert_ && this->highlightSound_)
@@ -446,7 +459,7 @@ void SharedMessageBuilder::triggerHighlights()
 {
     static QUrl currentPlayerUrl;
 
-    if (isInStreamerMode() && getSettings()->streamerModeMuteMentions)
+    if (isInStreamerMode() && this->settings_->streamerModeMuteMentions)
     {
         // We are in streamer mode with muting mention sounds enabled. Do nothing.
         return;
@@ -459,7 +472,7 @@ void SharedMessageBuilder::triggerHighlights()
     }
 
     bool hasFocus = (QApplication::focusWidget() != nullptr);
-    bool resolveFocus = !hasFocus || getSettings()->highlightAlwaysPlaySound;
+    bool resolveFocus = !hasFocus || this->settings_->highlightAlwaysPlaySound;
 
     if (this->highlightSound_ && resolveFocus)
     {
@@ -3,6 +3,7 @@
 #include "common/Aliases.hpp"
 #include "common/Outcome.hpp"
 #include "messages/MessageColor.hpp"
+#include "singletons/SettingsSnapshot.hpp"
 
 #include <IrcMessage>
 #include <QColor>
@@ -60,6 +61,9 @@ protected:
 
     const bool action_{};
 
+    // Grabbed once so the settings can't change halfway through a message
+    const SettingsSnapshotPtr settings_;
+
     QColor usernameColor_ = {153, 153, 153};
     MessageColor textColor_ = MessageColor::Text;
 
@@ -2,11 +2,13 @@
 
 #include "Application.hpp"
 #include "debug/Benchmark.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
+#include "messages/layouts/MessageLayoutCache.hpp"
 #include "messages/layouts/MessageLayoutContainer.hpp"
 #include "singletons/Emotes.hpp"
-#include "singletons/Settings.hpp"
+#include "singletons/SettingsSnapshot.hpp"
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/DebugCount.hpp"
@@ -55,18 +57,22 @@ const Message *MessageLayout::getMessage()
     return this->message_.get();
 }
 
+const MessagePtr &MessageLayout::getMessagePtr() const
+{
+    return this->message_;
+}
+
 // Height
 int MessageLayout::getHeight() const
 {
-    return container_->getHeight();
+    // The container might have been released by deleteCache
+    return this->height_;
 }
 
 // Layout
 // return true if redraw is required
 bool MessageLayout::layout(int width, float scale, MessageElementFlags flags)
 {
-    //    BenchmarkGuard benchmark("MessageLayout::layout()");
-
     auto app = getApp();
 
     bool layoutRequired = false;
@@ -88,6 +94,13 @@ bool MessageLayout::layout(int width, float scale, MessageElementFlags flags)
     layoutRequired |= this->currentWordFlags_ != flags;
     this->currentWordFlags_ = flags;  // getSettings()->getWordTypeMask();
 
+    // check if the message got disabled, hidden or collapsed
+    layoutRequired |= this->currentMessageFlags_ != this->message_->flags;
+    this->currentMessageFlags_ = this->message_->flags;
+
+    // check if an image loaded, the layout used its placeholder size
+    layoutRequired |= this->container_->hasLoadedPendingImages();
+
     // check if layout was requested manually
     layoutRequired |= this->flags.has(MessageLayoutFlag::RequiresLayout);
     this->flags.unset(MessageLayoutFlag::RequiresLayout);
@@ -114,48 +127,81 @@ bool MessageLayout::layout(int width, float scale, MessageElementFlags flags)
 
 void MessageLayout::actuallyLayout(int width, MessageElementFlags flags)
 {
-    this->layoutCount_++;
+    TraceScope trace("MessageLayout::actuallyLayout");
+
     auto messageFlags = this->message_->flags;
 
-    if (this->flags.has(MessageLayoutFlag::Expanded) ||
-        (flags.has(MessageElementFlag::ModeratorTools) &&
-         !this->message_->flags.has(MessageFlag::Disabled)))
+    bool expanded = this->flags.has(MessageLayoutFlag::Expanded) ||
+                    (flags.has(MessageElementFlag::ModeratorTools) &&
+                     !this->message_->flags.has(MessageFlag::Disabled));
+    if (expanded)
     {
         messageFlags.unset(MessageFlag::Collapsed);
     }
 
-    this->container_->begin(width, this->scale_, messageFlags);
-
-    for (const auto &element : this->message_->elements)
+    auto settings = getSettingsSnapshot();
+    auto &cache = MessageLayoutCache::instance();
+    MessageLayoutCache::Key key{};
+    key.message = this->message_.get();
+    key.width = width;
+    key.scale = this->scale_;
+    key.flags = flags;
+    key.messageFlags = this->message_->flags;
+    key.generation = this->layoutState_;
+    key.settingsVersion = settings->version;
+    key.expanded = expanded;
+
+    auto cached = cache.get(key);
+    if (cached != nullptr && !cached->hasLoadedPendingImages())
     {
-        if (getSettings()->hideModerated &&
-            this->message_->flags.has(MessageFlag::Disabled))
+        // Already laid out by another view
+        this->container_ = std::move(cached);
+    }
+    else
+    {
+        this->layoutCount_++;
+
+        if (this->container_.use_count() > 1)
         {
-            continue;
+            // Other views still use the old layout
+            this->container_ = std::make_shared<MessageLayoutContainer>();
         }
-
-        if (getSettings()->hideModerationActions &&
-            (this->message_->flags.has(MessageFlag::Timeout) ||
-             this->message_->flags.has(MessageFlag::Untimeout)))
+        else
         {
-            continue;
+            // Reuse the memory of our own container
+            cache.remove(this->cacheKey_, this->container_.get());
         }
 
-        if (getSettings()->hideSimilar &&
-            this->message_->flags.has(MessageFlag::Similar))
+        this->container_->begin(width, this->scale_, messageFlags);
+
+        // None of these depend on the element, so the message is either laid
+        // out completely or not at all
+        bool hidden =
+            (settings->hideModerated &&
+             this->message_->flags.has(MessageFlag::Disabled)) ||
+            (settings->hideModerationActions &&
+             (this->message_->flags.has(MessageFlag::Timeout) ||
+              this->message_->flags.has(MessageFlag::Untimeout))) ||
+            (settings->hideSimilar &&
+             this->message_->flags.has(MessageFlag::Similar));
+
+        if (!hidden)
         {
-            continue;
+            for (const auto &element : this->message_->elements)
+            {
+                element->addToContainer(*this->container_, flags);
+            }
         }
 
-        element->addToContainer(*this->container_, flags);
+        this->container_->end();
+        cache.insert(key, this->container_);
     }
+    this->cacheKey_ = key;
 
     if (this->height_ != this->container_->getHeight())
     {
         this->deleteBuffer();
     }
-
-    this->container_->end();
     this->height_ = this->container_->getHeight();
 
     // collapsed state
@@ -172,6 +218,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
                           bool isWindowFocused, bool isMentions)
 {
     auto app = getApp();
+    auto settings = getSettingsSnapshot();
     QPixmap *pixmap = this->buffer_.get();
 
     // create new buffer if required
@@ -223,7 +270,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     if (!isMentions &&
         (this->message_->flags.has(MessageFlag::RedeemedChannelPointReward) ||
          this->message_->flags.has(MessageFlag::RedeemedHighlight)) &&
-        getSettings()->enableRedeemedHighlight.getValue())
+        settings->enableRedeemedHighlight)
     {
         painter.fillRect(
             0, y, this->scale_ * 4, pixmap->height(),
@@ -237,7 +284,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     }
 
     // draw message seperation line
-    if (getSettings()->separateMessages.getValue())
+    if (settings->separateMessages)
     {
         painter.fillRect(0, y, this->container_->getWidth() + 64, 1,
                          app->themes->splits.messageSeperator);
@@ -247,9 +294,9 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     if (isLastReadMessage)
     {
         QColor color;
-        if (getSettings()->lastMessageColor != "")
+        if (settings->lastMessageColor.isValid())
         {
-            color = QColor(getSettings()->lastMessageColor.getValue());
+            color = settings->lastMessageColor;
         }
         else
         {
@@ -259,8 +306,7 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
                     : app->themes->tabs.selected.backgrounds.unfocused.color();
         }
 
-        QBrush brush(color, static_cast<Qt::BrushStyle>(
-                                getSettings()->lastMessagePattern.getValue()));
+        QBrush brush(color, settings->lastMessagePattern);
 
         painter.fillRect(0, y + this->container_->getHeight() - 1,
                          pixmap->width(), 1, brush);
@@ -269,21 +315,32 @@ void MessageLayout::paint(QPainter &painter, int width, int y, int messageIndex,
     this->bufferValid_ = true;
 }
 
+void MessageLayout::addAnimatedImageAreas(
+    std::vector<AnimatedImageArea> &areas, int y) const
+{
+    if (this->container_ != nullptr)
+    {
+        this->container_->addAnimatedImageAreas(areas, y);
+    }
+}
+
 void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
                                  Selection & /*selection*/)
 {
     if (buffer->isNull())
         return;
 
+    TraceScope trace("MessageLayout::updateBuffer");
+
     auto app = getApp();
-    auto settings = getSettings();
+    auto settings = getSettingsSnapshot();
 
     QPainter painter(buffer);
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
 
     // draw background
-    QColor backgroundColor = [this, &app] {
-        if (getSettings()->alternateMessages.getValue() &&
+    QColor backgroundColor = [this, &app, &settings] {
+        if (settings->alternateMessages &&
             this->flags.has(MessageLayoutFlag::AlternateBackground))
         {
             return app->themes->messages.backgrounds.alternate;
@@ -295,7 +352,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
     }();
 
     if (this->message_->flags.has(MessageFlag::FirstMessage) &&
-        getSettings()->enableFirstMessageHighlight.getValue())
+        settings->enableFirstMessageHighlight)
     {
         backgroundColor = blendColors(
             backgroundColor,
@@ -310,7 +367,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
             blendColors(backgroundColor, *this->message_->highlightColor);
     }
     else if (this->message_->flags.has(MessageFlag::Subscription) &&
-             getSettings()->enableSubHighlight)
+             settings->enableSubHighlight)
     {
         // Blend highlight color with usual background color
         backgroundColor = blendColors(
@@ -320,7 +377,7 @@ void MessageLayout::updateBuffer(QPixmap *buffer, int /*messageIndex*/,
     else if ((this->message_->flags.has(MessageFlag::RedeemedHighlight) ||
               this->message_->flags.has(
                   MessageFlag::RedeemedChannelPointReward)) &&
-             settings->enableRedeemedHighlight.getValue())
+             settings->enableRedeemedHighlight)
     {
         // Blend highlight color with usual background color
         backgroundColor = blendColors(
@@ -376,9 +433,20 @@ void MessageLayout::deleteCache()
 {
     this->deleteBuffer();
 
-#ifdef XD
-    this->container_->clear();
-#endif
+    // Releases all layout elements at once, they get recreated on the next
+    // layout call. height_ is kept so scrolling still works until then.
+    if (this->container_.use_count() > 1)
+    {
+        // Other views still use it
+        this->container_ = std::make_shared<MessageLayoutContainer>();
+    }
+    else
+    {
+        MessageLayoutCache::instance().remove(this->cacheKey_,
+                                              this->container_.get());
+        this->container_->releaseMemory();
+    }
+    this->flags.set(MessageLayoutFlag::RequiresLayout);
 }
 
 // Elements
@@ -389,29 +457,54 @@ void MessageLayout::deleteCache()
 // fourtf: this should return a MessageLayoutItem
 const MessageLayoutElement *MessageLayout::getElementAt(QPoint point)
 {
+    this->layoutIfReleased();
+
     // go through all words and return the first one that contains the point.
     return this->container_->getElementAt(point);
 }
 
-int MessageLayout::getLastCharacterIndex() const
+int MessageLayout::getLastCharacterIndex()
 {
+    this->layoutIfReleased();
+
     return this->container_->getLastCharacterIndex();
 }
 
-int MessageLayout::getFirstMessageCharacterIndex() const
+int MessageLayout::getFirstMessageCharacterIndex()
 {
+    this->layoutIfReleased();
+
     return this->container_->getFirstMessageCharacterIndex();
 }
 
 int MessageLayout::getSelectionIndex(QPoint position)
 {
+    this->layoutIfReleased();
+
     return this->container_->getSelectionIndex(position);
 }
 
 void MessageLayout::addSelectionText(QString &str, int from, int to,
                                      CopyMode copymode)
 {
+    this->layoutIfReleased();
+
     this->container_->addSelectionText(str, from, to, copymode);
 }
 
+void MessageLayout::layoutIfReleased()
+{
+    // Never laid out, there's nothing to select yet
+    if (this->currentLayoutWidth_ < 0)
+    {
+        return;
+    }
+
+    if (this->flags.has(MessageLayoutFlag::RequiresLayout))
+    {
+        this->layout(this->currentLayoutWidth_, this->scale_,
+                     this->currentWordFlags_);
+    }
+}
+
 }  // namespace chatterino
@@ -2,19 +2,25 @@
 
 #include "common/Common.hpp"
 #include "common/FlagsEnum.hpp"
+#include "messages/layouts/MessageLayoutCache.hpp"
 
 #include <QPixmap>
 #include <boost/noncopyable.hpp>
 #include <cinttypes>
 #include <memory>
+#include <vector>
 
 namespace chatterino {
 
 struct Message;
 using MessagePtr = std::shared_ptr<const Message>;
 
+enum class MessageFlag : uint32_t;
+using MessageFlags = FlagsEnum<MessageFlag>;
+
 struct Selection;
 struct MessageLayoutContainer;
+struct AnimatedImageArea;
 class MessageLayoutElement;
 
 enum class MessageElementFlag : int64_t;
@@ -37,6 +43,7 @@ public:
     ~MessageLayout();
 
     const Message *getMessage();
+    const MessagePtr &getMessagePtr() const;
 
     int getHeight() const;
 
@@ -51,11 +58,16 @@ public:
     void invalidateBuffer();
     void deleteBuffer();
     void deleteCache();
+    // Appends the animated images of the message painted at y
+    void addAnimatedImageAreas(std::vector<AnimatedImageArea> &areas,
+                               int y) const;
 
     // Elements
+    // These lay out the message again if deleteCache released it, a
+    // selection can span messages that haven't been painted since
     const MessageLayoutElement *getElementAt(QPoint point);
-    int getLastCharacterIndex() const;
-    int getFirstMessageCharacterIndex() const;
+    int getLastCharacterIndex();
+    int getFirstMessageCharacterIndex();
     int getSelectionIndex(QPoint position);
     void addSelectionText(QString &str, int from = 0, int to = INT_MAX,
                           CopyMode copymode = CopyMode::Everything);
@@ -66,7 +78,10 @@ public:
 private:
     // variables
     MessagePtr message_;
+    // Might be shared with other views through MessageLayoutCache, only
+    // modified by actuallyLayout if nobody else uses it
     std::shared_ptr<MessageLayoutContainer> container_;
+    MessageLayoutCache::Key cacheKey_{};
     std::shared_ptr<QPixmap> buffer_{};
     bool bufferValid_ = false;
 
@@ -79,11 +94,13 @@ private:
     unsigned int bufferUpdatedCount_ = 0;
 
     MessageElementFlags currentWordFlags_;
+    MessageFlags currentMessageFlags_;
 
     int collapsedHeight_ = 32;
 
     // methods
     void actuallyLayout(int width, MessageElementFlags flags);
+    void layoutIfReleased();
     void updateBuffer(QPixmap *pixmap, int messageIndex, Selection &selection);
 };
 
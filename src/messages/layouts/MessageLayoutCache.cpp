@@ -0,0 +1,111 @@
+#include "messages/layouts/MessageLayoutCache.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace chatterino {
+
+namespace {
+
+    template <typename T>
+    void hashCombine(size_t &seed, const T &value)
+    {
+        seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+}  // namespace
+
+bool MessageLayoutCache::Key::operator==(const Key &other) const
+{
+    return this->message == other.message && this->width == other.width &&
+           this->scale == other.scale &&
+           this->flags.value() == other.flags.value() &&
+           this->messageFlags.value() == other.messageFlags.value() &&
+           this->generation == other.generation &&
+           this->settingsVersion == other.settingsVersion &&
+           this->expanded == other.expanded;
+}
+
+size_t MessageLayoutCache::KeyHash::operator()(const Key &key) const
+{
+    auto hash = std::hash<const Message *>()(key.message);
+    hashCombine(hash, key.width);
+    hashCombine(hash, key.scale);
+    hashCombine(hash, static_cast<int64_t>(key.flags.value()));
+    hashCombine(hash, static_cast<uint32_t>(key.messageFlags.value()));
+    hashCombine(hash, key.generation);
+    hashCombine(hash, key.settingsVersion);
+    hashCombine(hash, key.expanded);
+    return hash;
+}
+
+MessageLayoutCache &MessageLayoutCache::instance()
+{
+    static MessageLayoutCache instance;
+    return instance;
+}
+
+std::shared_ptr<MessageLayoutContainer> MessageLayoutCache::get(
+    const Key &key) const
+{
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        return nullptr;
+    }
+
+    // A live container is still held by a layout of this message, so the
+    // message can't have been replaced by another one at the same address
+    return it->second.lock();
+}
+
+void MessageLayoutCache::insert(
+    const Key &key, const std::shared_ptr<MessageLayoutContainer> &container)
+{
+    this->entries_[key] = container;
+
+    if (this->entries_.size() >= this->removeExpiredAt_)
+    {
+        this->removeExpired();
+        this->removeExpiredAt_ =
+            std::max<size_t>(1024, this->entries_.size() * 2);
+    }
+}
+
+void MessageLayoutCache::remove(const Key &key,
+                                const MessageLayoutContainer *container)
+{
+    auto it = this->entries_.find(key);
+    if (it == this->entries_.end())
+    {
+        return;
+    }
+
+    auto cached = it->second.lock();
+    if (cached == nullptr || cached.get() == container)
+    {
+        this->entries_.erase(it);
+    }
+}
+
+size_t MessageLayoutCache::size() const
+{
+    return this->entries_.size();
+}
+
+void MessageLayoutCache::removeExpired()
+{
+    for (auto it = this->entries_.begin(); it != this->entries_.end();)
+    {
+        if (it->second.expired())
+        {
+            it = this->entries_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+}  // namespace chatterino
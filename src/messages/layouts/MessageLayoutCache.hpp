@@ -0,0 +1,83 @@
+#pragma once
+
+#include "common/FlagsEnum.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace chatterino {
+
+struct Message;
+struct MessageLayoutContainer;
+
+enum class MessageFlag : uint32_t;
+using MessageFlags = FlagsEnum<MessageFlag>;
+
+enum class MessageElementFlag : int64_t;
+using MessageElementFlags = FlagsEnum<MessageElementFlag>;
+
+/**
+ * @brief Shares laid out messages between channel views
+ *
+ * Splits showing the same channel, and the mentions channel, get the same
+ * messages. Views that lay out a message with the same width, scale and
+ * element flags share one container instead of laying it out again.
+ *
+ * Containers are immutable once they are in the cache. A container that
+ * depends on an image that has loaded since is outdated, callers must not
+ * reuse it (see MessageLayoutContainer::hasLoadedPendingImages). The cache
+ * only holds weak references, a container is dropped once no view uses it
+ * anymore.
+ * Views keep their own buffers, those depend on per-view state like the
+ * alternate background and the selection.
+ *
+ * Must only be used from the GUI thread.
+ **/
+class MessageLayoutCache
+{
+public:
+    struct Key {
+        const Message *message;
+        int width;
+        float scale;
+        MessageElementFlags flags;
+        // Message::flags, a message gets hidden or collapsed differently
+        // once it's disabled
+        MessageFlags messageFlags;
+        // WindowManager::getGeneration, bumped when fonts, the theme or the
+        // word flags change
+        int generation;
+        // SettingsSnapshot::version
+        uint64_t settingsVersion;
+        // Expanded in this view, ignoring MessageFlag::Collapsed
+        bool expanded;
+
+        bool operator==(const Key &other) const;
+    };
+
+    static MessageLayoutCache &instance();
+
+    std::shared_ptr<MessageLayoutContainer> get(const Key &key) const;
+    void insert(const Key &key,
+                const std::shared_ptr<MessageLayoutContainer> &container);
+    // Removes the entry for key if it refers to container. Used before a
+    // container that isn't shared anymore gets laid out again.
+    void remove(const Key &key, const MessageLayoutContainer *container);
+
+    // Number of entries, including ones whose container is gone
+    size_t size() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    void removeExpired();
+
+    std::unordered_map<Key, std::weak_ptr<MessageLayoutContainer>, KeyHash>
+        entries_;
+    size_t removeExpiredAt_ = 1024;
+};
+
+}  // namespace chatterino
@@ -1,20 +1,21 @@
 #include "MessageLayoutContainer.hpp"
 
 #include "Application.hpp"
+#include "messages/Image.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageElement.hpp"
 #include "messages/Selection.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
 #include "singletons/Fonts.hpp"
-#include "singletons/Settings.hpp"
 #include "singletons/Theme.hpp"
 
 #include <QDebug>
 #include <QPainter>
 
+#include <algorithm>
+
 #define COMPACT_EMOTES_OFFSET 4
-#define MAX_UNCOLLAPSED_LINES \
-    (getSettings()->collpseMessagesMinLines.getValue())
+#define MAX_UNCOLLAPSED_LINES (this->settings_->collpseMessagesMinLines)
 
 namespace chatterino {
 
@@ -37,6 +38,7 @@ float MessageLayoutContainer::getScale() const
 void MessageLayoutContainer::begin(int width, float scale, MessageFlags flags)
 {
     this->clear();
+    this->settings_ = getSettingsSnapshot();
     this->width_ = width;
     this->scale_ = scale;
     this->flags_ = flags;
@@ -53,6 +55,9 @@ void MessageLayoutContainer::clear()
 {
     this->elements_.clear();
     this->lines_.clear();
+    this->pendingImages_.clear();
+    this->imageElements_.clear();
+    this->arena_.clear();
 
     this->height_ = 0;
     this->line_ = 0;
@@ -63,6 +68,33 @@ void MessageLayoutContainer::clear()
     this->charIndex_ = 0;
 }
 
+void MessageLayoutContainer::releaseMemory()
+{
+    this->clear();
+
+    this->arena_.release();
+    this->elements_.shrink_to_fit();
+    this->lines_.shrink_to_fit();
+    this->pendingImages_.shrink_to_fit();
+    this->imageElements_.shrink_to_fit();
+}
+
+bool MessageLayoutContainer::hasLoadedPendingImages() const
+{
+    return std::any_of(this->pendingImages_.begin(),
+                       this->pendingImages_.end(), [](const ImagePtr &image) {
+                           return image->loaded();
+                       });
+}
+
+void MessageLayoutContainer::addImageDependency(const ImagePtr &image)
+{
+    if (image && !image->isEmpty() && !image->loaded())
+    {
+        this->pendingImages_.push_back(image);
+    }
+}
+
 void MessageLayoutContainer::addElement(MessageLayoutElement *element)
 {
     bool isZeroWidth =
@@ -92,7 +124,12 @@ void MessageLayoutContainer::_addElement(MessageLayoutElement *element,
 {
     if (!this->canAddElements() && !forceAdd)
     {
-        delete element;
+        // the element is released on the next clear
+        if (!this->imageElements_.empty() &&
+            this->imageElements_.back() == element)
+        {
+            this->imageElements_.pop_back();
+        }
         return;
     }
 
@@ -137,7 +174,7 @@ void MessageLayoutContainer::_addElement(MessageLayoutElement *element,
 
     // compact emote offset
     bool isCompactEmote =
-        getSettings()->compactEmotes &&
+        this->settings_->compactEmotes &&
         !this->flags_.has(MessageFlag::DisableCompactEmotes) &&
         element->getCreator().getFlags().has(MessageElementFlag::EmoteImages);
 
@@ -168,7 +205,7 @@ void MessageLayoutContainer::_addElement(MessageLayoutElement *element,
         yOffset -= (this->margin.top * this->scale_);
     }
 
-    if (getSettings()->removeSpacesBetweenEmotes &&
+    if (this->settings_->removeSpacesBetweenEmotes &&
         element->getFlags().hasAny({MessageElementFlag::EmoteImages}) &&
         !isZeroWidthEmote && shouldRemoveSpaceBetweenEmotes())
     {
@@ -184,7 +221,7 @@ void MessageLayoutContainer::_addElement(MessageLayoutElement *element,
     element->setLine(this->line_);
 
     // add element
-    this->elements_.push_back(std::unique_ptr<MessageLayoutElement>(element));
+    this->elements_.push_back(element);
 
     // set current x
     if (!isZeroWidthEmote)
@@ -215,10 +252,10 @@ void MessageLayoutContainer::breakLine()
 
     for (size_t i = lineStart_; i < this->elements_.size(); i++)
     {
-        MessageLayoutElement *element = this->elements_.at(i).get();
+        MessageLayoutElement *element = this->elements_.at(i);
 
         bool isCompactEmote =
-            getSettings()->compactEmotes &&
+            this->settings_->compactEmotes &&
             !this->flags_.has(MessageFlag::DisableCompactEmotes) &&
             element->getCreator().getFlags().has(
                 MessageElementFlag::EmoteImages);
@@ -296,7 +333,7 @@ void MessageLayoutContainer::end()
                                      MessageColor::Link);
         static QString dotdotdotText("...");
 
-        auto *element = new TextLayoutElement(
+        auto *element = this->createElement<TextLayoutElement>(
             dotdotdot, dotdotdotText,
             QSize(this->dotdotdotWidth_, this->textLineHeight_),
             QColor("#00D80A"), FontStyle::ChatMediumBold, this->scale_);
@@ -324,7 +361,7 @@ void MessageLayoutContainer::end()
 
 bool MessageLayoutContainer::canCollapse()
 {
-    return getSettings()->collpseMessagesMinLines.getValue() > 0 &&
+    return this->settings_->collpseMessagesMinLines > 0 &&
            this->flags_.has(MessageFlag::Collapsed);
 }
 
@@ -335,11 +372,11 @@ bool MessageLayoutContainer::isCollapsed()
 
 MessageLayoutElement *MessageLayoutContainer::getElementAt(QPoint point)
 {
-    for (std::unique_ptr<MessageLayoutElement> &element : this->elements_)
+    for (auto *element : this->elements_)
     {
         if (element->getRect().contains(point))
         {
-            return element.get();
+            return element;
         }
     }
 
@@ -349,26 +386,41 @@ MessageLayoutElement *MessageLayoutContainer::getElementAt(QPoint point)
 // painting
 void MessageLayoutContainer::paintElements(QPainter &painter)
 {
-    for (const std::unique_ptr<MessageLayoutElement> &element : this->elements_)
+    for (auto *element : this->elements_)
     {
 #ifdef FOURTF
         painter.setPen(QColor(0, 255, 0));
         painter.drawRect(element->getRect());
 #endif
 
-        element->paint(painter);
+        element->paint(painter, *this->settings_);
     }
 }
 
 void MessageLayoutContainer::paintAnimatedElements(QPainter &painter,
                                                    int yOffset)
 {
-    for (const std::unique_ptr<MessageLayoutElement> &element : this->elements_)
+    for (auto *element : this->elements_)
     {
         element->paintAnimated(painter, yOffset);
     }
 }
 
+void MessageLayoutContainer::addAnimatedImageAreas(
+    std::vector<AnimatedImageArea> &areas, int yOffset) const
+{
+    for (auto *element : this->imageElements_)
+    {
+        const auto &image = element->getImage();
+        if (image != nullptr && image->animated())
+        {
+            auto rect = element->getRect();
+            rect.moveTop(rect.y() + yOffset);
+            areas.push_back({rect, image, image->frameIndex()});
+        }
+    }
+}
+
 void MessageLayoutContainer::paintSelection(QPainter &painter, int messageIndex,
                                             Selection &selection, int yOffset)
 {
@@ -589,7 +641,7 @@ int MessageLayoutContainer::getSelectionIndex(QPoint point)
 
     for (int i = 0; i < lineEnd; i++)
     {
-        auto &&element = this->elements_[i];
+        auto *element = this->elements_[i];
 
         // end of line
         if (i == lineEnd)
@@ -639,7 +691,7 @@ int MessageLayoutContainer::getFirstMessageCharacterIndex() const
     // Get the index of the first character of the real message
     // (no badges/timestamps/username)
     int index = 0;
-    for (auto &element : this->elements_)
+    for (auto *element : this->elements_)
     {
         if (element->getFlags().hasAny(flags))
         {
@@ -659,7 +711,7 @@ void MessageLayoutContainer::addSelectionText(QString &str, int from, int to,
     int index = 0;
     bool first = true;
 
-    for (auto &element : this->elements_)
+    for (auto *element : this->elements_)
     {
         if (copymode == CopyMode::OnlyTextAndEmotes)
         {
@@ -9,6 +9,8 @@
 #include "common/FlagsEnum.hpp"
 #include "messages/Selection.hpp"
 #include "messages/layouts/MessageLayoutElement.hpp"
+#include "singletons/SettingsSnapshot.hpp"
+#include "util/MonotonicArena.hpp"
 
 class QPainter;
 
@@ -17,6 +19,14 @@ namespace chatterino {
 enum class MessageFlag : uint32_t;
 using MessageFlags = FlagsEnum<MessageFlag>;
 
+// An animated image painted by a view
+struct AnimatedImageArea {
+    QRect rect;
+    ImagePtr image;
+    // The frame that is currently shown
+    int frameIndex;
+};
+
 struct Margin {
     int top;
     int right;
@@ -58,7 +68,30 @@ struct MessageLayoutContainer {
     void end();
 
     void clear();
+    // Like clear, but also frees the memory kept around for the next layout
+    void releaseMemory();
     bool canAddElements();
+
+    // Creates a layout element that is owned by this container. It stays
+    // alive until the next clear(), even if it doesn't get added.
+    template <typename T, typename... Args>
+    // clang-format off
+    // clang-format can be enabled once clang-format v11+ has been installed in CI
+    T *createElement(Args &&...args)
+    // clang-format on
+    {
+        static_assert(std::is_base_of<MessageLayoutElement, T>::value,
+                      "T must extend MessageLayoutElement");
+
+        auto *element = this->arena_.create<T>(std::forward<Args>(args)...);
+        if constexpr (std::is_base_of<ImageLayoutElement, T>::value)
+        {
+            this->addImageDependency(element->getImage());
+            this->imageElements_.push_back(element);
+        }
+        return element;
+    }
+
     void addElement(MessageLayoutElement *element);
     void addElementNoLineBreak(MessageLayoutElement *element);
     void breakLine();
@@ -69,6 +102,9 @@ struct MessageLayoutContainer {
     // painting
     void paintElements(QPainter &painter);
     void paintAnimatedElements(QPainter &painter, int yOffset);
+    // Appends the animated images with their rectangles moved by yOffset
+    void addAnimatedImageAreas(std::vector<AnimatedImageArea> &areas,
+                               int yOffset) const;
     void paintSelection(QPainter &painter, int messageIndex,
                         Selection &selection, int yOffset);
 
@@ -80,6 +116,11 @@ struct MessageLayoutContainer {
 
     bool isCollapsed();
 
+    // Images that weren't loaded during the layout get a placeholder size.
+    // Returns true if one of them has loaded since, then the layout is
+    // outdated.
+    bool hasLoadedPendingImages() const;
+
 private:
     struct Line {
         int startIndex;
@@ -91,6 +132,7 @@ private:
 
     // helpers
     void _addElement(MessageLayoutElement *element, bool forceAdd = false);
+    void addImageDependency(const ImagePtr &image);
     bool canCollapse();
 
     // variables
@@ -110,8 +152,16 @@ private:
     bool canAddMessages_ = true;
     bool isCollapsed_ = false;
 
-    std::vector<std::unique_ptr<MessageLayoutElement>> elements_;
+    // Grabbed in begin() and used for the whole layout pass
+    SettingsSnapshotPtr settings_;
+
+    // Owns all elements, so a relayout doesn't allocate once warmed up
+    MonotonicArena arena_{4096};
+    std::vector<MessageLayoutElement *> elements_;
     std::vector<Line> lines_;
+    std::vector<ImagePtr> pendingImages_;
+    // The ImageLayoutElements in elements_
+    std::vector<ImageLayoutElement *> imageElements_;
 };
 
 }  // namespace chatterino
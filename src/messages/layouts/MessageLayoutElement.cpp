@@ -4,7 +4,10 @@
 #include "messages/Emote.hpp"
 #include "messages/Image.hpp"
 #include "messages/MessageElement.hpp"
+#include "messages/layouts/TextRunCache.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
+#include "singletons/Fonts.hpp"
+#include "singletons/SettingsSnapshot.hpp"
 #include "singletons/Theme.hpp"
 #include "util/DebugCount.hpp"
 
@@ -102,6 +105,11 @@ ImageLayoutElement::ImageLayoutElement(MessageElement &creator, ImagePtr image,
     this->trailingSpace = creator.hasTrailingSpace();
 }
 
+const ImagePtr &ImageLayoutElement::getImage() const
+{
+    return this->image_;
+}
+
 void ImageLayoutElement::addCopyTextToString(QString &str, int from,
                                              int to) const
 {
@@ -123,7 +131,7 @@ int ImageLayoutElement::getSelectionIndexCount() const
     return this->trailingSpace ? 2 : 1;
 }
 
-void ImageLayoutElement::paint(QPainter &painter)
+void ImageLayoutElement::paint(QPainter &painter, const SettingsSnapshot &)
 {
     if (this->image_ == nullptr)
     {
@@ -188,7 +196,8 @@ ImageWithBackgroundLayoutElement::ImageWithBackgroundLayoutElement(
 {
 }
 
-void ImageWithBackgroundLayoutElement::paint(QPainter &painter)
+void ImageWithBackgroundLayoutElement::paint(QPainter &painter,
+                                             const SettingsSnapshot &)
 {
     if (this->image_ == nullptr)
     {
@@ -244,13 +253,29 @@ int TextLayoutElement::getSelectionIndexCount() const
     return this->getText().length() + (this->trailingSpace ? 1 : 0);
 }
 
-void TextLayoutElement::paint(QPainter &painter)
+void TextLayoutElement::paint(QPainter &painter,
+                              const SettingsSnapshot &settings)
 {
     auto app = getApp();
 
     painter.setPen(this->color_);
 
-    painter.setFont(app->fonts->getFont(this->style_, this->scale_));
+    auto font = app->fonts->getFont(this->style_, this->scale_);
+    painter.setFont(font);
+
+    if (settings.cacheTextRuns)
+    {
+        auto *run = TextRunCache::instance().get(
+            {this->getText(), this->style_, this->scale_,
+             app->fonts->getGeneration()},
+            font);
+
+        if (run != nullptr)
+        {
+            painter.drawStaticText(this->getRect().topLeft(), *run);
+            return;
+        }
+    }
 
     painter.drawText(
         QRectF(this->getRect().x(), this->getRect().y(), 10000, 10000),
@@ -347,7 +372,7 @@ int TextIconLayoutElement::getSelectionIndexCount() const
     return this->trailingSpace ? 2 : 1;
 }
 
-void TextIconLayoutElement::paint(QPainter &painter)
+void TextIconLayoutElement::paint(QPainter &painter, const SettingsSnapshot &)
 {
     auto app = getApp();
 
@@ -20,6 +20,7 @@ class MessageElement;
 class Image;
 using ImagePtr = std::shared_ptr<Image>;
 enum class FontStyle : uint8_t;
+struct SettingsSnapshot;
 
 class MessageLayoutElement : boost::noncopyable
 {
@@ -41,7 +42,8 @@ public:
     virtual void addCopyTextToString(QString &str, int from = 0,
                                      int to = INT_MAX) const = 0;
     virtual int getSelectionIndexCount() const = 0;
-    virtual void paint(QPainter &painter) = 0;
+    virtual void paint(QPainter &painter,
+                       const SettingsSnapshot &settings) = 0;
     virtual void paintAnimated(QPainter &painter, int yOffset) = 0;
     virtual int getMouseOverIndex(const QPoint &abs) const = 0;
     virtual int getXFromIndex(int index) = 0;
@@ -68,11 +70,13 @@ public:
     ImageLayoutElement(MessageElement &creator, ImagePtr image,
                        const QSize &size);
 
+    const ImagePtr &getImage() const;
+
 protected:
     void addCopyTextToString(QString &str, int from = 0,
                              int to = INT_MAX) const override;
     int getSelectionIndexCount() const override;
-    void paint(QPainter &painter) override;
+    void paint(QPainter &painter, const SettingsSnapshot &settings) override;
     void paintAnimated(QPainter &painter, int yOffset) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(int index) override;
@@ -87,7 +91,7 @@ public:
                                      const QSize &size, QColor color);
 
 protected:
-    void paint(QPainter &painter) override;
+    void paint(QPainter &painter, const SettingsSnapshot &settings) override;
 
 private:
     QColor color_;
@@ -107,7 +111,7 @@ protected:
     void addCopyTextToString(QString &str, int from = 0,
                              int to = INT_MAX) const override;
     int getSelectionIndexCount() const override;
-    void paint(QPainter &painter) override;
+    void paint(QPainter &painter, const SettingsSnapshot &settings) override;
     void paintAnimated(QPainter &painter, int yOffset) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(int index) override;
@@ -131,7 +135,7 @@ protected:
     void addCopyTextToString(QString &str, int from = 0,
                              int to = INT_MAX) const override;
     int getSelectionIndexCount() const override;
-    void paint(QPainter &painter) override;
+    void paint(QPainter &painter, const SettingsSnapshot &settings) override;
     void paintAnimated(QPainter &painter, int yOffset) override;
     int getMouseOverIndex(const QPoint &abs) const override;
     int getXFromIndex(int index) override;
@@ -0,0 +1,135 @@
+#include "messages/layouts/TextRunCache.hpp"
+
+#include "singletons/Fonts.hpp"
+
+#include <QHash>
+#include <QTransform>
+
+#include <functional>
+
+namespace chatterino {
+
+namespace {
+
+    template <typename T>
+    void hashCombine(size_t &seed, const T &value)
+    {
+        seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+
+    // Rough estimates, QStaticText keeps a glyph index and a position per
+    // character
+    constexpr size_t entryBytes = 128;
+    constexpr size_t preparedBytes = 256;
+    constexpr size_t bytesPerGlyph = 16;
+
+    size_t estimateBytes(const QString &text, bool prepared)
+    {
+        auto bytes = entryBytes + size_t(text.size()) * sizeof(QChar);
+        if (prepared)
+        {
+            bytes += preparedBytes + size_t(text.size()) * bytesPerGlyph;
+        }
+        return bytes;
+    }
+
+}  // namespace
+
+bool TextRunCache::Key::operator==(const Key &other) const
+{
+    return this->style == other.style && this->scale == other.scale &&
+           this->generation == other.generation && this->text == other.text;
+}
+
+size_t TextRunCache::KeyHash::operator()(const Key &key) const
+{
+    size_t hash = qHash(key.text);
+    hashCombine(hash, static_cast<uint8_t>(key.style));
+    hashCombine(hash, key.scale);
+    hashCombine(hash, key.generation);
+    return hash;
+}
+
+TextRunCache &TextRunCache::instance()
+{
+    static TextRunCache instance;
+    return instance;
+}
+
+TextRunCache::TextRunCache(size_t maxBytes)
+    : maxBytes_(maxBytes)
+{
+}
+
+const QStaticText *TextRunCache::get(const Key &key, const QFont &font)
+{
+    if (key.text.size() > maxLength || this->maxBytes_ == 0)
+    {
+        return nullptr;
+    }
+
+    auto it = this->index_.find(key);
+    if (it == this->index_.end())
+    {
+        // First time we see this run, remember it but draw it directly
+        Entry entry;
+        entry.key = key;
+        entry.bytes = estimateBytes(key.text, false);
+
+        this->usedBytes_ += entry.bytes;
+        this->entries_.push_front(std::move(entry));
+        this->index_.emplace(key, this->entries_.begin());
+        this->evict();
+
+        return nullptr;
+    }
+
+    auto entry = it->second;
+    this->entries_.splice(this->entries_.begin(), this->entries_, entry);
+
+    if (!entry->prepared)
+    {
+        entry->text.setText(key.text);
+        entry->text.setTextFormat(Qt::PlainText);
+        entry->text.prepare(QTransform(), font);
+        entry->prepared = true;
+
+        auto bytes = estimateBytes(key.text, true);
+        this->usedBytes_ += bytes - entry->bytes;
+        entry->bytes = bytes;
+        this->evict();
+    }
+
+    return &entry->text;
+}
+
+void TextRunCache::clear()
+{
+    this->entries_.clear();
+    this->index_.clear();
+    this->usedBytes_ = 0;
+}
+
+size_t TextRunCache::size() const
+{
+    return this->entries_.size();
+}
+
+size_t TextRunCache::usedBytes() const
+{
+    return this->usedBytes_;
+}
+
+void TextRunCache::evict()
+{
+    // The most recently used entry always stays, it's about to be painted
+    while (this->usedBytes_ > this->maxBytes_ && this->entries_.size() > 1)
+    {
+        auto &last = this->entries_.back();
+        this->usedBytes_ -= last.bytes;
+        this->index_.erase(last.key);
+        this->entries_.pop_back();
+    }
+}
+
+}  // namespace chatterino
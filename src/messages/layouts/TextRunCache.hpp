@@ -0,0 +1,84 @@
+#pragma once
+
+#include <QFont>
+#include <QStaticText>
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+namespace chatterino {
+
+enum class FontStyle : uint8_t;
+
+/**
+ * @brief Keeps short, frequently painted text runs shaped between messages
+ *
+ * Painting a message buffer lays out every word again, even though most
+ * words (emote names, usernames, timestamps, "@mod") show up in thousands
+ * of messages. This cache keeps a prepared QStaticText for these runs, so
+ * painting them only draws the glyphs.
+ *
+ * Runs are only prepared the second time they are painted, words that only
+ * show up once are drawn directly. Entries are evicted least recently used
+ * first once their estimated size exceeds the memory budget. The color isn't
+ * part of the key, QStaticText is painted with the painter's pen.
+ *
+ * Must only be used from the GUI thread.
+ **/
+class TextRunCache
+{
+public:
+    struct Key {
+        QString text;
+        FontStyle style;
+        float scale;
+        // Fonts::getGeneration
+        int generation;
+
+        bool operator==(const Key &other) const;
+    };
+
+    /// Longest run that gets cached
+    static constexpr int maxLength = 32;
+    static constexpr size_t defaultMaxBytes = 4 * 1024 * 1024;
+
+    static TextRunCache &instance();
+
+    explicit TextRunCache(size_t maxBytes = defaultMaxBytes);
+
+    // Returns the run prepared with font, or nullptr if it should be drawn
+    // directly. The pointer is valid until the next call.
+    const QStaticText *get(const Key &key, const QFont &font);
+
+    void clear();
+
+    // Number of entries, including runs that haven't been prepared yet
+    size_t size() const;
+    // Estimated memory used by all entries
+    size_t usedBytes() const;
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key &key) const;
+    };
+
+    struct Entry {
+        Key key;
+        QStaticText text;
+        bool prepared = false;
+        size_t bytes = 0;
+    };
+
+    void evict();
+
+    size_t maxBytes_;
+    size_t usedBytes_ = 0;
+    // Most recently used first
+    std::list<Entry> entries_;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index_;
+};
+
+}  // namespace chatterino
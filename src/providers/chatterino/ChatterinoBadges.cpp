@@ -8,6 +8,7 @@
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
 #include "messages/Emote.hpp"
+#include "providers/twitch/UserDecorationCache.hpp"
 
 namespace chatterino {
 void ChatterinoBadges::initialize(Settings &settings, Paths &paths)
@@ -63,6 +64,8 @@ void ChatterinoBadges::loadChatterinoBadges()
                 ++index;
             }
 
+            UserDecorationCache::invalidate();
+
             return Success;
         })
         .execute();
@@ -10,6 +10,7 @@
 #include "common/NetworkRequest.hpp"
 #include "common/Outcome.hpp"
 #include "messages/Emote.hpp"
+#include "providers/twitch/UserDecorationCache.hpp"
 
 namespace chatterino {
 
@@ -86,6 +87,8 @@ void FfzBadges::loadFfzBadges()
                 ++index;
             }
 
+            UserDecorationCache::invalidate();
+
             return Success;
         })
         .execute();
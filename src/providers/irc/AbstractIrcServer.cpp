@@ -1,13 +1,19 @@
 #include "AbstractIrcServer.hpp"
 
+#include "Application.hpp"
 #include "common/Channel.hpp"
 #include "common/Common.hpp"
 #include "common/QLogging.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
+#include "singletons/WindowManager.hpp"
+#include "util/ConsistentHash.hpp"
 
 #include <QCoreApplication>
+#include <QDateTime>
+
+#include <algorithm>
 
 namespace chatterino {
 
@@ -15,7 +21,7 @@ const int RECONNECT_BASE_INTERVAL = 2000;
 // 60 falloff counter means it will try to reconnect at most every 60*2 seconds
 const int MAX_FALLOFF_COUNTER = 60;
 
-// Ratelimits for joinBucket_
+// Ratelimits for joinScheduler_
 const int JOIN_RATELIMIT_BUDGET = 18;
 const int JOIN_RATELIMIT_COOLDOWN = 12500;
 
@@ -27,16 +33,20 @@ AbstractIrcServer::AbstractIrcServer()
     this->writeConnection_->moveToThread(
         QCoreApplication::instance()->thread());
 
-    // Apply a leaky bucket rate limiting to JOIN messages
-    auto actuallyJoin = [&](QString message) {
-        if (!this->channels.contains(message))
-        {
-            return;
-        }
-        this->readConnection_->sendRaw("JOIN #" + message);
-    };
-    this->joinBucket_.reset(new RatelimitBucket(
-        JOIN_RATELIMIT_BUDGET, JOIN_RATELIMIT_COOLDOWN, actuallyJoin, this));
+    // Apply a leaky bucket rate limiting to JOIN messages, joining the
+    // channels the user is looking at first
+    this->joinScheduler_.reset(new JoinScheduler(
+        JOIN_RATELIMIT_BUDGET, JOIN_RATELIMIT_COOLDOWN,
+        [this](const QString &line, int connection) {
+            this->readConnections_[connection].connection->sendRaw(line);
+        },
+        [](const QString &channelName) {
+            return getApp()->windows->getChannelJoinPriority(channelName);
+        },
+        this,
+        [this](const QString &channelName) {
+            return this->readConnectionIndex(channelName);
+        }));
 
     QObject::connect(this->writeConnection_.get(),
                      &Communi::IrcConnection::messageReceived, this,
@@ -53,59 +63,93 @@ AbstractIrcServer::AbstractIrcServer()
                 << "Write connection reconnect requested. Timeout:" << timeout;
             this->writeConnection_->smartReconnect.invoke();
         });
+}
 
-    // Listen to read connection message signals
-    this->readConnection_.reset(new IrcConnection);
-    this->readConnection_->moveToThread(QCoreApplication::instance()->thread());
+void AbstractIrcServer::initReadConnection(int index)
+{
+    auto *connection = new IrcConnection;
+    connection->moveToThread(QCoreApplication::instance()->thread());
+    this->readConnections_[index].connection.reset(connection);
 
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::messageReceived, this,
-                     [this](auto msg) {
+    // Listen to read connection message signals
+    QObject::connect(connection, &Communi::IrcConnection::messageReceived,
+                     this, [this, index](auto msg) {
+                         this->recordReadMessage(index, msg);
+                         if (index != 0 && this->isAccountWideMessage(msg))
+                         {
+                             return;
+                         }
                          this->readConnectionMessageReceived(msg);
                      });
-    QObject::connect(this->readConnection_.get(),
+    QObject::connect(connection,
                      &Communi::IrcConnection::privateMessageReceived, this,
                      [this](auto msg) {
                          this->privateMessageReceived(msg);
                      });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::connected, this, [this] {
-                         this->onReadConnected(this->readConnection_.get());
+    QObject::connect(connection, &Communi::IrcConnection::connected, this,
+                     [this, connection] {
+                         this->onReadConnected(connection);
                      });
-    QObject::connect(this->readConnection_.get(),
-                     &Communi::IrcConnection::disconnected, this, [this] {
-                         this->onDisconnected();
+    QObject::connect(connection, &Communi::IrcConnection::disconnected, this,
+                     [this, connection] {
+                         this->onDisconnected(connection);
                      });
+    // Every connection has its own reconnect backoff, so one connection
+    // timing out doesn't affect the others
     this->connections_.managedConnect(
-        this->readConnection_->connectionLost, [this](bool timeout) {
-            qCDebug(chatterinoIrc)
-                << "Read connection reconnect requested. Timeout:" << timeout;
+        connection->connectionLost, [this, index](bool timeout) {
+            qCDebug(chatterinoIrc) << "Read connection" << index
+                                   << "reconnect requested. Timeout:"
+                                   << timeout;
+
+            auto &read = this->readConnections_[index];
+            read.reconnects++;
+
             if (timeout)
             {
                 // Show additional message since this is going to interrupt a
                 // connection that is still "connected"
-                this->addGlobalSystemMessage(
-                    "Server connection timed out, reconnecting");
+                std::lock_guard<std::mutex> lock(this->channelMutex);
+                this->addReadConnectionMessage(
+                    index, makeSystemMessage(
+                               "Server connection timed out, reconnecting"));
             }
-            this->readConnection_->smartReconnect.invoke();
+            read.connection->smartReconnect.invoke();
         });
 }
 
+AbstractIrcServer::ConnectionType AbstractIrcServer::readConnectionType(
+    int index) const
+{
+    if (index == 0 && !this->hasSeparateWriteConnection())
+    {
+        return Both;
+    }
+
+    return Read;
+}
+
 void AbstractIrcServer::initializeIrc()
 {
     assert(!this->initialized_);
 
+    auto count = std::max(1, this->readConnectionCount());
+    this->readConnections_.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        this->initReadConnection(i);
+    }
+
     if (this->hasSeparateWriteConnection())
     {
         this->initializeConnectionSignals(this->writeConnection_.get(),
                                           ConnectionType::Write);
-        this->initializeConnectionSignals(this->readConnection_.get(),
-                                          ConnectionType::Read);
     }
-    else
+    for (int i = 0; i < count; i++)
     {
-        this->initializeConnectionSignals(this->readConnection_.get(),
-                                          ConnectionType::Both);
+        this->initializeConnectionSignals(
+            this->readConnections_[i].connection.get(),
+            this->readConnectionType(i));
     }
 
     this->initialized_ = true;
@@ -120,26 +164,121 @@ void AbstractIrcServer::connect()
     if (this->hasSeparateWriteConnection())
     {
         this->initializeConnection(this->writeConnection_.get(), Write);
-        this->initializeConnection(this->readConnection_.get(), Read);
     }
-    else
+    for (int i = 0; i < int(this->readConnections_.size()); i++)
     {
-        this->initializeConnection(this->readConnection_.get(), Both);
+        this->initializeConnection(this->readConnections_[i].connection.get(),
+                                   this->readConnectionType(i));
     }
 }
 
-void AbstractIrcServer::open(ConnectionType type)
+void AbstractIrcServer::open(IrcConnection *connection)
 {
     std::lock_guard<std::mutex> lock(this->connectionMutex_);
 
-    if (type == Write)
+    connection->open();
+}
+
+void AbstractIrcServer::reconnectReadConnection(
+    Communi::IrcConnection *connection, const QString &reason)
+{
+    auto index = this->readConnectionIndex(connection);
+    if (index == -1)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->channelMutex);
+        this->addReadConnectionMessage(index, makeSystemMessage(reason));
+    }
+
+    auto *read = this->readConnections_[index].connection.get();
+    {
+        std::lock_guard<std::mutex> lock(this->connectionMutex_);
+        read->close();
+    }
+    this->initializeConnection(read, this->readConnectionType(index));
+}
+
+int AbstractIrcServer::readConnectionIndex(const QString &channelName) const
+{
+    return consistentShard(channelName, int(this->readConnections_.size()));
+}
+
+int AbstractIrcServer::readConnectionIndex(
+    Communi::IrcConnection *connection) const
+{
+    for (int i = 0; i < int(this->readConnections_.size()); i++)
+    {
+        if (this->readConnections_[i].connection.get() == connection)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void AbstractIrcServer::recordReadMessage(int index,
+                                          Communi::IrcMessage *message)
+{
+    auto &read = this->readConnections_[index];
+    read.messagesReceived++;
+
+    // Twitch tags messages with the time they were sent at
+    auto sentAt = message->tags().value("tmi-sent-ts");
+    if (!sentAt.isValid())
+    {
+        return;
+    }
+
+    auto lag = int(std::max<qint64>(
+        0, QDateTime::currentMSecsSinceEpoch() - sentAt.toLongLong()));
+    read.lagMs = read.lagMs < 0 ? lag : (read.lagMs * 7 + lag) / 8;
+}
+
+void AbstractIrcServer::addReadConnectionMessage(int index,
+                                                 const MessagePtr &message)
+{
+    for (auto it = this->channels.begin(); it != this->channels.end(); ++it)
+    {
+        if (this->readConnectionIndex(it.key()) != index)
+        {
+            continue;
+        }
+
+        if (auto chan = it.value().lock())
+        {
+            chan->addMessage(message);
+        }
+    }
+}
+
+std::vector<AbstractIrcServer::ReadConnectionStats>
+    AbstractIrcServer::getReadConnectionStats()
+{
+    std::vector<ReadConnectionStats> stats(this->readConnections_.size());
+
+    for (size_t i = 0; i < stats.size(); i++)
     {
-        this->writeConnection_->open();
+        const auto &read = this->readConnections_[i];
+        stats[i].connected = read.connection->isConnected();
+        stats[i].messagesReceived = read.messagesReceived;
+        stats[i].reconnects = read.reconnects;
+        stats[i].lagMs = read.lagMs;
     }
-    if (type & Read)
+
+    std::lock_guard<std::mutex> lock(this->channelMutex);
+    for (auto it = this->channels.begin(); it != this->channels.end(); ++it)
     {
-        this->readConnection_->open();
+        if (!it.value().expired())
+        {
+            stats[this->readConnectionIndex(it.key())].channelCount++;
+        }
     }
+
+    return stats;
 }
 
 void AbstractIrcServer::addGlobalSystemMessage(const QString &messageText)
@@ -165,7 +304,10 @@ void AbstractIrcServer::disconnect()
 {
     std::lock_guard<std::mutex> locker(this->connectionMutex_);
 
-    this->readConnection_->close();
+    for (auto &read : this->readConnections_)
+    {
+        read.connection->close();
+    }
     if (this->hasSeparateWriteConnection())
     {
         this->writeConnection_->close();
@@ -188,7 +330,7 @@ void AbstractIrcServer::sendRawMessage(const QString &rawMessage)
     }
     else
     {
-        this->readConnection_->sendRaw(rawMessage);
+        this->readConnections_.front().connection->sendRaw(rawMessage);
     }
 }
 
@@ -225,23 +367,22 @@ ChannelPtr AbstractIrcServer::getOrAddChannel(const QString &dirtyChannelName)
         qCDebug(chatterinoIrc) << "[AbstractIrcServer::addChannel]"
                                << channelName << "was destroyed";
         this->channels.remove(channelName);
+        this->joinScheduler_->cancel(channelName);
 
-        if (this->readConnection_)
-        {
-            this->readConnection_->sendRaw("PART #" + channelName);
-        }
+        auto &read =
+            this->readConnections_[this->readConnectionIndex(channelName)];
+        read.connection->sendRaw("PART #" + channelName);
     });
 
     // join IRC channel
     {
         std::lock_guard<std::mutex> lock2(this->connectionMutex_);
 
-        if (this->readConnection_)
+        auto &read =
+            this->readConnections_[this->readConnectionIndex(channelName)];
+        if (read.connection->isConnected())
         {
-            if (this->readConnection_->isConnected())
-            {
-                this->joinBucket_->send(channelName);
-            }
+            this->joinScheduler_->join(channelName);
         }
     }
 
@@ -291,33 +432,32 @@ std::vector<std::weak_ptr<Channel>> AbstractIrcServer::getChannels()
 
 void AbstractIrcServer::onReadConnected(IrcConnection *connection)
 {
-    (void)connection;
+    auto index = this->readConnectionIndex(connection);
 
     std::lock_guard lock(this->channelMutex);
 
-    // join channels
-    for (auto &&weak : this->channels)
-    {
-        if (auto channel = weak.lock())
-        {
-            this->joinBucket_->send(channel->getName());
-        }
-    }
-
     // connected/disconnected message
     auto connectedMsg = makeSystemMessage("connected");
     connectedMsg->flags.set(MessageFlag::ConnectedMessage);
     auto reconnected = makeSystemMessage("reconnected");
     reconnected->flags.set(MessageFlag::ConnectedMessage);
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values())
+    // Only the channels of this connection need to be joined again
+    for (auto it = this->channels.begin(); it != this->channels.end(); ++it)
     {
-        std::shared_ptr<Channel> chan = weak.lock();
+        if (this->readConnectionIndex(it.key()) != index)
+        {
+            continue;
+        }
+
+        std::shared_ptr<Channel> chan = it.value().lock();
         if (!chan)
         {
             continue;
         }
 
+        this->joinScheduler_->join(chan->getName());
+
         LimitedQueueSnapshot<MessagePtr> snapshot = chan->getMessageSnapshot();
 
         bool replaceMessage =
@@ -341,24 +481,24 @@ void AbstractIrcServer::onWriteConnected(IrcConnection *connection)
     (void)connection;
 }
 
-void AbstractIrcServer::onDisconnected()
+void AbstractIrcServer::onDisconnected(IrcConnection *connection)
 {
-    std::lock_guard<std::mutex> lock(this->channelMutex);
+    auto index = this->readConnectionIndex(connection);
 
-    MessageBuilder b(systemMessage, "disconnected");
-    b->flags.set(MessageFlag::DisconnectedMessage);
-    auto disconnectedMsg = b.release();
+    std::lock_guard<std::mutex> lock(this->channelMutex);
 
-    for (std::weak_ptr<Channel> &weak : this->channels.values())
+    // The channels of this connection are joined again once it's reconnected
+    for (auto it = this->channels.begin(); it != this->channels.end(); ++it)
     {
-        std::shared_ptr<Channel> chan = weak.lock();
-        if (!chan)
+        if (this->readConnectionIndex(it.key()) == index)
         {
-            continue;
+            this->joinScheduler_->cancel(it.key());
         }
-
-        chan->addMessage(disconnectedMsg);
     }
+
+    MessageBuilder b(systemMessage, "disconnected");
+    b->flags.set(MessageFlag::DisconnectedMessage);
+    this->addReadConnectionMessage(index, b.release());
 }
 
 std::shared_ptr<Channel> AbstractIrcServer::getCustomChannel(
@@ -379,7 +519,7 @@ QString AbstractIrcServer::cleanChannelName(const QString &dirtyChannelName)
 void AbstractIrcServer::addFakeMessage(const QString &data)
 {
     auto fakeMessage = Communi::IrcMessage::fromData(
-        data.toUtf8(), this->readConnection_.get());
+        data.toUtf8(), this->readConnections_.front().connection.get());
 
     if (fakeMessage->command() == "PRIVMSG")
     {
@@ -3,12 +3,13 @@
 #include <IrcMessage>
 #include <functional>
 #include <mutex>
+#include <vector>
 #include <pajlada/signals/signal.hpp>
 #include <pajlada/signals/signalholder.hpp>
 
 #include "common/Common.hpp"
 #include "providers/irc/IrcConnection2.hpp"
-#include "util/RatelimitBucket.hpp"
+#include "providers/irc/JoinScheduler.hpp"
 
 namespace chatterino {
 
@@ -49,6 +50,19 @@ public:
     // iteration
     void forEachChannel(std::function<void(ChannelPtr)> func);
 
+    struct ReadConnectionStats {
+        bool connected = false;
+        int channelCount = 0;
+        uint64_t messagesReceived = 0;
+        int reconnects = 0;
+        // Smoothed delay between the server sending a message and us
+        // receiving it, -1 if the server doesn't tell us when it was sent
+        int lagMs = -1;
+    };
+
+    // One entry per read connection
+    std::vector<ReadConnectionStats> getReadConnectionStats();
+
 protected:
     AbstractIrcServer();
 
@@ -70,7 +84,7 @@ protected:
 
     virtual void onReadConnected(IrcConnection *connection);
     virtual void onWriteConnected(IrcConnection *connection);
-    virtual void onDisconnected();
+    virtual void onDisconnected(IrcConnection *connection);
 
     virtual std::shared_ptr<Channel> getCustomChannel(
         const QString &channelName);
@@ -78,20 +92,64 @@ protected:
     virtual bool hasSeparateWriteConnection() const = 0;
     virtual QString cleanChannelName(const QString &dirtyChannelName);
 
-    void open(ConnectionType type);
+    // Amount of connections the channels are spread over. Only read once by
+    // initializeIrc. If there is no separate write connection, messages are
+    // sent on the first one.
+    virtual int readConnectionCount() const
+    {
+        return 1;
+    }
+
+    // Messages that all read connections receive, e.g. because they're not
+    // tied to a channel. Only the first read connection passes them to
+    // readConnectionMessageReceived so they aren't handled once per
+    // connection.
+    virtual bool isAccountWideMessage(Communi::IrcMessage *message) const
+    {
+        (void)message;
+        return false;
+    }
+
+    void open(IrcConnection *connection);
+
+    // Reconnects a single read connection, e.g. because the server asked us
+    // to. The other read connections stay connected.
+    void reconnectReadConnection(Communi::IrcConnection *connection,
+                                 const QString &reason);
 
     QMap<QString, std::weak_ptr<Channel>> channels;
     std::mutex channelMutex;
 
 private:
-    void initConnection();
+    struct ReadConnection {
+        QObjectPtr<IrcConnection> connection;
+        uint64_t messagesReceived = 0;
+        int reconnects = 0;
+        int lagMs = -1;
+    };
+
+    void initReadConnection(int index);
+    ConnectionType readConnectionType(int index) const;
+    void recordReadMessage(int index, Communi::IrcMessage *message);
+
+    // Index of the read connection the channel is joined on
+    int readConnectionIndex(const QString &channelName) const;
+    // -1 if the connection isn't a read connection
+    int readConnectionIndex(Communi::IrcConnection *connection) const;
+
+    // channelMutex must be locked
+    void addReadConnectionMessage(int index, const MessagePtr &message);
 
     QObjectPtr<IrcConnection> writeConnection_ = nullptr;
-    QObjectPtr<IrcConnection> readConnection_ = nullptr;
 
-    // Our rate limiting bucket for the Twitch join rate limits
+    // Channels are spread over the read connections by consistentShard, so
+    // every connection carries (and after a reconnect rejoins) only a part
+    // of them
+    std::vector<ReadConnection> readConnections_;
+
+    // Joins channels within the Twitch join rate limits
     // https://dev.twitch.tv/docs/irc/guide#rate-limits
-    QObjectPtr<RatelimitBucket> joinBucket_;
+    QObjectPtr<JoinScheduler> joinScheduler_;
 
     QTimer reconnectTimer_;
     int falloffCounter_ = 1;
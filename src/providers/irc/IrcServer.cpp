@@ -137,14 +137,14 @@ void IrcServer::initializeConnection(IrcConnection *connection,
                         if (*conn)
                         {
                             (*conn)->setPassword(password);
-                            this->open(Both);
+                            this->open(conn->get());
                         }
 
                         delete conn;
                     });
                 break;
             default:
-                this->open(Both);
+                this->open(connection);
         }
     }
 }
@@ -0,0 +1,127 @@
+#include "providers/irc/JoinScheduler.hpp"
+
+#include <QTimer>
+
+#include <algorithm>
+#include <map>
+
+namespace chatterino {
+
+JoinScheduler::JoinScheduler(int budget, int cooldown, SendFunction send,
+                             PriorityFunction priority, QObject *parent,
+                             ConnectionFunction connection)
+    : QObject(parent)
+    , budget_(budget)
+    , cooldown_(cooldown)
+    , send_(std::move(send))
+    , priority_(std::move(priority))
+    , connection_(std::move(connection))
+{
+}
+
+void JoinScheduler::join(const QString &channelName)
+{
+    if (std::find(this->queue_.begin(), this->queue_.end(), channelName) !=
+        this->queue_.end())
+    {
+        return;
+    }
+
+    this->queue_.push_back(channelName);
+    this->queueDispatch();
+}
+
+void JoinScheduler::cancel(const QString &channelName)
+{
+    this->queue_.erase(
+        std::remove(this->queue_.begin(), this->queue_.end(), channelName),
+        this->queue_.end());
+}
+
+void JoinScheduler::clear()
+{
+    this->queue_.clear();
+}
+
+int JoinScheduler::queuedCount() const
+{
+    return int(this->queue_.size());
+}
+
+void JoinScheduler::queueDispatch()
+{
+    if (this->dispatchQueued_ || this->budget_ <= 0)
+    {
+        // Either already queued or the cooldown timer will dispatch
+        return;
+    }
+
+    this->dispatchQueued_ = true;
+    QTimer::singleShot(0, this, [this] {
+        this->dispatchQueued_ = false;
+        this->dispatch();
+    });
+}
+
+void JoinScheduler::dispatch()
+{
+    if (this->queue_.empty() || this->budget_ <= 0)
+    {
+        return;
+    }
+
+    // Evaluate the priorities once per dispatch, they might have changed
+    // since the channels were queued
+    std::vector<std::pair<int, QString>> prioritized;
+    prioritized.reserve(this->queue_.size());
+    for (const auto &channelName : this->queue_)
+    {
+        prioritized.emplace_back(this->priority_(channelName), channelName);
+    }
+    std::stable_sort(prioritized.begin(), prioritized.end(),
+                     [](const auto &a, const auto &b) {
+                         return a.first > b.first;
+                     });
+
+    auto count = std::min(size_t(this->budget_), prioritized.size());
+
+    // One pending line per connection, ordered by connection so the lines
+    // are sent in a predictable order
+    std::map<int, QString> lines;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto &channelName = prioritized[i].second;
+        int connection = this->connection_ ? this->connection_(channelName) : 0;
+        auto &line = lines[connection];
+
+        if (!line.isEmpty() &&
+            line.size() + 2 + channelName.size() > MAX_LINE_LENGTH)
+        {
+            this->send_(line, connection);
+            line.clear();
+        }
+
+        line += line.isEmpty() ? "JOIN #" : ",#";
+        line += channelName;
+
+        this->cancel(channelName);
+    }
+
+    for (const auto &[connection, line] : lines)
+    {
+        if (!line.isEmpty())
+        {
+            this->send_(line, connection);
+        }
+    }
+
+    this->budget_ -= int(count);
+
+    QTimer::singleShot(this->cooldown_, this, [this, count] {
+        this->budget_ += int(count);
+        this->dispatch();
+    });
+}
+
+}  // namespace chatterino
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <functional>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Joins channels within a rate limit, most important channels first
+ *
+ * Channels queued with join() are not sent right away. Instead they are
+ * collected until the event loop runs again, sorted by the priority returned
+ * by the priority function (higher first) and packed into as few
+ * comma-separated JOIN lines as possible.
+ *
+ * Every joined channel uses up one unit of the budget, which is given back
+ * after cooldown milliseconds. Priorities are evaluated every time a batch is
+ * sent, so a channel that becomes visible while others are still waiting for
+ * budget gets joined next.
+ *
+ * The budget is shared between all connections. If channels are spread over
+ * multiple connections, the connection function tells which connection a
+ * channel is joined on and every line only contains channels of one
+ * connection.
+ **/
+class JoinScheduler : public QObject
+{
+public:
+    using PriorityFunction = std::function<int(const QString &channelName)>;
+    using SendFunction =
+        std::function<void(const QString &line, int connection)>;
+    using ConnectionFunction = std::function<int(const QString &channelName)>;
+
+    // Twitch and most other IRC servers don't accept longer lines (without
+    // the trailing \r\n)
+    static constexpr int MAX_LINE_LENGTH = 510;
+
+    JoinScheduler(int budget, int cooldown, SendFunction send,
+                  PriorityFunction priority, QObject *parent,
+                  ConnectionFunction connection = nullptr);
+
+    // Queues a channel to be joined. Does nothing if it's already queued.
+    void join(const QString &channelName);
+
+    // Removes a channel from the queue if it wasn't joined yet
+    void cancel(const QString &channelName);
+
+    // Removes all channels from the queue, e.g. after a disconnect
+    void clear();
+
+    int queuedCount() const;
+
+private:
+    void queueDispatch();
+    void dispatch();
+
+    /**
+     * @brief budget_ denotes the amount of channels that can be joined before we need to wait for the cooldown
+     **/
+    int budget_;
+
+    /**
+     * @brief This is the amount of time in milliseconds it takes for one used up budget to be put back into the bucket for use elsewhere
+     **/
+    const int cooldown_;
+
+    SendFunction send_;
+    PriorityFunction priority_;
+    ConnectionFunction connection_;
+
+    // In the order join() was called, used to break ties between priorities
+    std::vector<QString> queue_;
+    bool dispatchQueued_ = false;
+};
+
+}  // namespace chatterino
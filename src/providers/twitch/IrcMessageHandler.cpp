@@ -3,6 +3,7 @@
 #include "Application.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "debug/Trace.hpp"
 #include "messages/LimitedQueue.hpp"
 #include "messages/Message.hpp"
 #include "providers/twitch/TwitchAccountManager.hpp"
@@ -12,6 +13,7 @@
 #include "providers/twitch/TwitchMessageBuilder.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
+#include "singletons/SettingsSnapshot.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/FormatTime.hpp"
 #include "util/Helpers.hpp"
@@ -112,21 +114,23 @@ static float relativeSimilarity(const QString &str1, const QString &str2)
 float IrcMessageHandler::similarity(
     MessagePtr msg, const LimitedQueueSnapshot<MessagePtr> &messages)
 {
+    auto settings = getSettingsSnapshot();
+    auto now = QTime::currentTime();
+
     float similarityPercent = 0.0f;
     int checked = 0;
     for (int i = 1; i <= messages.size(); ++i)
     {
-        if (checked >= getSettings()->hideSimilarMaxMessagesToCheck)
+        if (checked >= settings->hideSimilarMaxMessagesToCheck)
         {
             break;
         }
         const auto &prevMsg = messages[messages.size() - i];
-        if (prevMsg->parseTime.secsTo(QTime::currentTime()) >=
-            getSettings()->hideSimilarMaxDelay)
+        if (prevMsg->parseTime.secsTo(now) >= settings->hideSimilarMaxDelay)
         {
             break;
         }
-        if (getSettings()->hideSimilarBySameUser &&
+        if (settings->hideSimilarBySameUser &&
             msg->loginName != prevMsg->loginName)
         {
             continue;
@@ -141,11 +145,13 @@ float IrcMessageHandler::similarity(
 
 void IrcMessageHandler::setSimilarityFlags(MessagePtr msg, ChannelPtr chan)
 {
-    if (getSettings()->similarityEnabled)
+    auto settings = getSettingsSnapshot();
+
+    if (settings->similarityEnabled)
     {
         bool isMyself = msg->loginName ==
                         getApp()->accounts->twitch.getCurrent()->getUserName();
-        bool hideMyself = getSettings()->hideSimilarMyself;
+        bool hideMyself = settings->hideSimilarMyself;
 
         if (isMyself && !hideMyself)
         {
@@ -153,10 +159,10 @@ void IrcMessageHandler::setSimilarityFlags(MessagePtr msg, ChannelPtr chan)
         }
 
         if (IrcMessageHandler::similarity(msg, chan->getMessageSnapshot()) >
-            getSettings()->similarityPercentage)
+            settings->similarityPercentage)
         {
             msg->flags.set(MessageFlag::Similar, true);
-            if (getSettings()->colorSimilarDisabled)
+            if (settings->colorSimilarDisabled)
             {
                 msg->flags.set(MessageFlag::Disabled, true);
             }
@@ -248,6 +254,8 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *_message,
                                    TwitchIrcServer &server, bool isSub,
                                    bool isAction)
 {
+    TraceScope trace("IrcMessageHandler::addMessage");
+
     QString channelName;
     if (!trimChannelName(target, channelName))
     {
@@ -311,9 +319,9 @@ void IrcMessageHandler::addMessage(Communi::IrcMessage *_message,
 
         IrcMessageHandler::setSimilarityFlags(msg, chan);
 
+        auto settings = getSettingsSnapshot();
         if (!msg->flags.has(MessageFlag::Similar) ||
-            (!getSettings()->hideSimilar &&
-             getSettings()->shownSimilarTriggerHighlights))
+            (!settings->hideSimilar && settings->shownSimilarTriggerHighlights))
         {
             builder.triggerHighlights();
         }
@@ -441,11 +449,12 @@ void IrcMessageHandler::handleClearChatMessage(Communi::IrcMessage *message)
             .release();
     chan->addOrReplaceTimeout(timeoutMsg);
 
-    // refresh all
+    // Layouts of the disabled messages notice their flags changed
     getApp()->windows->repaintVisibleChatWidgets(chan.get());
     if (getSettings()->hideModerated)
     {
-        getApp()->windows->forceLayoutChannelViews();
+        getApp()->windows->repaintVisibleChatWidgets(
+            getApp()->twitch->mentionsChannel.get());
     }
 }
 
@@ -0,0 +1,68 @@
+#include "providers/twitch/RecentMessagesReader.hpp"
+
+#include "providers/twitch/TwitchChannel.hpp"
+
+namespace chatterino {
+
+bool RecentMessagesReader::Key(const char *str, rapidjson::SizeType length,
+                               bool /*copy*/)
+{
+    if (this->depth_ == 1)
+    {
+        auto key = QLatin1String(str, int(length));
+        this->key_ = key == QLatin1String("messages")     ? Messages
+                     : key == QLatin1String("error_code") ? ErrorCode
+                                                          : Other;
+    }
+    return true;
+}
+
+bool RecentMessagesReader::String(const char *str, rapidjson::SizeType length,
+                                  bool /*copy*/)
+{
+    if (this->inMessages_ && this->depth_ == 2)
+    {
+        auto content = QString::fromUtf8(str, int(length));
+        content.replace(COMBINED_FIXER, ZERO_WIDTH_JOINER);
+        this->messages.emplace_back(content.toUtf8());
+    }
+    else if (this->depth_ == 1 && this->key_ == ErrorCode)
+    {
+        this->errorCode = QString::fromUtf8(str, int(length));
+    }
+    return true;
+}
+
+bool RecentMessagesReader::StartObject()
+{
+    this->depth_++;
+    return true;
+}
+
+bool RecentMessagesReader::EndObject(rapidjson::SizeType /*memberCount*/)
+{
+    this->depth_--;
+    return true;
+}
+
+bool RecentMessagesReader::StartArray()
+{
+    if (this->depth_ == 1 && this->key_ == Messages)
+    {
+        this->inMessages_ = true;
+    }
+    this->depth_++;
+    return true;
+}
+
+bool RecentMessagesReader::EndArray(rapidjson::SizeType /*elementCount*/)
+{
+    this->depth_--;
+    if (this->depth_ == 1)
+    {
+        this->inMessages_ = false;
+    }
+    return true;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <rapidjson/reader.h>
+
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Collects the messages and the error code of a recent-messages
+ * response while it is being parsed, without building a json document
+ *
+ * Only the top level "messages" array and "error_code" string are read,
+ * keys with the same names in nested objects are ignored. Emoji joined with
+ * ESCAPE_TAG get their zero width joiner back (see COMBINED_FIXER).
+ *
+ * Use with NetworkResult::parseRapidJsonSax.
+ **/
+struct RecentMessagesReader
+    : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, RecentMessagesReader> {
+    // Raw IRC lines
+    std::vector<QByteArray> messages;
+    // Empty if the response has none, or if it isn't a string
+    QString errorCode;
+
+    bool Key(const char *str, rapidjson::SizeType length, bool copy);
+    bool String(const char *str, rapidjson::SizeType length, bool copy);
+    bool StartObject();
+    bool EndObject(rapidjson::SizeType memberCount);
+    bool StartArray();
+    bool EndArray(rapidjson::SizeType elementCount);
+
+private:
+    enum { Other, Messages, ErrorCode } key_ = Other;
+    int depth_ = 0;
+    bool inMessages_ = false;
+};
+
+}  // namespace chatterino
@@ -13,6 +13,7 @@
 #include "common/Outcome.hpp"
 #include "common/QLogging.hpp"
 #include "messages/Emote.hpp"
+#include "providers/twitch/UserDecorationCache.hpp"
 
 namespace chatterino {
 
@@ -72,6 +73,7 @@ void TwitchBadges::loadTwitchBadges()
                     }
                 }
             }
+            UserDecorationCache::invalidate();
             this->loaded();
             return Success;
         })
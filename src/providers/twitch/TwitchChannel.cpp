@@ -5,6 +5,7 @@
 #include "common/Env.hpp"
 #include "common/NetworkRequest.hpp"
 #include "common/QLogging.hpp"
+#include "debug/Trace.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/notifications/NotificationController.hpp"
 #include "messages/Message.hpp"
@@ -12,6 +13,7 @@
 #include "providers/bttv/LoadBttvChannelEmote.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
 #include "providers/twitch/PubSubManager.hpp"
+#include "providers/twitch/RecentMessagesReader.hpp"
 #include "providers/twitch/TwitchCommon.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "providers/twitch/TwitchMessageBuilder.hpp"
@@ -94,34 +96,22 @@ namespace {
         return newMessage;
     }
 
-    // parseRecentMessages takes a json object and returns a vector of
-    // Communi IrcMessages
-    auto parseRecentMessages(const QJsonObject &jsonRoot, ChannelPtr channel)
+    // parseRecentMessage turns one line of the recent-messages API into a
+    // Communi IrcMessage
+    std::unique_ptr<Communi::IrcMessage> parseRecentMessage(
+        const QByteArray &line)
     {
-        QJsonArray jsonMessages = jsonRoot.value("messages").toArray();
-        std::vector<Communi::IrcMessage *> messages;
+        std::unique_ptr<Communi::IrcMessage> message(
+            Communi::IrcMessage::fromData(line, nullptr));
 
-        if (jsonMessages.empty())
-            return messages;
-
-        for (const auto jsonMessage : jsonMessages)
+        if (message->command() == "CLEARCHAT")
         {
-            auto content = jsonMessage.toString();
-            content.replace(COMBINED_FIXER, ZERO_WIDTH_JOINER);
-
-            auto message =
-                Communi::IrcMessage::fromData(content.toUtf8(), nullptr);
-
-            if (message->command() == "CLEARCHAT")
-            {
-                message = convertClearchatToNotice(message);
-            }
-
-            messages.emplace_back(std::move(message));
+            message.reset(convertClearchatToNotice(message.get()));
         }
 
-        return messages;
+        return message;
     }
+
     std::pair<Outcome, std::unordered_set<QString>> parseChatters(
         const QJsonObject &jsonRoot)
     {
@@ -258,12 +248,14 @@ void TwitchChannel::refreshFFZChannelEmotes(bool manualRefresh)
             if (auto shared = weak.lock())
             {
                 this->ffzCustomModBadge_.set(std::move(modBadge));
+                UserDecorationCache::invalidate();
             }
         },
         [this, weak = weakOf<Channel>(this)](auto &&vipBadge) {
             if (auto shared = weak.lock())
             {
                 this->ffzCustomVipBadge_.set(std::move(vipBadge));
+                UserDecorationCache::invalidate();
             }
         },
         manualRefresh);
@@ -759,20 +751,35 @@ void TwitchChannel::loadRecentMessages()
     auto weak = weakOf<Channel>(this);
 
     NetworkRequest(url)
-        .onSuccess([this, weak](NetworkResult result) -> Outcome {
+        // Decoding and building the messages happens on a worker thread,
+        // only adding them to the channel is done on the GUI thread
+        .concurrent()
+        .onSuccess([weak](NetworkResult result) -> Outcome {
+            TraceScope trace("TwitchChannel::loadRecentMessages");
+
+            RecentMessagesReader reader;
+            if (!result.parseRapidJsonSax(reader))
+            {
+                return Failure;
+            }
+
             auto shared = weak.lock();
             if (!shared)
                 return Failure;
 
-            auto root = result.parseJson();
-            auto messages = parseRecentMessages(root, shared);
-
             auto &handler = IrcMessageHandler::instance();
 
             std::vector<MessagePtr> allBuiltMessages;
+            allBuiltMessages.reserve(reader.messages.size());
 
-            for (auto message : messages)
+            // Every line is released as soon as it has been parsed and its
+            // IrcMessage right after the messages have been built from it, so
+            // only the built messages are kept around
+            for (auto &line : reader.messages)
             {
+                auto message = parseRecentMessage(line);
+                line.clear();
+
                 if (message->tags().contains("rm-received-ts"))
                 {
                     QDate msgDate = QDateTime::fromMSecsSinceEpoch(
@@ -792,25 +799,24 @@ void TwitchChannel::loadRecentMessages()
                 }
 
                 for (auto builtMessage :
-                     handler.parseMessage(shared.get(), message))
+                     handler.parseMessage(shared.get(), message.get()))
                 {
                     builtMessage->flags.set(MessageFlag::RecentMessage);
                     allBuiltMessages.emplace_back(builtMessage);
                 }
             }
 
-            postToThread([this, shared, root,
+            postToThread([shared, errorCode = reader.errorCode,
                           messages = std::move(allBuiltMessages)]() mutable {
                 shared->addMessagesAtStart(messages);
 
                 // Notify user about a possible gap in logs if it returned some messages
                 // but isn't currently joined to a channel
-                if (QString errorCode = root.value("error_code").toString();
-                    !errorCode.isEmpty())
+                if (!errorCode.isEmpty())
                 {
                     qCDebug(chatterinoTwitch)
                         << QString("rm error_code=%1, channel=%2")
-                               .arg(errorCode, this->getName());
+                               .arg(errorCode, shared->getName());
                     if (errorCode == "channel_not_joined" && !messages.empty())
                     {
                         shared->addMessage(makeSystemMessage(
@@ -962,6 +968,8 @@ void TwitchChannel::refreshBadges()
                 };
             }
 
+            UserDecorationCache::invalidate();
+
             return Success;
         })
         .execute();
@@ -1183,6 +1191,11 @@ boost::optional<EmotePtr> TwitchChannel::ffzCustomVipBadge() const
     return this->ffzCustomVipBadge_.get();
 }
 
+UserDecorationCache &TwitchChannel::userDecorations()
+{
+    return this->userDecorations_;
+}
+
 boost::optional<CheerEmote> TwitchChannel::cheerEmote(const QString &string)
 {
     auto sets = this->cheerEmoteSets_.access();
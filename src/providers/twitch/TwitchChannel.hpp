@@ -9,6 +9,7 @@
 #include "common/UniqueAccess.hpp"
 #include "providers/twitch/ChannelPointReward.hpp"
 #include "providers/twitch/TwitchEmotes.hpp"
+#include "providers/twitch/UserDecorationCache.hpp"
 #include "providers/twitch/api/Helix.hpp"
 #include "util/QStringHash.hpp"
 
@@ -114,6 +115,8 @@ public:
     boost::optional<EmotePtr> ffzCustomVipBadge() const;
     boost::optional<EmotePtr> twitchBadge(const QString &set,
                                           const QString &version) const;
+    // Badges and nicknames of the users chatting in this channel
+    UserDecorationCache &userDecorations();
 
     // Cheers
     boost::optional<CheerEmote> cheerEmote(const QString &string);
@@ -183,6 +186,7 @@ private:
     UniqueAccess<std::map<QString, std::map<QString, EmotePtr>>>
         badgeSets_;  // "subscribers": { "0": ... "3": ... "6": ...
     UniqueAccess<std::vector<CheerEmoteSet>> cheerEmoteSets_;
+    UserDecorationCache userDecorations_;
     UniqueAccess<std::map<QString, ChannelPointReward>> channelPointRewards_;
 
     bool mod_ = false;
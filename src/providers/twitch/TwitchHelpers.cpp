@@ -16,4 +16,24 @@ bool trimChannelName(const QString &channelName, QString &outChannelName)
     return true;
 }
 
+bool isAccountWideMessage(Communi::IrcMessage *message)
+{
+    const auto &command = message->command();
+
+    if (command == "WHISPER" || command == "GLOBALUSERSTATE")
+    {
+        return true;
+    }
+
+    if (command == "NOTICE")
+    {
+        // Same check as IrcMessageHandler::handleNoticeMessage, these are
+        // added to all channels
+        auto target = message->parameters().value(0);
+        return target.length() < 2 || target.mid(1) == "jtv";
+    }
+
+    return false;
+}
+
 }  // namespace chatterino
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <IrcMessage>
 #include <QString>
 
 namespace chatterino {
 
 bool trimChannelName(const QString &channelName, QString &outChannelName);
 
+// Messages that are sent to the logged in account instead of a channel, e.g.
+// whispers. Every read connection receives its own copy of them.
+bool isAccountWideMessage(Communi::IrcMessage *message);
+
 }  // namespace chatterino
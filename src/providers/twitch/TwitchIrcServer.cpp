@@ -1,6 +1,7 @@
 #include "TwitchIrcServer.hpp"
 
 #include <IrcCommand>
+#include <algorithm>
 #include <cassert>
 
 #include "Application.hpp"
@@ -8,6 +9,7 @@
 #include "common/Env.hpp"
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Message.hpp"
 #include "messages/MessageBuilder.hpp"
 #include "providers/twitch/IrcMessageHandler.hpp"
@@ -15,6 +17,7 @@
 #include "providers/twitch/TwitchAccount.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchHelpers.hpp"
+#include "singletons/Settings.hpp"
 #include "util/PostToThread.hpp"
 
 #include <QMetaEnum>
@@ -26,14 +29,33 @@ using namespace std::chrono_literals;
 
 namespace chatterino {
 
+namespace {
+
+    // Every read connection is another login, a handful of them is enough to
+    // spread a few hundred channels
+    const int MAX_READ_CONNECTIONS = 8;
+
+}  // namespace
+
 TwitchIrcServer::TwitchIrcServer()
     : whispersChannel(new Channel("/whispers", Channel::Type::TwitchWhispers))
     , mentionsChannel(new Channel("/mentions", Channel::Type::TwitchMentions))
     , watchingChannel(Channel::getEmpty(), Channel::Type::TwitchWatching)
     , liveChannel(new Channel("/live", Channel::Type::TwitchLive))
+    , sendQueue_([this](const QString &channelName, const QString &message) {
+        this->sendMessage(channelName, message);
+    })
 {
     this->initializeIrc();
 
+    this->sendQueue_.pendingChanged.connect([this](const QString &channelName) {
+        this->queuedMessagesChanged.invoke(channelName);
+    });
+    this->sendQueueTimer_.setSingleShot(true);
+    QObject::connect(&this->sendQueueTimer_, &QTimer::timeout, [this] {
+        this->processSendQueue();
+    });
+
     this->pubsub = new PubSub(TWITCH_PUBSUB_URL);
 
     // getSettings()->twitchSeperateWriteConnection.connect([this](auto, auto) {
@@ -46,6 +68,8 @@ void TwitchIrcServer::initialize(Settings &settings, Paths &paths)
 {
     getApp()->accounts->twitch.currentUserChanged.connect([this]() {
         postToThread([this] {
+            // Queued messages must not be sent by the new account
+            this->sendQueue_.clear();
             this->connect();
             this->pubsub->setAccount(getApp()->accounts->twitch.getCurrent());
         });
@@ -106,7 +130,7 @@ void TwitchIrcServer::initializeConnection(IrcConnection *connection,
     connection->setPort(Env::get().twitchServerPort);
     connection->setSecure(Env::get().twitchServerSecure);
 
-    this->open(type);
+    this->open(connection);
 }
 
 std::shared_ptr<Channel> TwitchIrcServer::createChannel(
@@ -127,6 +151,8 @@ std::shared_ptr<Channel> TwitchIrcServer::createChannel(
 void TwitchIrcServer::privateMessageReceived(
     Communi::IrcPrivateMessage *message)
 {
+    TraceScope trace("TwitchIrcServer::privateMessageReceived");
+
     IrcMessageHandler::instance().handlePrivMessage(message, *this);
 }
 
@@ -141,6 +167,8 @@ void TwitchIrcServer::readConnectionMessageReceived(
         return;
     }
 
+    TraceScope trace("TwitchIrcServer::readConnectionMessageReceived");
+
     const QString &command = message->command();
 
     auto &handler = IrcMessageHandler::instance();
@@ -187,9 +215,10 @@ void TwitchIrcServer::readConnectionMessageReceived(
     }
     else if (command == "RECONNECT")
     {
-        this->addGlobalSystemMessage(
+        // Only the connection that received this needs to reconnect
+        this->reconnectReadConnection(
+            message->connection(),
             "Twitch Servers requested us to reconnect, reconnecting");
-        this->connect();
     }
     else if (command == "GLOBALUSERSTATE")
     {
@@ -374,64 +403,58 @@ bool TwitchIrcServer::hasSeparateWriteConnection() const
     // return getSettings()->twitchSeperateWriteConnection;
 }
 
+int TwitchIrcServer::readConnectionCount() const
+{
+    return std::clamp(getSettings()->twitchReadConnections.getValue(), 1,
+                      MAX_READ_CONNECTIONS);
+}
+
+bool TwitchIrcServer::isAccountWideMessage(Communi::IrcMessage *message) const
+{
+    return chatterino::isAccountWideMessage(message);
+}
+
 void TwitchIrcServer::onMessageSendRequested(TwitchChannel *channel,
                                              const QString &message, bool &sent)
 {
     sent = false;
 
+    if (!this->sendQueue_.enqueue(channel->getName(), message,
+                                  channel->hasHighRateLimit()))
     {
-        std::lock_guard<std::mutex> guard(this->lastMessageMutex_);
-
-        //        std::queue<std::chrono::steady_clock::time_point>
-        auto &lastMessage = channel->hasHighRateLimit()
-                                ? this->lastMessageMod_
-                                : this->lastMessagePleb_;
-        size_t maxMessageCount = channel->hasHighRateLimit() ? 99 : 19;
-        auto minMessageOffset = (channel->hasHighRateLimit() ? 100ms : 1100ms);
-
-        auto now = std::chrono::steady_clock::now();
-
-        // check if you are sending messages too fast
-        if (!lastMessage.empty() && lastMessage.back() + minMessageOffset > now)
-        {
-            if (this->lastErrorTimeSpeed_ + 30s < now)
-            {
-                auto errorMessage =
-                    makeSystemMessage("You are sending messages too quickly.");
-
-                channel->addMessage(errorMessage);
-
-                this->lastErrorTimeSpeed_ = now;
-            }
-            return;
-        }
-
-        // remove messages older than 30 seconds
-        while (!lastMessage.empty() && lastMessage.front() + 32s < now)
-        {
-            lastMessage.pop();
-        }
+        channel->addMessage(makeSystemMessage(
+            "You are sending too many messages, wait for the queued ones to "
+            "be sent."));
+        return;
+    }
 
-        // check if you are sending too many messages
-        if (lastMessage.size() >= maxMessageCount)
-        {
-            if (this->lastErrorTimeAmount_ + 30s < now)
-            {
-                auto errorMessage =
-                    makeSystemMessage("You are sending too many messages.");
+    this->processSendQueue();
+    sent = true;
+}
 
-                channel->addMessage(errorMessage);
+void TwitchIrcServer::processSendQueue()
+{
+    auto next = this->sendQueue_.process();
+    if (!next)
+    {
+        this->sendQueueTimer_.stop();
+        return;
+    }
 
-                this->lastErrorTimeAmount_ = now;
-            }
-            return;
-        }
+    auto delay = std::chrono::ceil<std::chrono::milliseconds>(
+        *next - TwitchSendQueue::Clock::now());
+    this->sendQueueTimer_.start(std::max(delay, 0ms));
+}
 
-        lastMessage.push(now);
-    }
+size_t TwitchIrcServer::queuedMessageCount(const QString &channelName) const
+{
+    return this->sendQueue_.pendingCount(channelName);
+}
 
-    this->sendMessage(channel->getName(), message);
-    sent = true;
+void TwitchIrcServer::cancelQueuedMessages(const QString &channelName)
+{
+    this->sendQueue_.cancel(channelName);
+    this->processSendQueue();
 }
 
 const BttvEmotes &TwitchIrcServer::getBttvEmotes() const
@@ -7,10 +7,9 @@
 #include "providers/bttv/BttvEmotes.hpp"
 #include "providers/ffz/FfzEmotes.hpp"
 #include "providers/irc/AbstractIrcServer.hpp"
+#include "providers/twitch/TwitchSendQueue.hpp"
 
-#include <chrono>
 #include <memory>
-#include <queue>
 
 namespace chatterino {
 
@@ -33,6 +32,13 @@ public:
 
     void bulkRefreshLiveStatus();
 
+    // Messages that are waiting for the rate limit
+    size_t queuedMessageCount(const QString &channelName) const;
+    void cancelQueuedMessages(const QString &channelName);
+
+    // Invoked with the channel name when its queued message count changed
+    pajlada::Signals::Signal<QString> queuedMessagesChanged;
+
     Atomic<QString> lastUserThatWhisperedMe;
 
     const ChannelPtr whispersChannel;
@@ -63,16 +69,19 @@ protected:
 
     virtual QString cleanChannelName(const QString &dirtyChannelName) override;
     virtual bool hasSeparateWriteConnection() const override;
+    virtual int readConnectionCount() const override;
+    virtual bool isAccountWideMessage(
+        Communi::IrcMessage *message) const override;
 
 private:
     void onMessageSendRequested(TwitchChannel *channel, const QString &message,
                                 bool &sent);
+    void processSendQueue();
 
-    std::mutex lastMessageMutex_;
-    std::queue<std::chrono::steady_clock::time_point> lastMessagePleb_;
-    std::queue<std::chrono::steady_clock::time_point> lastMessageMod_;
-    std::chrono::steady_clock::time_point lastErrorTimeSpeed_;
-    std::chrono::steady_clock::time_point lastErrorTimeAmount_;
+    // Paces the messages of the current account instead of dropping the ones
+    // above the rate limit
+    TwitchSendQueue sendQueue_;
+    QTimer sendQueueTimer_;
 
     BttvEmotes bttv;
     FfzEmotes ffz;
@@ -4,6 +4,7 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/ignores/IgnoreController.hpp"
 #include "controllers/ignores/IgnorePhrase.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Message.hpp"
 #include "providers/chatterino/ChatterinoBadges.hpp"
 #include "providers/ffz/FfzBadges.hpp"
@@ -16,6 +17,7 @@
 #include "singletons/Theme.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/Helpers.hpp"
+#include "util/InternString.hpp"
 #include "util/IrcHelpers.hpp"
 #include "util/Qt.hpp"
 #include "widgets/Window.hpp"
@@ -58,9 +60,9 @@ namespace {
         return iterator.value().toString().split(',', Qt::SkipEmptyParts);
     }
 
-    std::map<QString, QString> parseBadgeInfos(const QVariantMap &tags)
+    MessageBadgeInfos parseBadgeInfos(const QVariantMap &tags)
     {
-        std::map<QString, QString> badgeInfos;
+        MessageBadgeInfos badgeInfos;
 
         for (QString badgeInfo : parseTagList(tags, "badge-info"))
         {
@@ -70,7 +72,8 @@ namespace {
                 continue;
             }
 
-            badgeInfos.emplace(parts[0], parts[1]);
+            badgeInfos.emplace(internString(parts[0]),
+                               internString(parts[1]));
         }
 
         return badgeInfos;
@@ -88,7 +91,8 @@ namespace {
                 continue;
             }
 
-            badges.emplace_back(parts[0], parts[1]);
+            badges.emplace_back(internString(parts[0]),
+                                internString(parts[1]));
         }
 
         return badges;
@@ -135,6 +139,8 @@ void TwitchMessageBuilder::triggerHighlights()
 
 MessagePtr TwitchMessageBuilder::build()
 {
+    TraceScope trace("TwitchMessageBuilder::build");
+
     // PARSE
     this->userId_ = this->ircMessage->tag("user-id").toString();
 
@@ -195,6 +201,9 @@ MessagePtr TwitchMessageBuilder::build()
         this->emplace<TwitchModerationElement>();
     }
 
+    this->parseUsernameText();
+    this->parseUserDecorations();
+
     this->appendTwitchBadges();
 
     this->appendChatterinoBadges();
@@ -219,6 +228,7 @@ MessagePtr TwitchMessageBuilder::build()
     {
         QStringList emoteString = iterator.value().toString().split('/');
         std::vector<int> correctPositions;
+        correctPositions.reserve(this->originalMessage_.size());
         for (int i = 0; i < this->originalMessage_.size(); ++i)
         {
             if (!this->originalMessage_.at(i).isLowSurrogate())
@@ -258,7 +268,8 @@ MessagePtr TwitchMessageBuilder::build()
     this->parseHighlights();
 
     // highlighting incoming whispers if requested per setting
-    if (this->args.isReceivedWhisper && getSettings()->highlightInlineWhispers)
+    if (this->args.isReceivedWhisper &&
+        this->settings_->highlightInlineWhispers)
     {
         this->message().flags.set(MessageFlag::HighlightedWhisper, true);
         this->message().highlightColor =
@@ -423,7 +434,8 @@ void TwitchMessageBuilder::addTextOrEmoji(const QString &string_)
             QString username = match.captured(1);
             auto originalTextColor = textColor;
 
-            if (this->twitchChannel != nullptr && getSettings()->colorUsernames)
+            if (this->twitchChannel != nullptr &&
+                this->settings_->colorUsernames)
             {
                 if (auto userColor =
                         this->twitchChannel->getUserColor(username);
@@ -454,7 +466,7 @@ void TwitchMessageBuilder::addTextOrEmoji(const QString &string_)
         }
     }
 
-    if (this->twitchChannel != nullptr && getSettings()->findAllUsernames)
+    if (this->twitchChannel != nullptr && this->settings_->findAllUsernames)
     {
         auto match = allUsernamesMentionRegex.match(string);
         QString username = match.captured(1);
@@ -464,7 +476,7 @@ void TwitchMessageBuilder::addTextOrEmoji(const QString &string_)
         {
             auto originalTextColor = textColor;
 
-            if (getSettings()->colorUsernames)
+            if (this->settings_->colorUsernames)
             {
                 if (auto userColor =
                         this->twitchChannel->getUserColor(username);
@@ -539,7 +551,7 @@ void TwitchMessageBuilder::parseUsernameColor()
         }
     }
 
-    if (getSettings()->colorizeNicknames && this->tags.contains("user-id"))
+    if (this->settings_->colorizeNicknames && this->tags.contains("user-id"))
     {
         this->usernameColor_ =
             getRandomColor(this->tags.value("user-id").toString());
@@ -563,7 +575,7 @@ void TwitchMessageBuilder::parseUsername()
     //        this->userName + ")";
     //    }
 
-    this->message().loginName = this->userName;
+    this->message().loginName = internString(this->userName);
     if (this->twitchChannel != nullptr)
     {
         this->twitchChannel->setUserColor(this->userName, this->usernameColor_);
@@ -577,12 +589,10 @@ void TwitchMessageBuilder::parseUsername()
     }
 }
 
-void TwitchMessageBuilder::appendUsername()
+void TwitchMessageBuilder::parseUsernameText()
 {
-    auto app = getApp();
-
     QString username = this->userName;
-    this->message().loginName = username;
+    this->message().loginName = internString(username);
     QString localizedName;
 
     auto iterator = this->tags.find("display-name");
@@ -596,14 +606,14 @@ void TwitchMessageBuilder::appendUsername()
         {
             username = displayName;
 
-            this->message().displayName = displayName;
+            this->message().displayName = internString(displayName);
         }
         else
         {
             localizedName = displayName;
 
-            this->message().displayName = username;
-            this->message().localizedName = displayName;
+            this->message().displayName = internString(username);
+            this->message().localizedName = internString(displayName);
         }
     }
 
@@ -612,7 +622,7 @@ void TwitchMessageBuilder::appendUsername()
     // The full string that will be rendered in the chat widget
     QString usernameText;
 
-    switch (getSettings()->usernameDisplayMode.getValue())
+    switch (this->settings_->usernameDisplayMode)
     {
         case UsernameDisplayMode::Username: {
             usernameText = username;
@@ -645,16 +655,133 @@ void TwitchMessageBuilder::appendUsername()
         break;
     }
 
-    auto nicknames = getCSettings().nicknames.readOnly();
+    this->usernameText_ = usernameText;
+}
+
+void TwitchMessageBuilder::parseUserDecorations()
+{
+    if (this->twitchChannel == nullptr)
+    {
+        this->decorations_ =
+            std::make_shared<const UserDecorations>(
+                this->resolveUserDecorations());
+        return;
+    }
+
+    // Everything resolveUserDecorations depends on
+    auto key = this->userId_ + '\n' + this->usernameText_ + '\n' +
+               this->tags.value("badges").toString() + '\n' +
+               this->tags.value("badge-info").toString();
+
+    this->decorations_ =
+        this->twitchChannel->userDecorations().get(key, [this] {
+            return this->resolveUserDecorations();
+        });
+}
+
+UserDecorations TwitchMessageBuilder::resolveUserDecorations()
+{
+    UserDecorations decorations;
+
+    if (this->twitchChannel != nullptr)
+    {
+        decorations.badgeInfos = parseBadgeInfos(this->tags);
+        decorations.badges = parseBadges(this->tags);
+
+        for (const auto &badge : decorations.badges)
+        {
+            auto badgeEmote = this->getTwitchBadge(badge);
+            if (!badgeEmote)
+            {
+                continue;
+            }
+
+            UserDecorations::TwitchBadge twitchBadge{
+                *badgeEmote, badge.flag_, (*badgeEmote)->tooltip.string,
+                boost::none, boost::none};
+            auto &tooltip = twitchBadge.tooltip;
+
+            if (badge.key_ == "bits")
+            {
+                const auto &cheerAmount = badge.value_;
+                tooltip = QString("Twitch cheer %0").arg(cheerAmount);
+            }
+            else if (badge.key_ == "moderator")
+            {
+                twitchBadge.customModBadge =
+                    this->twitchChannel->ffzCustomModBadge();
+            }
+            else if (badge.key_ == "vip")
+            {
+                twitchBadge.customVipBadge =
+                    this->twitchChannel->ffzCustomVipBadge();
+            }
+            else if (badge.flag_ == MessageElementFlag::BadgeSubscription)
+            {
+                auto badgeInfoIt = decorations.badgeInfos.find(badge.key_);
+                if (badgeInfoIt != decorations.badgeInfos.end())
+                {
+                    // badge.value_ is 4 chars long if user is subbed on higher tier
+                    // (tier + amount of months with leading zero if less than 100)
+                    // e.g. 3054 - tier 3 4,5-year sub. 2108 - tier 2 9-year sub
+                    const auto &subTier =
+                        badge.value_.length() > 3 ? badge.value_.front() : '1';
+                    const auto &subMonths = badgeInfoIt->second;
+                    tooltip += QString(" (%1%2 months)")
+                                   .arg(subTier != '1'
+                                            ? QString("Tier %1, ").arg(subTier)
+                                            : "")
+                                   .arg(subMonths);
+                }
+            }
+            else if (badge.flag_ == MessageElementFlag::BadgePredictions)
+            {
+                auto badgeInfoIt = decorations.badgeInfos.find(badge.key_);
+                if (badgeInfoIt != decorations.badgeInfos.end())
+                {
+                    auto predictionText =
+                        badgeInfoIt->second
+                            .replace("\\s", " ")  // standard IRC escapes
+                            .replace("\\:", ";")
+                            .replace("\\\\", "\\")
+                            .replace("⸝", ",");  // twitch's comma escape
+                    // Careful, the first character is RIGHT LOW PARAPHRASE BRACKET or U+2E1D, which just looks like a comma
+
+                    tooltip = QString("Predicted %1").arg(predictionText);
+                }
+            }
+
+            decorations.twitchBadges.push_back(std::move(twitchBadge));
+        }
+    }
+
+    decorations.chatterinoBadge =
+        getApp()->chatterinoBadges->getBadge({this->userId_});
 
-    for (const auto &nickname : *nicknames)
+    decorations.ffzBadge = getApp()->ffzBadges->getBadge({this->userId_});
+    if (decorations.ffzBadge)
     {
-        if (nickname.match(usernameText))
+        decorations.ffzBadgeColor =
+            getApp()->ffzBadges->getBadgeColor({this->userId_});
+    }
+
+    decorations.usernameText = this->usernameText_;
+    for (const auto &nickname : getCSettings().nicknames.snapshot())
+    {
+        if (nickname.match(decorations.usernameText))
         {
             break;
         }
     }
 
+    return decorations;
+}
+
+void TwitchMessageBuilder::appendUsername()
+{
+    auto app = getApp();
+    auto usernameText = this->decorations_->usernameText;
+
     if (this->args.isSentWhisper)
     {
         // TODO(pajlada): Re-implement
@@ -701,7 +828,7 @@ void TwitchMessageBuilder::appendUsername()
 void TwitchMessageBuilder::runIgnoreReplaces(
     std::vector<TwitchEmoteOccurence> &twitchEmotes)
 {
-    auto phrases = getCSettings().ignoredMessages.readOnly();
+    const auto &phrases = getCSettings().ignoredMessages.snapshot();
     auto removeEmotesInRange = [](int pos, int len,
                                   auto &twitchEmotes) mutable {
         auto it = std::partition(
@@ -767,7 +894,7 @@ void TwitchMessageBuilder::runIgnoreReplaces(
         }
     };
 
-    for (const auto &phrase : *phrases)
+    for (const auto &phrase : phrases)
     {
         if (phrase.isBlock())
         {
@@ -947,8 +1074,18 @@ void TwitchMessageBuilder::appendTwitchEmote(
             return;
         }
 
-        auto start = correctPositions[coords.at(0).toUInt()];
-        auto end = correctPositions[coords.at(1).toUInt()];
+        auto startIndex = coords.at(0).toUInt();
+        auto endIndex = coords.at(1).toUInt();
+
+        // Ranges past the end of the message would index out of bounds
+        if (startIndex >= correctPositions.size() ||
+            endIndex >= correctPositions.size())
+        {
+            return;
+        }
+
+        auto start = correctPositions[startIndex];
+        auto end = correctPositions[endIndex];
 
         if (start >= end || start < 0 || end > this->originalMessage_.length())
         {
@@ -1040,94 +1177,38 @@ void TwitchMessageBuilder::appendTwitchBadges()
         return;
     }
 
-    auto badgeInfos = parseBadgeInfos(this->tags);
-    auto badges = parseBadges(this->tags);
-
-    for (const auto &badge : badges)
+    for (const auto &badge : this->decorations_->twitchBadges)
     {
-        auto badgeEmote = this->getTwitchBadge(badge);
-        if (!badgeEmote)
+        if (badge.customModBadge &&
+            this->settings_->useCustomFfzModeratorBadges)
         {
+            this->emplace<ModBadgeElement>(
+                    badge.customModBadge.get(),
+                    MessageElementFlag::BadgeChannelAuthority)
+                ->setTooltip((*badge.customModBadge)->tooltip.string);
             continue;
         }
-        auto tooltip = (*badgeEmote)->tooltip.string;
 
-        if (badge.key_ == "bits")
-        {
-            const auto &cheerAmount = badge.value_;
-            tooltip = QString("Twitch cheer %0").arg(cheerAmount);
-        }
-        else if (badge.key_ == "moderator" &&
-                 getSettings()->useCustomFfzModeratorBadges)
+        if (badge.customVipBadge && this->settings_->useCustomFfzVipBadges)
         {
-            if (auto customModBadge = this->twitchChannel->ffzCustomModBadge())
-            {
-                this->emplace<ModBadgeElement>(
-                        customModBadge.get(),
-                        MessageElementFlag::BadgeChannelAuthority)
-                    ->setTooltip((*customModBadge)->tooltip.string);
-                // early out, since we have to add a custom badge element here
-                continue;
-            }
-        }
-        else if (badge.key_ == "vip" && getSettings()->useCustomFfzVipBadges)
-        {
-            if (auto customVipBadge = this->twitchChannel->ffzCustomVipBadge())
-            {
-                this->emplace<VipBadgeElement>(
-                        customVipBadge.get(),
-                        MessageElementFlag::BadgeChannelAuthority)
-                    ->setTooltip((*customVipBadge)->tooltip.string);
-                // early out, since we have to add a custom badge element here
-                continue;
-            }
-        }
-        else if (badge.flag_ == MessageElementFlag::BadgeSubscription)
-        {
-            auto badgeInfoIt = badgeInfos.find(badge.key_);
-            if (badgeInfoIt != badgeInfos.end())
-            {
-                // badge.value_ is 4 chars long if user is subbed on higher tier
-                // (tier + amount of months with leading zero if less than 100)
-                // e.g. 3054 - tier 3 4,5-year sub. 2108 - tier 2 9-year sub
-                const auto &subTier =
-                    badge.value_.length() > 3 ? badge.value_.front() : '1';
-                const auto &subMonths = badgeInfoIt->second;
-                tooltip +=
-                    QString(" (%1%2 months)")
-                        .arg(subTier != '1' ? QString("Tier %1, ").arg(subTier)
-                                            : "")
-                        .arg(subMonths);
-            }
-        }
-        else if (badge.flag_ == MessageElementFlag::BadgePredictions)
-        {
-            auto badgeInfoIt = badgeInfos.find(badge.key_);
-            if (badgeInfoIt != badgeInfos.end())
-            {
-                auto predictionText =
-                    badgeInfoIt->second
-                        .replace("\\s", " ")  // standard IRC escapes
-                        .replace("\\:", ";")
-                        .replace("\\\\", "\\")
-                        .replace("⸝", ",");  // twitch's comma escape
-                // Careful, the first character is RIGHT LOW PARAPHRASE BRACKET or U+2E1D, which just looks like a comma
-
-                tooltip = QString("Predicted %1").arg(predictionText);
-            }
+            this->emplace<VipBadgeElement>(
+                    badge.customVipBadge.get(),
+                    MessageElementFlag::BadgeChannelAuthority)
+                ->setTooltip((*badge.customVipBadge)->tooltip.string);
+            continue;
         }
 
-        this->emplace<BadgeElement>(badgeEmote.get(), badge.flag_)
-            ->setTooltip(tooltip);
+        this->emplace<BadgeElement>(badge.emote, badge.flag)
+            ->setTooltip(badge.tooltip);
     }
 
-    this->message().badges = badges;
-    this->message().badgeInfos = badgeInfos;
+    this->message().badges = this->decorations_->badges;
+    this->message().badgeInfos = this->decorations_->badgeInfos;
 }
 
 void TwitchMessageBuilder::appendChatterinoBadges()
 {
-    if (auto badge = getApp()->chatterinoBadges->getBadge({this->userId_}))
+    if (const auto &badge = this->decorations_->chatterinoBadge)
     {
         this->emplace<BadgeElement>(*badge,
                                     MessageElementFlag::BadgeChatterino);
@@ -1136,13 +1217,13 @@ void TwitchMessageBuilder::appendChatterinoBadges()
 
 void TwitchMessageBuilder::appendFfzBadges()
 {
-    if (auto badge = getApp()->ffzBadges->getBadge({this->userId_}))
+    const auto &badge = this->decorations_->ffzBadge;
+    const auto &color = this->decorations_->ffzBadgeColor;
+
+    if (badge && color)
     {
-        if (auto color = getApp()->ffzBadges->getBadgeColor({this->userId_}))
-        {
-            this->emplace<FfzBadgeElement>(*badge, MessageElementFlag::BadgeFfz,
-                                           color.get());
-        }
+        this->emplace<FfzBadgeElement>(*badge, MessageElementFlag::BadgeFfz,
+                                       color.get());
     }
 }
 
@@ -1170,7 +1251,7 @@ Outcome TwitchMessageBuilder::tryParseCheermote(const QString &string)
 
     int cheerValue = match.captured(1).toInt();
 
-    if (getSettings()->stackBits)
+    if (this->settings_->stackBits)
     {
         if (this->bitsStacked)
         {
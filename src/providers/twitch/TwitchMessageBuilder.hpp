@@ -6,6 +6,7 @@
 #include "providers/twitch/ChannelPointReward.hpp"
 #include "providers/twitch/PubSubActions.hpp"
 #include "providers/twitch/TwitchBadge.hpp"
+#include "providers/twitch/UserDecorationCache.hpp"
 
 #include <IrcMessage>
 #include <QString>
@@ -73,6 +74,9 @@ private:
     void parseUsername() override;
     void parseMessageID();
     void parseRoomID();
+    void parseUsernameText();
+    void parseUserDecorations();
+    UserDecorations resolveUserDecorations();
     void appendUsername();
 
     void runIgnoreReplaces(std::vector<TwitchEmoteOccurence> &twitchEmotes);
@@ -104,6 +108,10 @@ private:
 
     QString userId_;
     bool senderIsBroadcaster{};
+
+    // The username as it is displayed, before nicknames are applied
+    QString usernameText_;
+    UserDecorationsPtr decorations_;
 };
 
 }  // namespace chatterino
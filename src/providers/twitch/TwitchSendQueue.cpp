@@ -0,0 +1,167 @@
+#include "providers/twitch/TwitchSendQueue.hpp"
+
+#include <algorithm>
+#include <unordered_set>
+
+namespace chatterino {
+
+using namespace std::chrono_literals;
+
+const TwitchSendQueue::Limits TwitchSendQueue::NORMAL_LIMITS{19, 32s, 1100ms};
+const TwitchSendQueue::Limits TwitchSendQueue::HIGH_LIMITS{99, 32s, 100ms};
+
+TwitchSendQueue::TwitchSendQueue(SendFunction send, NowFunction now)
+    : send_(std::move(send))
+    , now_(std::move(now))
+{
+}
+
+bool TwitchSendQueue::enqueue(const QString &channelName,
+                              const QString &message, bool highRateLimit)
+{
+    if (this->pending_.size() >= MAX_PENDING)
+    {
+        return false;
+    }
+
+    this->pending_.push_back({channelName, message, highRateLimit});
+    this->pendingChanged.invoke(channelName);
+
+    return true;
+}
+
+std::optional<TwitchSendQueue::Clock::time_point> TwitchSendQueue::process()
+{
+    auto now = this->now_();
+
+    // Both limits use the same window
+    while (!this->sent_.empty() &&
+           this->sent_.front() + NORMAL_LIMITS.window <= now)
+    {
+        this->sent_.pop_front();
+    }
+
+    std::optional<Clock::time_point> next;
+    // Channels with an earlier message that can't be sent yet
+    std::unordered_set<QString> blocked;
+    std::unordered_set<QString> changed;
+
+    for (auto it = this->pending_.begin(); it != this->pending_.end();)
+    {
+        if (blocked.count(it->channelName) != 0)
+        {
+            ++it;
+            continue;
+        }
+
+        auto ready = this->readyAt(*it, now);
+        if (ready > now)
+        {
+            blocked.insert(it->channelName);
+            next = next ? std::min(*next, ready) : ready;
+            ++it;
+            continue;
+        }
+
+        auto item = std::move(*it);
+        it = this->pending_.erase(it);
+
+        this->sent_.push_back(now);
+        this->lastSent_[item.channelName] = now;
+        changed.insert(item.channelName);
+
+        this->send_(item.channelName, item.message);
+    }
+
+    // Forget the spacing of channels that have been quiet for a while
+    for (auto it = this->lastSent_.begin(); it != this->lastSent_.end();)
+    {
+        if (it->second + NORMAL_LIMITS.minSpacing <= now)
+        {
+            it = this->lastSent_.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (const auto &channelName : changed)
+    {
+        this->pendingChanged.invoke(channelName);
+    }
+
+    return next;
+}
+
+TwitchSendQueue::Clock::time_point TwitchSendQueue::readyAt(
+    const Item &item, Clock::time_point now) const
+{
+    const auto &limits = item.highRateLimit ? HIGH_LIMITS : NORMAL_LIMITS;
+    auto ready = now;
+
+    // Once the message at this index has left the window, there are fewer
+    // than maxMessages messages in it
+    if (this->sent_.size() >= limits.maxMessages)
+    {
+        auto oldest = this->sent_[this->sent_.size() - limits.maxMessages];
+        ready = std::max(ready, oldest + limits.window);
+    }
+
+    auto last = this->lastSent_.find(item.channelName);
+    if (last != this->lastSent_.end())
+    {
+        ready = std::max(ready, last->second + limits.minSpacing);
+    }
+
+    return ready;
+}
+
+size_t TwitchSendQueue::pendingCount() const
+{
+    return this->pending_.size();
+}
+
+size_t TwitchSendQueue::pendingCount(const QString &channelName) const
+{
+    return size_t(std::count_if(this->pending_.begin(), this->pending_.end(),
+                                [&](const Item &item) {
+                                    return item.channelName == channelName;
+                                }));
+}
+
+void TwitchSendQueue::cancel(const QString &channelName)
+{
+    auto count = this->pending_.size();
+
+    this->pending_.erase(std::remove_if(this->pending_.begin(),
+                                        this->pending_.end(),
+                                        [&](const Item &item) {
+                                            return item.channelName ==
+                                                   channelName;
+                                        }),
+                         this->pending_.end());
+
+    if (this->pending_.size() != count)
+    {
+        this->pendingChanged.invoke(channelName);
+    }
+}
+
+void TwitchSendQueue::clear()
+{
+    std::unordered_set<QString> channelNames;
+    for (const auto &item : this->pending_)
+    {
+        channelNames.insert(item.channelName);
+    }
+
+    this->pending_.clear();
+
+    for (const auto &channelName : channelNames)
+    {
+        this->pendingChanged.invoke(channelName);
+    }
+}
+
+}  // namespace chatterino
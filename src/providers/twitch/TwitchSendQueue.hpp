@@ -0,0 +1,99 @@
+#pragma once
+
+#include "util/QStringHash.hpp"
+
+#include <pajlada/signals/signal.hpp>
+#include <QString>
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+namespace chatterino {
+
+/**
+ * @brief Paces outgoing chat messages to the Twitch rate limits
+ *
+ * Messages are sent right away as long as the limits allow it and queued
+ * otherwise, instead of being dropped. Twitch counts all messages of an
+ * account within a sliding window: a message in a channel where the user is
+ * a moderator, VIP or broadcaster may be sent while there are fewer than
+ * HIGH_LIMITS.maxMessages messages in the window, any other message only while
+ * there are fewer than NORMAL_LIMITS.maxMessages. Additionally, messages to
+ * the same channel are spaced by minSpacing.
+ *
+ * Messages to the same channel are sent in the order they were queued. A
+ * channel waiting for its spacing doesn't hold back messages to other
+ * channels.
+ *
+ * Nothing happens on its own: the owner calls process() after enqueue() and
+ * again at the time process() returned. Not thread-safe.
+ **/
+class TwitchSendQueue
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using NowFunction = std::function<Clock::time_point()>;
+    using SendFunction = std::function<void(const QString &channelName,
+                                            const QString &message)>;
+
+    struct Limits {
+        // Messages allowed within window
+        size_t maxMessages;
+        std::chrono::milliseconds window;
+        // Minimum time between two messages to the same channel
+        std::chrono::milliseconds minSpacing;
+    };
+
+    // Twitch allows 20 and 100 messages per 30 seconds, these leave some
+    // room for clock differences
+    static const Limits NORMAL_LIMITS;
+    static const Limits HIGH_LIMITS;
+
+    // Queued messages per account, further messages are rejected
+    static constexpr size_t MAX_PENDING = 500;
+
+    explicit TwitchSendQueue(SendFunction send, NowFunction now = Clock::now);
+
+    // Returns false if the queue is full
+    bool enqueue(const QString &channelName, const QString &message,
+                 bool highRateLimit);
+
+    // Sends all queued messages the limits allow. Returns the time the next
+    // queued message can be sent at, nothing if the queue is empty.
+    std::optional<Clock::time_point> process();
+
+    size_t pendingCount() const;
+    size_t pendingCount(const QString &channelName) const;
+
+    // Drops all queued messages of the channel
+    void cancel(const QString &channelName);
+
+    // Drops all queued messages, e.g. when the account changed
+    void clear();
+
+    // Invoked with the channel name whenever the amount of queued messages of
+    // that channel changed
+    pajlada::Signals::Signal<QString> pendingChanged;
+
+private:
+    struct Item {
+        QString channelName;
+        QString message;
+        bool highRateLimit;
+    };
+
+    Clock::time_point readyAt(const Item &item, Clock::time_point now) const;
+
+    SendFunction send_;
+    NowFunction now_;
+
+    std::deque<Item> pending_;
+    // Send times of the messages within the window, oldest first
+    std::deque<Clock::time_point> sent_;
+    std::unordered_map<QString, Clock::time_point> lastSent_;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,49 @@
+#include "providers/twitch/UserDecorationCache.hpp"
+
+namespace chatterino {
+
+std::atomic<uint64_t> UserDecorationCache::generation_{0};
+
+UserDecorationsPtr UserDecorationCache::get(
+    const QString &key, const std::function<UserDecorations()> &compute)
+{
+    auto generation = generation_.load();
+
+    {
+        auto entries = this->entries_.access();
+        if (entries->generation != generation)
+        {
+            entries->decorations =
+                cache::lru_cache<QString, UserDecorationsPtr>(maxUserCount);
+            entries->generation = generation;
+        }
+        else if (entries->decorations.exists(key))
+        {
+            return entries->decorations.get(key);
+        }
+    }
+
+    // Computed without holding the lock, it takes the locks of the badge
+    // providers
+    auto decorations = std::make_shared<const UserDecorations>(compute());
+
+    auto entries = this->entries_.access();
+    if (entries->generation == generation && generation_.load() == generation)
+    {
+        entries->decorations.put(key, decorations);
+    }
+
+    return decorations;
+}
+
+size_t UserDecorationCache::size() const
+{
+    return this->entries_.access()->decorations.size();
+}
+
+void UserDecorationCache::invalidate()
+{
+    generation_++;
+}
+
+}  // namespace chatterino
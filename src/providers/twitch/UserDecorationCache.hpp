@@ -0,0 +1,91 @@
+#pragma once
+
+#include "common/UniqueAccess.hpp"
+#include "lrucache/lrucache.hpp"
+#include "messages/Message.hpp"
+#include "providers/twitch/TwitchBadge.hpp"
+#include "util/QStringHash.hpp"
+
+#include <QColor>
+#include <QString>
+#include <boost/optional.hpp>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+
+/**
+ * @brief Everything that is drawn around a user's name in a channel
+ *
+ * Looking up the badges of a message goes through the Twitch, FFZ and
+ * Chatterino badge providers, each with their own lock. The result only
+ * depends on the user, the badge tags and the username, so it's resolved
+ * once and shared by all messages with the same ones.
+ **/
+struct UserDecorations {
+    struct TwitchBadge {
+        EmotePtr emote;
+        MessageElementFlag flag;
+        QString tooltip;
+        // The channel's FFZ badge for moderators or VIPs, shown instead of
+        // emote if enabled in the settings
+        boost::optional<EmotePtr> customModBadge;
+        boost::optional<EmotePtr> customVipBadge;
+    };
+
+    std::vector<TwitchBadge> twitchBadges;
+    std::vector<Badge> badges;
+    MessageBadgeInfos badgeInfos;
+
+    boost::optional<EmotePtr> chatterinoBadge;
+    boost::optional<EmotePtr> ffzBadge;
+    boost::optional<QColor> ffzBadgeColor;
+
+    // The username as it is displayed, with the user's nickname applied
+    QString usernameText;
+};
+
+using UserDecorationsPtr = std::shared_ptr<const UserDecorations>;
+
+/**
+ * @brief Caches UserDecorations of the most recent chatters of a channel
+ *
+ * Entries are dropped from all caches when a badge provider reloads or the
+ * nicknames change, see invalidate(). Thread safe.
+ **/
+class UserDecorationCache
+{
+public:
+    static constexpr size_t maxUserCount = 2000;
+
+    // Returns the cached decorations for the key, or computes and caches
+    // them. The key must contain everything compute depends on.
+    UserDecorationsPtr get(const QString &key,
+                           const std::function<UserDecorations()> &compute);
+
+    // Number of cached entries, only meant for tests
+    size_t size() const;
+
+    // Bumps the generation shared by all caches, their entries are
+    // recomputed when they are used next
+    static void invalidate();
+
+private:
+    struct Entries {
+        cache::lru_cache<QString, UserDecorationsPtr> decorations{
+            maxUserCount};
+        uint64_t generation = 0;
+    };
+
+    static std::atomic<uint64_t> generation_;
+
+    UniqueAccess<Entries> entries_;
+};
+
+}  // namespace chatterino
@@ -57,6 +57,7 @@ void Fonts::initialize(Settings &, Paths &)
             {
                 map.clear();
             }
+            this->generation_++;
             this->fontChanged.invoke();
         },
         false);
@@ -69,6 +70,7 @@ void Fonts::initialize(Settings &, Paths &)
             {
                 map.clear();
             }
+            this->generation_++;
             this->fontChanged.invoke();
         },
         false);
@@ -85,12 +87,18 @@ void Fonts::initialize(Settings &, Paths &)
             {
                 map.clear();
             }
+            this->generation_++;
             this->fontChanged.invoke();
         },
         false);
 #endif
 }
 
+int Fonts::getGeneration() const
+{
+    return this->generation_;
+}
+
 QFont Fonts::getFont(FontStyle type, float scale)
 {
     return this->getOrCreateFontData(type, scale).font;
@@ -51,6 +51,9 @@ public:
     QFont getFont(FontStyle type, float scale);
     QFontMetrics getFontMetrics(FontStyle type, float scale);
 
+    // Incremented every time the fonts change, before fontChanged is invoked
+    int getGeneration() const;
+
     QStringSetting chatFontFamily;
     IntSetting chatFontSize;
 
@@ -86,6 +89,7 @@ private:
     FontData createFontData(FontStyle type, float scale);
 
     std::vector<std::unordered_map<float, FontData>> fontsByType_;
+    int generation_ = 0;
 };
 
 Fonts *getFonts();
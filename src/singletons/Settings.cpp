@@ -6,6 +6,7 @@
 #include "controllers/ignores/IgnorePhrase.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Resources.hpp"
+#include "singletons/SettingsSnapshot.hpp"
 #include "singletons/WindowManager.hpp"
 #include "util/PersistSignalVector.hpp"
 #include "util/WindowsHelper.hpp"
@@ -40,9 +41,7 @@ ConcurrentSettings::ConcurrentSettings()
 
 bool ConcurrentSettings::isHighlightedUser(const QString &username)
 {
-    auto items = this->highlightedUsers.readOnly();
-
-    for (const auto &highlightedUser : *items)
+    for (const auto &highlightedUser : this->highlightedUsers.snapshot())
     {
         if (highlightedUser.isMatch(username))
             return true;
@@ -53,9 +52,7 @@ bool ConcurrentSettings::isHighlightedUser(const QString &username)
 
 bool ConcurrentSettings::isBlacklistedUser(const QString &username)
 {
-    auto items = this->blacklistedUsers.readOnly();
-
-    for (const auto &blacklistedUser : *items)
+    for (const auto &blacklistedUser : this->blacklistedUsers.snapshot())
     {
         if (blacklistedUser.isMatch(username))
             return true;
@@ -66,9 +63,7 @@ bool ConcurrentSettings::isBlacklistedUser(const QString &username)
 
 bool ConcurrentSettings::isMutedChannel(const QString &channelName)
 {
-    auto items = this->mutedChannels.readOnly();
-
-    for (const auto &channel : *items)
+    for (const auto &channel : this->mutedChannels.snapshot())
     {
         if (channelName.toLower() == channel.toLower())
         {
@@ -126,6 +121,8 @@ Settings::Settings(const QString &settingsDirectory)
     instance_ = this;
     concurrentInstance_ = this;
 
+    initializeSettingsSnapshot(*this, this->snapshotListener_);
+
 #ifdef USEWINSDK
     this->autorun = isRegisteredForStartup();
     this->autorun.connect(
@@ -375,6 +375,7 @@ public:
         "/misc/twitch/messageHistoryLimit",
         800,
     };
+    IntSetting twitchReadConnections = {"/misc/twitch/readConnections", 1};
 
     IntSetting emotesTooltipPreview = {"/misc/emotesTooltipPreview", 1};
     BoolSetting openLinksIncognito = {"/misc/openLinksIncognito", 0};
@@ -387,6 +388,7 @@ public:
     BoolSetting informOnTabVisibilityToggle = {"/misc/askOnTabVisibilityToggle",
                                                true};
     BoolSetting lockNotebookLayout = {"/misc/lockNotebookLayout", false};
+    BoolSetting cacheTextRuns = {"/misc/cacheTextRuns", true};
 
     /// Debug
     BoolSetting showUnhandledIrcMessages = {"/debug/showUnhandledIrcMessages",
@@ -428,6 +430,9 @@ public:
 
 private:
     void updateModerationActions();
+
+    // Rebuilds the SettingsSnapshot
+    pajlada::SettingListener snapshotListener_;
 };
 
 }  // namespace chatterino
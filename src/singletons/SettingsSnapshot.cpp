@@ -0,0 +1,135 @@
+#include "singletons/SettingsSnapshot.hpp"
+
+#include "singletons/Settings.hpp"
+
+#include <pajlada/settings/settinglistener.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace chatterino {
+
+namespace {
+
+    // Written from the thread that changes a setting (the GUI thread), read
+    // from any thread. Only ever accessed through std::atomic_load/store.
+    SettingsSnapshotPtr currentSnapshot =
+        std::make_shared<const SettingsSnapshot>();
+
+    // Copies one setting into its snapshot field
+    using Reader = std::function<void(SettingsSnapshot &)>;
+
+    std::vector<Reader> &readers()
+    {
+        static std::vector<Reader> instance;
+        return instance;
+    }
+
+    void rebuild()
+    {
+        auto previous = std::atomic_load(&currentSnapshot);
+
+        auto snapshot = std::make_shared<SettingsSnapshot>();
+        for (const auto &read : readers())
+        {
+            read(*snapshot);
+        }
+        snapshot->version = previous->version + 1;
+
+        std::atomic_store(&currentSnapshot,
+                          SettingsSnapshotPtr(std::move(snapshot)));
+    }
+
+    template <typename Setting, typename T>
+    void bind(pajlada::SettingListener &listener, Setting &setting,
+              T SettingsSnapshot::*field)
+    {
+        listener.addSetting(setting);
+        readers().emplace_back([&setting, field](SettingsSnapshot &snapshot) {
+            snapshot.*field = static_cast<T>(setting.getValue());
+        });
+    }
+
+}  // namespace
+
+SettingsSnapshotPtr getSettingsSnapshot()
+{
+    return std::atomic_load(&currentSnapshot);
+}
+
+void initializeSettingsSnapshot(Settings &s,
+                                pajlada::SettingListener &listener)
+{
+    using S = SettingsSnapshot;
+    auto &l = listener;
+
+    readers().clear();
+
+    // Similarity
+    bind(l, s.similarityEnabled, &S::similarityEnabled);
+    bind(l, s.colorSimilarDisabled, &S::colorSimilarDisabled);
+    bind(l, s.hideSimilar, &S::hideSimilar);
+    bind(l, s.hideSimilarBySameUser, &S::hideSimilarBySameUser);
+    bind(l, s.hideSimilarMyself, &S::hideSimilarMyself);
+    bind(l, s.shownSimilarTriggerHighlights,
+         &S::shownSimilarTriggerHighlights);
+    bind(l, s.similarityPercentage, &S::similarityPercentage);
+    bind(l, s.hideSimilarMaxDelay, &S::hideSimilarMaxDelay);
+    bind(l, s.hideSimilarMaxMessagesToCheck,
+         &S::hideSimilarMaxMessagesToCheck);
+
+    // Highlights
+    bind(l, s.enableSelfHighlight, &S::enableSelfHighlight);
+    bind(l, s.showSelfHighlightInMentions, &S::showSelfHighlightInMentions);
+    bind(l, s.enableSelfHighlightSound, &S::enableSelfHighlightSound);
+    bind(l, s.enableSelfHighlightTaskbar, &S::enableSelfHighlightTaskbar);
+    bind(l, s.selfHighlightSoundUrl, &S::selfHighlightSoundUrl);
+    bind(l, s.enableWhisperHighlight, &S::enableWhisperHighlight);
+    bind(l, s.enableWhisperHighlightSound, &S::enableWhisperHighlightSound);
+    bind(l, s.enableWhisperHighlightTaskbar,
+         &S::enableWhisperHighlightTaskbar);
+    bind(l, s.whisperHighlightSoundUrl, &S::whisperHighlightSoundUrl);
+    bind(l, s.enableSubHighlight, &S::enableSubHighlight);
+    bind(l, s.enableSubHighlightSound, &S::enableSubHighlightSound);
+    bind(l, s.enableSubHighlightTaskbar, &S::enableSubHighlightTaskbar);
+    bind(l, s.subHighlightSoundUrl, &S::subHighlightSoundUrl);
+    bind(l, s.customHighlightSound, &S::customHighlightSound);
+    bind(l, s.pathHighlightSound, &S::pathHighlightSound);
+    bind(l, s.highlightAlwaysPlaySound, &S::highlightAlwaysPlaySound);
+    bind(l, s.streamerModeMuteMentions, &S::streamerModeMuteMentions);
+
+    // Message building
+    bind(l, s.colorizeNicknames, &S::colorizeNicknames);
+    bind(l, s.highlightInlineWhispers, &S::highlightInlineWhispers);
+    bind(l, s.colorUsernames, &S::colorUsernames);
+    bind(l, s.findAllUsernames, &S::findAllUsernames);
+    bind(l, s.usernameDisplayMode, &S::usernameDisplayMode);
+    bind(l, s.useCustomFfzModeratorBadges, &S::useCustomFfzModeratorBadges);
+    bind(l, s.useCustomFfzVipBadges, &S::useCustomFfzVipBadges);
+    bind(l, s.stackBits, &S::stackBits);
+
+    // Layout and painting
+    bind(l, s.hideModerated, &S::hideModerated);
+    bind(l, s.hideModerationActions, &S::hideModerationActions);
+    bind(l, s.compactEmotes, &S::compactEmotes);
+    bind(l, s.removeSpacesBetweenEmotes, &S::removeSpacesBetweenEmotes);
+    bind(l, s.collpseMessagesMinLines, &S::collpseMessagesMinLines);
+    bind(l, s.separateMessages, &S::separateMessages);
+    bind(l, s.alternateMessages, &S::alternateMessages);
+    bind(l, s.enableRedeemedHighlight, &S::enableRedeemedHighlight);
+    bind(l, s.enableFirstMessageHighlight, &S::enableFirstMessageHighlight);
+    bind(l, s.showLastMessageIndicator, &S::showLastMessageIndicator);
+    bind(l, s.lastMessageColor, &S::lastMessageColor);
+    bind(l, s.lastMessagePattern, &S::lastMessagePattern);
+    bind(l, s.cacheTextRuns, &S::cacheTextRuns);
+
+    // Changing several settings at once (e.g. when resetting them) rebuilds
+    // the snapshot once per setting, which is fine as it's cheap
+    listener.setCB([] {
+        rebuild();
+    });
+
+    rebuild();
+}
+
+}  // namespace chatterino
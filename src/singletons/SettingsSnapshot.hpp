@@ -0,0 +1,103 @@
+#pragma once
+
+#include <QColor>
+#include <QString>
+
+#include <cstdint>
+#include <memory>
+
+namespace pajlada {
+class SettingListener;
+}  // namespace pajlada
+
+namespace chatterino {
+
+class Settings;
+enum UsernameDisplayMode : int;
+
+/**
+ * @brief Immutable copy of the settings read while building, laying out and
+ * painting messages
+ *
+ * Reading a setting through getSettings() goes through the setting's shared
+ * data on every access, which adds up when it's done for every message or
+ * even every element. Instead, the snapshot is rebuilt whenever one of the
+ * settings below changes and then published as a whole, so hot paths grab
+ * it once per message (or layout/paint pass) and only do plain field reads
+ * afterwards.
+ *
+ * A snapshot never changes after it has been published. version is
+ * incremented for every rebuild and can be used to tell whether something
+ * was computed with outdated settings.
+ **/
+struct SettingsSnapshot {
+    uint64_t version = 0;
+
+    // Similarity
+    bool similarityEnabled = false;
+    bool colorSimilarDisabled = true;
+    bool hideSimilar = false;
+    bool hideSimilarBySameUser = true;
+    bool hideSimilarMyself = false;
+    bool shownSimilarTriggerHighlights = false;
+    float similarityPercentage = 0.9f;
+    int hideSimilarMaxDelay = 5;
+    int hideSimilarMaxMessagesToCheck = 3;
+
+    // Highlights
+    bool enableSelfHighlight = true;
+    bool showSelfHighlightInMentions = true;
+    bool enableSelfHighlightSound = true;
+    bool enableSelfHighlightTaskbar = true;
+    QString selfHighlightSoundUrl;
+    bool enableWhisperHighlight = true;
+    bool enableWhisperHighlightSound = false;
+    bool enableWhisperHighlightTaskbar = false;
+    QString whisperHighlightSoundUrl;
+    bool enableSubHighlight = true;
+    bool enableSubHighlightSound = false;
+    bool enableSubHighlightTaskbar = false;
+    QString subHighlightSoundUrl;
+    bool customHighlightSound = false;
+    QString pathHighlightSound;
+    bool highlightAlwaysPlaySound = false;
+    bool streamerModeMuteMentions = true;
+
+    // Message building
+    bool colorizeNicknames = true;
+    bool highlightInlineWhispers = false;
+    bool colorUsernames = true;
+    bool findAllUsernames = false;
+    UsernameDisplayMode usernameDisplayMode{};
+    bool useCustomFfzModeratorBadges = true;
+    bool useCustomFfzVipBadges = true;
+    bool stackBits = false;
+
+    // Layout and painting
+    bool hideModerated = false;
+    bool hideModerationActions = false;
+    bool compactEmotes = true;
+    bool removeSpacesBetweenEmotes = false;
+    int collpseMessagesMinLines = 0;
+    bool separateMessages = false;
+    bool alternateMessages = false;
+    bool enableRedeemedHighlight = true;
+    bool enableFirstMessageHighlight = true;
+    bool showLastMessageIndicator = false;
+    // Invalid if the theme's color should be used
+    QColor lastMessageColor;
+    Qt::BrushStyle lastMessagePattern = Qt::SolidPattern;
+    bool cacheTextRuns = true;
+};
+
+using SettingsSnapshotPtr = std::shared_ptr<const SettingsSnapshot>;
+
+// Returns the latest snapshot, can be called from any thread
+SettingsSnapshotPtr getSettingsSnapshot();
+
+// Builds the first snapshot and registers the settings it's made of with
+// listener, which rebuilds it on every change
+void initializeSettingsSnapshot(Settings &settings,
+                                pajlada::SettingListener &listener);
+
+}  // namespace chatterino
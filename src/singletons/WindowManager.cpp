@@ -285,6 +285,40 @@ void WindowManager::select(SplitContainer *container)
     this->selectSplitContainer.invoke(container);
 }
 
+int WindowManager::getChannelJoinPriority(const QString &channelName)
+{
+    assertInGuiThread();
+
+    int priority = 0;
+
+    for (Window *window : this->windows_)
+    {
+        auto *page = dynamic_cast<SplitContainer *>(
+            window->getNotebook().getSelectedPage());
+        if (page == nullptr)
+        {
+            continue;
+        }
+
+        for (auto *split : page->getSplits())
+        {
+            if (split->getChannel()->getName() != channelName)
+            {
+                continue;
+            }
+
+            if (split->isVisible() && !window->isMinimized())
+            {
+                return 2;
+            }
+
+            priority = 1;
+        }
+    }
+
+    return priority;
+}
+
 QPoint WindowManager::emotePopupPos()
 {
     return this->emotePopupPos_;
@@ -364,6 +398,9 @@ void WindowManager::initialize(Settings &settings, Paths &paths)
     settings.enableRedeemedHighlight.connect([this](auto, auto) {
         this->forceLayoutChannelViews();
     });
+    settings.cacheTextRuns.connect([this](auto, auto) {
+        this->forceLayoutChannelViews();
+    });
 
     this->initialized_ = true;
 }
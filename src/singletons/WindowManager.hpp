@@ -45,10 +45,11 @@ public:
     void showAccountSelectPopup(QPoint point);
 
     // Tell a channel (or all channels if channel is nullptr) to redo their
-    // layout
+    // layout. Only messages that changed, or used an image that has loaded
+    // since, are laid out again.
     void layoutChannelViews(Channel *channel = nullptr);
 
-    // Force all channel views to redo their layout
+    // Force all channel views to lay out every message again
     // This is called, for example, when the emote scale or timestamp format has
     // changed
     void forceLayoutChannelViews();
@@ -62,6 +63,10 @@ public:
     void select(Split *split);
     void select(SplitContainer *container);
 
+    // Returns how urgently a channel should be joined: 2 if it is shown in a
+    // visible split, 1 if it is in the selected tab of a window, 0 otherwise
+    int getChannelJoinPriority(const QString &channelName);
+
     QPoint emotePopupPos();
     void setEmotePopupPos(QPoint pos);
 
@@ -4,28 +4,118 @@
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
 
+#include <algorithm>
+
 namespace chatterino {
 
+namespace {
+
+    // weight of the newest frame in the moving average
+    constexpr double averageWeight = 0.1;
+
+}  // namespace
+
+AnimationBudget::Mode AnimationBudget::addFrame(double busyMs)
+{
+    this->average_ += (busyMs - this->average_) * averageWeight;
+
+    if (this->mode_ == Mode::Full)
+    {
+        if (this->average_ > budget)
+        {
+            this->mode_ = Mode::Throttled;
+            this->calmFrames_ = 0;
+        }
+    }
+    else
+    {
+        if (this->average_ < resumeThreshold)
+        {
+            if (++this->calmFrames_ >= resumeFrames)
+            {
+                this->mode_ = Mode::Full;
+            }
+        }
+        else
+        {
+            this->calmFrames_ = 0;
+        }
+    }
+
+    return this->mode_;
+}
+
+AnimationBudget::Mode AnimationBudget::mode() const
+{
+    return this->mode_;
+}
+
+double AnimationBudget::averageBusyTime() const
+{
+    return this->average_;
+}
+
+int AnimationBudget::frameLength() const
+{
+    return this->mode_ == Mode::Full ? fullFrameLength : throttledFrameLength;
+}
+
 void GIFTimer::initialize()
 {
-    this->timer.setInterval(30);
+    this->timer.setInterval(this->budget_.frameLength());
 
     getSettings()->animateEmotes.connect([this](bool enabled, auto) {
         if (enabled)
+        {
+            this->lastTick_.invalidate();
             this->timer.start();
+        }
         else
+        {
             this->timer.stop();
+        }
     });
 
     QObject::connect(&this->timer, &QTimer::timeout, [this] {
-        if (getSettings()->animationsWhenFocused &&
-            qApp->activeWindow() == nullptr)
-            return;
-
-        this->position_ += gifFrameLength;
-        this->signal.invoke();
-        getApp()->windows->repaintGifEmotes();
+        this->tick();
     });
 }
 
+void GIFTimer::tick()
+{
+    // The time the timer fired late is time the GUI thread spent on other
+    // work (layouts, paints of the previous frame, ...).
+    double busyMs = 0;
+    if (this->lastTick_.isValid())
+    {
+        busyMs = std::max<qint64>(
+            0, this->lastTick_.elapsed() - this->timer.interval());
+    }
+    this->lastTick_.start();
+
+    auto throttled =
+        this->budget_.mode() == AnimationBudget::Mode::Throttled;
+    if ((throttled || getSettings()->animationsWhenFocused) &&
+        qApp->activeWindow() == nullptr)
+    {
+        // animations outside of the focused window are paused while
+        // throttled, keep measuring the load so we can resume
+        this->budget_.addFrame(busyMs);
+        this->timer.setInterval(this->budget_.frameLength());
+        return;
+    }
+
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+
+    // throttled ticks skip frames instead of slowing the animations down
+    this->position_ += gifFrameLength * this->timer.interval() /
+                       AnimationBudget::fullFrameLength;
+    this->signal.invoke();
+    getApp()->windows->repaintGifEmotes();
+
+    this->budget_.addFrame(busyMs + paintTimer.elapsed());
+    this->timer.setInterval(this->budget_.frameLength());
+}
+
 }  // namespace chatterino
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QElapsedTimer>
 #include <QTimer>
 #include <pajlada/signals/signal.hpp>
 
@@ -7,6 +8,43 @@ namespace chatterino {
 
 constexpr long unsigned gifFrameLength = 33;
 
+/// Decides how fast animations may run based on how much of each frame the
+/// GUI thread spends busy. Once the average busy time exceeds the budget the
+/// animations are throttled, and they return to full rate after the load has
+/// stayed low for a while.
+class AnimationBudget
+{
+public:
+    enum class Mode {
+        Full,
+        Throttled,
+    };
+
+    /// Frame length while running at full rate (~30 fps)
+    static constexpr int fullFrameLength = 30;
+    /// Frame length while throttled (~15 fps)
+    static constexpr int throttledFrameLength = 2 * fullFrameLength;
+    /// Average busy milliseconds per frame above which we throttle
+    static constexpr double budget = 12.0;
+    /// Average busy milliseconds per frame below which we may resume
+    static constexpr double resumeThreshold = 6.0;
+    /// Number of consecutive calm frames required before resuming
+    static constexpr int resumeFrames = 30;
+
+    /// Records a frame which kept the GUI thread busy for busyMs
+    /// milliseconds and returns the mode the next frames should run in.
+    Mode addFrame(double busyMs);
+
+    Mode mode() const;
+    double averageBusyTime() const;
+    int frameLength() const;
+
+private:
+    Mode mode_ = Mode::Full;
+    double average_ = 0;
+    int calmFrames_ = 0;
+};
+
 class GIFTimer
 {
 public:
@@ -18,8 +56,17 @@ public:
         return this->position_;
     }
 
+    const AnimationBudget &budget() const
+    {
+        return this->budget_;
+    }
+
 private:
+    void tick();
+
     QTimer timer;
+    QElapsedTimer lastTick_;
+    AnimationBudget budget_;
     long unsigned position_{};
 };
 
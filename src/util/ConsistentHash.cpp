@@ -0,0 +1,56 @@
+#include "util/ConsistentHash.hpp"
+
+#include <cstdint>
+
+namespace chatterino {
+
+namespace {
+
+    // FNV-1a, unlike qHash it isn't seeded per process
+    uint64_t hashKey(const QString &key)
+    {
+        uint64_t hash = 14695981039346656037ULL;
+        for (auto c : key)
+        {
+            hash ^= c.unicode();
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // splitmix64 finalizer, spreads the key hash differently for every shard
+    uint64_t mix(uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ULL;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+}  // namespace
+
+int consistentShard(const QString &key, int shardCount)
+{
+    if (shardCount <= 1)
+    {
+        return 0;
+    }
+
+    auto hash = hashKey(key);
+
+    int best = 0;
+    uint64_t bestScore = 0;
+    for (int shard = 0; shard < shardCount; shard++)
+    {
+        auto score = mix(hash ^ mix(uint64_t(shard)));
+        if (shard == 0 || score > bestScore)
+        {
+            best = shard;
+            bestScore = score;
+        }
+    }
+
+    return best;
+}
+
+}  // namespace chatterino
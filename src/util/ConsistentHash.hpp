@@ -0,0 +1,20 @@
+#pragma once
+
+#include <QString>
+
+namespace chatterino {
+
+/**
+ * @brief Picks one of shardCount shards for key
+ *
+ * Uses rendezvous hashing: every shard gets a score derived from the key and
+ * the shard index, the shard with the highest score wins. The result only
+ * depends on the key and the shard count (it's the same across restarts) and
+ * changing the shard count from n to n + 1 only moves the keys that end up on
+ * the new shard.
+ *
+ * Returns 0 if shardCount is 1 or less.
+ **/
+int consistentShard(const QString &key, int shardCount);
+
+}  // namespace chatterino
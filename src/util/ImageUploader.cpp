@@ -0,0 +1,431 @@
+#include "util/ImageUploader.hpp"
+
+#include "common/NetworkRequest.hpp"
+#include "common/NetworkResult.hpp"
+#include "common/QLogging.hpp"
+#include "debug/AssertInGuiThread.hpp"
+#include "util/PostToThread.hpp"
+
+#include <QBuffer>
+#include <QFileInfo>
+#include <QHttpMultiPart>
+#include <QJsonValue>
+#include <QNetworkReply>
+#include <QRegularExpression>
+#include <QtConcurrent>
+
+#include <algorithm>
+
+namespace chatterino {
+
+namespace {
+
+    // About 1280x800
+    constexpr qint64 MEDIUM_IMAGE_PIXELS = 1'000'000;
+    // About 2560x1440, a screenshot of a whole screen
+    constexpr qint64 LARGE_IMAGE_PIXELS = 3'500'000;
+
+    const char *const BOUNDARY = "thisistheboudaryasd";
+
+    // Images copied from other programs usually have an alpha channel even
+    // if they don't use it
+    bool hasTransparentPixels(const QImage &image)
+    {
+        if (!image.hasAlphaChannel())
+        {
+            return false;
+        }
+
+        auto argb = image.convertToFormat(QImage::Format_ARGB32);
+        for (int y = 0; y < argb.height(); y++)
+        {
+            auto *line = reinterpret_cast<const QRgb *>(argb.constScanLine(y));
+            for (int x = 0; x < argb.width(); x++)
+            {
+                if (qAlpha(line[x]) != 255)
+                {
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    // extracting link to either image or its deletion from response body
+    QString getJSONValue(QJsonValue responseJson, const QString &jsonPattern)
+    {
+        for (const QString &key : jsonPattern.split("."))
+        {
+            responseJson = responseJson[key];
+        }
+        return responseJson.toString();
+    }
+
+}  // namespace
+
+ImageEncoding chooseImageEncoding(const QSize &size, bool hasAlpha)
+{
+    auto pixels = qint64(size.width()) * size.height();
+
+    if (pixels >= LARGE_IMAGE_PIXELS && !hasAlpha)
+    {
+        return {"jpeg", 90};
+    }
+
+    if (pixels >= MEDIUM_IMAGE_PIXELS)
+    {
+        // Fast compression, most of these are screenshots of single windows.
+        // Qt maps this to zlib level 1, 90 and above would store the image
+        // uncompressed.
+        return {"png", 80};
+    }
+
+    return {"png", 50};
+}
+
+boost::optional<RawImageData> encodeImage(const QImage &image,
+                                          const QString &filePath)
+{
+    if (image.isNull())
+    {
+        return boost::none;
+    }
+
+    auto encoding =
+        chooseImageEncoding(image.size(), hasTransparentPixels(image));
+
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, encoding.format, encoding.quality))
+    {
+        return boost::none;
+    }
+
+    return RawImageData{data, encoding.format, filePath};
+}
+
+QString getLinkFromResponse(const NetworkResult &response, QString pattern)
+{
+    QRegularExpression regExp("{(.+)}",
+                              QRegularExpression::InvertedGreedinessOption);
+    auto match = regExp.match(pattern);
+
+    while (match.hasMatch())
+    {
+        pattern.replace(match.captured(0),
+                        getJSONValue(response.parseJson(), match.captured(1)));
+        match = regExp.match(pattern);
+    }
+    return pattern;
+}
+
+ImageUploader::ImageUploader(OptionsFunction options)
+    : options_(std::move(options))
+{
+}
+
+int ImageUploader::add(RawImageData data)
+{
+    auto name = data.filePath.isEmpty() ? data.format
+                                        : QFileInfo(data.filePath).fileName();
+    auto id = this->addEntry(name, State::Queued, std::move(data));
+
+    this->startUploads();
+
+    return id;
+}
+
+int ImageUploader::add(QImage image, QString filePath)
+{
+    auto name = filePath.isEmpty() ? QString("image")
+                                   : QFileInfo(filePath).fileName();
+    auto id = this->addEntry(name, State::Encoding);
+
+    std::weak_ptr<ImageUploader> weak = this->shared_from_this();
+    QtConcurrent::run([weak, id, image = std::move(image),
+                       filePath = std::move(filePath)] {
+        auto data = encodeImage(image, filePath);
+
+        postToThread([weak, id, data = std::move(data)] {
+            if (auto self = weak.lock())
+            {
+                self->encoded(id, data);
+            }
+        });
+    });
+
+    return id;
+}
+
+int ImageUploader::addFile(QString filePath)
+{
+    auto id = this->addEntry(QFileInfo(filePath).fileName(), State::Encoding);
+
+    std::weak_ptr<ImageUploader> weak = this->shared_from_this();
+    QtConcurrent::run([weak, id, filePath = std::move(filePath)] {
+        auto data = encodeImage(QImage(filePath), filePath);
+
+        postToThread([weak, id, data = std::move(data)] {
+            if (auto self = weak.lock())
+            {
+                self->encoded(id, data);
+            }
+        });
+    });
+
+    return id;
+}
+
+void ImageUploader::retry()
+{
+    assertInGuiThread();
+
+    for (auto &entry : this->entries_)
+    {
+        if (entry.state == State::Failed)
+        {
+            entry.state = State::Queued;
+            entry.progress = 0;
+        }
+    }
+
+    this->itemsChanged.invoke();
+    this->startUploads();
+}
+
+void ImageUploader::clear()
+{
+    assertInGuiThread();
+
+    this->entries_.erase(
+        std::remove_if(this->entries_.begin(), this->entries_.end(),
+                       [](const Entry &entry) {
+                           return entry.state != State::Uploading;
+                       }),
+        this->entries_.end());
+
+    this->itemsChanged.invoke();
+}
+
+std::vector<ImageUploader::Item> ImageUploader::items() const
+{
+    std::vector<Item> items;
+    items.reserve(this->entries_.size());
+
+    for (const auto &entry : this->entries_)
+    {
+        items.push_back({entry.id, entry.name, entry.state, entry.progress});
+    }
+
+    return items;
+}
+
+bool ImageUploader::hasFailed() const
+{
+    return std::any_of(this->entries_.begin(), this->entries_.end(),
+                       [](const Entry &entry) {
+                           return entry.state == State::Failed;
+                       });
+}
+
+ImageUploader::Entry *ImageUploader::find(int id)
+{
+    auto it = std::find_if(this->entries_.begin(), this->entries_.end(),
+                           [id](const Entry &entry) {
+                               return entry.id == id;
+                           });
+
+    return it == this->entries_.end() ? nullptr : &*it;
+}
+
+void ImageUploader::remove(int id)
+{
+    this->entries_.erase(
+        std::remove_if(this->entries_.begin(), this->entries_.end(),
+                       [id](const Entry &entry) {
+                           return entry.id == id;
+                       }),
+        this->entries_.end());
+}
+
+int ImageUploader::addEntry(QString name, State state, RawImageData data)
+{
+    assertInGuiThread();
+
+    auto id = this->nextId_++;
+    this->entries_.push_back({id, std::move(name), state, 0, std::move(data)});
+    this->itemsChanged.invoke();
+
+    return id;
+}
+
+void ImageUploader::encoded(int id, boost::optional<RawImageData> data)
+{
+    auto *entry = this->find(id);
+    if (entry == nullptr)
+    {
+        // Cleared while encoding
+        return;
+    }
+
+    if (!data)
+    {
+        this->remove(id);
+        this->itemsChanged.invoke();
+        this->failed.invoke(Error{id, "Couldn't encode image"});
+        return;
+    }
+
+    entry->data = std::move(*data);
+    entry->state = State::Queued;
+    this->itemsChanged.invoke();
+
+    this->startUploads();
+}
+
+void ImageUploader::startUploads()
+{
+    if (this->hasFailed())
+    {
+        // Wait for retry()
+        return;
+    }
+
+    auto maxUploads = std::max(1, this->options_().maxConcurrentUploads);
+
+    // Images that are still being encoded keep their place in the queue
+    for (auto &entry : this->entries_)
+    {
+        if (this->uploading_ >= maxUploads)
+        {
+            break;
+        }
+        if (entry.state == State::Encoding)
+        {
+            break;
+        }
+        if (entry.state == State::Queued)
+        {
+            this->upload(entry);
+        }
+    }
+}
+
+void ImageUploader::upload(Entry &entry)
+{
+    auto options = this->options_();
+
+    entry.state = State::Uploading;
+    entry.progress = 0;
+    this->uploading_++;
+    this->itemsChanged.invoke();
+
+    const static QString contentType =
+        QString("multipart/form-data; boundary=%1").arg(BOUNDARY);
+
+    auto *payload = new QHttpMultiPart(QHttpMultiPart::FormDataType);
+    QHttpPart part;
+    part.setBody(entry.data.data);
+    part.setHeader(QNetworkRequest::ContentTypeHeader,
+                   QString("image/%1").arg(entry.data.format));
+    part.setHeader(QNetworkRequest::ContentLengthHeader,
+                   QVariant(entry.data.data.length()));
+    part.setHeader(QNetworkRequest::ContentDispositionHeader,
+                   QString("form-data; name=\"%1\"; filename=\"control_v.%2\"")
+                       .arg(options.formField)
+                       .arg(entry.data.format));
+    payload->setBoundary(BOUNDARY);
+    payload->append(part);
+
+    std::weak_ptr<ImageUploader> weak = this->shared_from_this();
+    auto id = entry.id;
+
+    NetworkRequest(options.url, NetworkRequestType::Post)
+        .header("Content-Type", contentType)
+        .headerList(options.headers)
+        .multiPart(payload)
+        .onReplyCreated([weak, id](QNetworkReply *reply) {
+            // Called on the network thread
+            QObject::connect(reply, &QNetworkReply::uploadProgress,
+                             [weak, id](qint64 sent, qint64 total) {
+                                 postToThread([weak, id, sent, total] {
+                                     if (auto self = weak.lock())
+                                     {
+                                         self->uploadProgress(id, sent, total);
+                                     }
+                                 });
+                             });
+        })
+        .onSuccess([weak, id, filePath = entry.data.filePath,
+                    linkPattern = options.linkPattern,
+                    deletionLinkPattern =
+                        options.deletionLinkPattern](NetworkResult result)
+                       -> Outcome {
+            auto self = weak.lock();
+            if (!self)
+            {
+                return Failure;
+            }
+
+            QString link = linkPattern.isEmpty()
+                               ? QString(result.getData())
+                               : getLinkFromResponse(result, linkPattern);
+            QString deletionLink =
+                deletionLinkPattern.isEmpty()
+                    ? QString()
+                    : getLinkFromResponse(result, deletionLinkPattern);
+            qCDebug(chatterinoNuulsuploader) << link << deletionLink;
+
+            self->uploadFinished(id, {id, link, deletionLink, filePath});
+            return Success;
+        })
+        .onError([weak, id](NetworkResult result) {
+            if (auto self = weak.lock())
+            {
+                self->uploadFailed(id,
+                                   QString("Error %1").arg(result.status()));
+            }
+        })
+        .execute();
+}
+
+void ImageUploader::uploadProgress(int id, qint64 sent, qint64 total)
+{
+    auto *entry = this->find(id);
+    if (entry == nullptr || entry->state != State::Uploading || total <= 0)
+    {
+        return;
+    }
+
+    entry->progress = float(sent) / float(total);
+    this->itemsChanged.invoke();
+}
+
+void ImageUploader::uploadFinished(int id, Result result)
+{
+    this->uploading_--;
+
+    this->remove(id);
+    this->itemsChanged.invoke();
+    this->uploaded.invoke(result);
+
+    this->startUploads();
+}
+
+void ImageUploader::uploadFailed(int id, QString message)
+{
+    this->uploading_--;
+
+    if (auto *entry = this->find(id))
+    {
+        // Keep the encoded image around for retry()
+        entry->state = State::Failed;
+        entry->progress = 0;
+    }
+    this->itemsChanged.invoke();
+    this->failed.invoke(Error{id, message});
+}
+
+}  // namespace chatterino
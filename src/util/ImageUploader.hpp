@@ -0,0 +1,153 @@
+#pragma once
+
+#include <QByteArray>
+#include <QImage>
+#include <QSize>
+#include <QString>
+#include <QUrl>
+#include <boost/optional.hpp>
+#include <pajlada/signals/signal.hpp>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+class NetworkResult;
+
+struct RawImageData {
+    QByteArray data;
+    QString format;
+    QString filePath;
+};
+
+struct ImageEncoding {
+    const char *format;
+    // Passed to QImage::save. For PNG this only trades speed for size, Qt
+    // uses zlib level (100 - quality) * 9 / 91.
+    int quality;
+};
+
+// Screenshots of a whole screen are large and opaque, JPEG encodes them much
+// faster and smaller than PNG. Everything else stays lossless.
+ImageEncoding chooseImageEncoding(const QSize &size, bool hasAlpha);
+
+// Encodes an image with the encoding picked by chooseImageEncoding. Safe to
+// call on any thread.
+boost::optional<RawImageData> encodeImage(const QImage &image,
+                                          const QString &filePath = QString());
+
+// Replaces every {json.path} in pattern with the value at that path in the
+// JSON response
+QString getLinkFromResponse(const NetworkResult &response, QString pattern);
+
+/**
+ * @brief Encodes and uploads images in the background
+ *
+ * Images are encoded on the global thread pool, so pasting a batch of
+ * screenshots doesn't block the GUI thread. Up to maxConcurrentUploads
+ * images are uploaded at the same time, in the order they were added.
+ *
+ * If an upload fails, the image stays in the queue and no further uploads
+ * are started (the next one would most likely fail as well) until retry()
+ * is called.
+ *
+ * Must only be used from the GUI thread. Create it with std::make_shared,
+ * pending callbacks only hold a weak reference to it.
+ **/
+class ImageUploader : public std::enable_shared_from_this<ImageUploader>
+{
+public:
+    struct Options {
+        QUrl url;
+        QString formField = "attachment";
+        std::vector<std::pair<QByteArray, QByteArray>> headers;
+        // Link to the image, extracted from the response with
+        // getLinkFromResponse. The whole response is used if this is empty.
+        QString linkPattern;
+        QString deletionLinkPattern;
+        int maxConcurrentUploads = 2;
+    };
+    using OptionsFunction = std::function<Options()>;
+
+    enum class State {
+        Encoding,
+        Queued,
+        Uploading,
+        Failed,
+    };
+
+    struct Item {
+        int id;
+        // File name or, for pasted images, the format
+        QString name;
+        State state;
+        // From 0 to 1, only meaningful while uploading
+        float progress;
+    };
+
+    struct Result {
+        int id;
+        QString link;
+        QString deletionLink;
+        QString filePath;
+    };
+
+    struct Error {
+        int id;
+        QString message;
+    };
+
+    // options is called for every upload, so changes to the uploader
+    // settings apply to queued images
+    explicit ImageUploader(OptionsFunction options);
+
+    // Queues an already encoded image (e.g. a GIF or pasted PNG data)
+    int add(RawImageData data);
+    // Encodes the image on a worker thread before queueing it
+    int add(QImage image, QString filePath = QString());
+    // Loads and encodes the image file on a worker thread
+    int addFile(QString filePath);
+
+    // Requeues all failed images and resumes uploading
+    void retry();
+    // Removes all images that aren't being uploaded right now
+    void clear();
+
+    // All images that haven't been uploaded yet, in order
+    std::vector<Item> items() const;
+    bool hasFailed() const;
+
+    pajlada::Signals::NoArgSignal itemsChanged;
+    pajlada::Signals::Signal<Result> uploaded;
+    pajlada::Signals::Signal<Error> failed;
+
+private:
+    struct Entry {
+        int id;
+        QString name;
+        State state;
+        float progress = 0;
+        RawImageData data;
+    };
+
+    Entry *find(int id);
+    void remove(int id);
+    int addEntry(QString name, State state, RawImageData data = {});
+    void encoded(int id, boost::optional<RawImageData> data);
+    void startUploads();
+    void upload(Entry &entry);
+    void uploadProgress(int id, qint64 sent, qint64 total);
+    void uploadFinished(int id, Result result);
+    void uploadFailed(int id, QString message);
+
+    OptionsFunction options_;
+    std::deque<Entry> entries_;
+    int nextId_ = 1;
+    int uploading_ = 0;
+};
+
+}  // namespace chatterino
@@ -0,0 +1,92 @@
+#include "util/InternString.hpp"
+
+#include "util/QStringHash.hpp"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <unordered_set>
+
+namespace chatterino {
+
+namespace {
+
+    // Strings are distributed over a few shards so builders on different
+    // threads rarely wait for each other
+    constexpr size_t SHARD_COUNT = 16;
+    constexpr size_t INITIAL_PRUNE_THRESHOLD = 4096;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<QString> strings;
+        size_t pruneThreshold = INITIAL_PRUNE_THRESHOLD;
+
+        // Removes all strings that are only referenced by this table
+        void prune()
+        {
+            for (auto it = this->strings.begin(); it != this->strings.end();)
+            {
+                if (it->isDetached())
+                {
+                    it = this->strings.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            // If most strings are still in use, give the table more room
+            // before we try again
+            this->pruneThreshold =
+                std::max(INITIAL_PRUNE_THRESHOLD, this->strings.size() * 2);
+        }
+    };
+
+    std::array<Shard, SHARD_COUNT> &shards()
+    {
+        static std::array<Shard, SHARD_COUNT> instance;
+        return instance;
+    }
+
+}  // namespace
+
+QString internString(const QString &string)
+{
+    if (string.isEmpty())
+    {
+        return QString();
+    }
+
+    auto &shard = shards()[qHash(string) % SHARD_COUNT];
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.strings.find(string);
+    if (it != shard.strings.end())
+    {
+        return *it;
+    }
+
+    if (shard.strings.size() >= shard.pruneThreshold)
+    {
+        shard.prune();
+    }
+
+    return *shard.strings.insert(string).first;
+}
+
+size_t internedStringCount()
+{
+    size_t count = 0;
+
+    for (auto &shard : shards())
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        count += shard.strings.size();
+    }
+
+    return count;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QString>
+
+namespace chatterino {
+
+/**
+ * @brief Returns a string that shares its data with all equal strings that
+ *        were interned before
+ *
+ * QString is implicitly shared, so a Message storing an interned login name,
+ * display name or badge key doesn't allocate its own copy of it. Repeat
+ * chatters then cost a reference count increment instead of a heap
+ * allocation per message.
+ *
+ * Strings that are no longer referenced by anything but the intern table are
+ * pruned once the table grows past its current capacity.
+ *
+ * Thread-safe.
+ **/
+QString internString(const QString &string);
+
+// Amount of strings currently held by the intern table
+size_t internedStringCount();
+
+}  // namespace chatterino
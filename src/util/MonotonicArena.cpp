@@ -0,0 +1,93 @@
+#include "util/MonotonicArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace chatterino {
+
+MonotonicArena::MonotonicArena(size_t initialBlockSize)
+    : nextBlockSize_(initialBlockSize)
+{
+}
+
+MonotonicArena::~MonotonicArena()
+{
+    this->clear();
+}
+
+void MonotonicArena::clear()
+{
+    // The list is in reverse order of creation, so objects that were created
+    // later (and might point to earlier ones) are destroyed first
+    for (auto *finalizer = this->finalizers_; finalizer != nullptr;)
+    {
+        auto *next = finalizer->next;
+        finalizer->destroy(finalizer->object);
+        finalizer = next;
+    }
+    this->finalizers_ = nullptr;
+
+    if (this->blocks_.empty())
+    {
+        return;
+    }
+
+    // Keep the largest block, the next fill will most likely need it again
+    auto largest = std::max_element(
+        this->blocks_.begin(), this->blocks_.end(),
+        [](const Block &a, const Block &b) { return a.size < b.size; });
+    Block kept = std::move(*largest);
+
+    this->blocks_.clear();
+    this->blocks_.push_back(std::move(kept));
+
+    this->current_ = this->blocks_.front().data.get();
+    this->remaining_ = this->blocks_.front().size;
+}
+
+void MonotonicArena::release()
+{
+    this->clear();
+
+    this->blocks_.clear();
+    this->current_ = nullptr;
+    this->remaining_ = 0;
+}
+
+size_t MonotonicArena::blockCount() const
+{
+    return this->blocks_.size();
+}
+
+void *MonotonicArena::allocate(size_t size, size_t alignment)
+{
+    auto padding = [&] {
+        auto address = reinterpret_cast<std::uintptr_t>(this->current_);
+        return (alignment - address % alignment) % alignment;
+    };
+
+    if (this->current_ == nullptr || padding() + size > this->remaining_)
+    {
+        // Objects larger than a block get a block of their own
+        auto blockSize = std::max(this->nextBlockSize_, size);
+        this->nextBlockSize_ =
+            std::min(this->nextBlockSize_ * 2, MAX_BLOCK_SIZE);
+
+        // Not value-initialized on purpose, everything placed here gets
+        // constructed anyway
+        this->blocks_.push_back(
+            {std::unique_ptr<char[]>(new char[blockSize]), blockSize});
+        this->current_ = this->blocks_.back().data.get();
+        this->remaining_ = blockSize;
+    }
+
+    auto offset = padding();
+    auto *pointer = this->current_ + offset;
+
+    this->current_ += offset + size;
+    this->remaining_ -= offset + size;
+
+    return pointer;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace chatterino {
+
+/**
+ * @brief Bump allocator for trees of objects that are released together
+ *
+ * Objects are placed into blocks instead of getting one heap allocation each.
+ * Blocks start at initialBlockSize and double in size, so small trees waste
+ * little memory and large ones only need a few blocks. Nothing is freed
+ * individually: clear() destroys all objects (in reverse order of creation)
+ * and keeps the largest block around for reuse, so an arena that is filled
+ * and cleared repeatedly (e.g. on every relayout) settles at zero
+ * allocations.
+ *
+ * Not thread-safe.
+ **/
+class MonotonicArena : boost::noncopyable
+{
+public:
+    explicit MonotonicArena(size_t initialBlockSize = 1024);
+    ~MonotonicArena();
+
+    /**
+     * @brief Constructs a T inside the arena
+     *
+     * The returned object is owned by the arena and must not be deleted.
+     * It lives until clear() is called or the arena is destroyed.
+     **/
+    template <typename T, typename... Args>
+    // clang-format off
+    // clang-format can be enabled once clang-format v11+ has been installed in CI
+    T *create(Args &&...args)
+    // clang-format on
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "Over-aligned types are not supported");
+
+        if constexpr (std::is_trivially_destructible<T>::value)
+        {
+            return new (this->allocate(sizeof(T), alignof(T)))
+                T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            // Reserve the finalizer first so a throwing constructor doesn't
+            // leave a half-registered object behind
+            auto *finalizer = static_cast<Finalizer *>(
+                this->allocate(sizeof(Finalizer), alignof(Finalizer)));
+            auto *object = new (this->allocate(sizeof(T), alignof(T)))
+                T(std::forward<Args>(args)...);
+
+            finalizer->object = object;
+            finalizer->destroy = [](void *pointer) {
+                static_cast<T *>(pointer)->~T();
+            };
+            finalizer->next = this->finalizers_;
+            this->finalizers_ = finalizer;
+
+            return object;
+        }
+    }
+
+    // Destroys all objects created in the arena
+    void clear();
+
+    // Destroys all objects and frees all blocks
+    void release();
+
+    // Amount of blocks currently allocated by the arena
+    size_t blockCount() const;
+
+private:
+    struct Finalizer {
+        void *object;
+        void (*destroy)(void *);
+        Finalizer *next;
+    };
+
+    void *allocate(size_t size, size_t alignment);
+
+    static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    size_t nextBlockSize_;
+    std::vector<Block> blocks_;
+    char *current_ = nullptr;
+    size_t remaining_ = 0;
+
+    Finalizer *finalizers_ = nullptr;
+};
+
+}  // namespace chatterino
@@ -1,47 +1,25 @@
 #include "NuulsUploader.hpp"
 
 #include "common/Env.hpp"
-#include "common/NetworkRequest.hpp"
+#include "common/NetworkCommon.hpp"
+#include "common/QLogging.hpp"
 #include "providers/twitch/TwitchMessageBuilder.hpp"
 #include "singletons/Paths.hpp"
 #include "singletons/Settings.hpp"
 #include "util/CombinePath.hpp"
 
-#include <QBuffer>
-#include <QHttpMultiPart>
+#include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QJsonObject>
 #include <QMimeDatabase>
-#include <QMutex>
+#include <QPointer>
 #include <QSaveFile>
-#include "common/QLogging.hpp"
 
-#define UPLOAD_DELAY 2000
-// Delay between uploads in milliseconds
-
-namespace {
-
-boost::optional<QByteArray> convertToPng(QImage image)
-{
-    QByteArray imageData;
-    QBuffer buf(&imageData);
-    buf.open(QIODevice::WriteOnly);
-    bool success = image.save(&buf, "png");
-    if (success)
-    {
-        return boost::optional<QByteArray>(imageData);
-    }
-    else
-    {
-        return boost::optional<QByteArray>(boost::none);
-    }
-}
-}  // namespace
+#include <algorithm>
+#include <unordered_map>
 
 namespace chatterino {
-// These variables are only used from the main thread.
-static auto uploadMutex = QMutex();
-static std::queue<RawImageData> uploadQueue;
 
 // logging information on successful uploads to a json file
 void logToFile(const QString originalFilePath, QString imageLink,
@@ -93,137 +71,211 @@ void logToFile(const QString originalFilePath, QString imageLink,
     logSaveFile.commit();
 }
 
-// extracting link to either image or its deletion from response body
-QString getJSONValue(QJsonValue responseJson, QString jsonPattern)
-{
-    for (const QString &key : jsonPattern.split("."))
+namespace {
+
+    struct UploadTarget {
+        ChannelPtr channel;
+        QPointer<ResizingTextEdit> textEdit;
+    };
+
+    // Only used from the main thread
+    std::unordered_map<int, UploadTarget> uploadTargets;
+
+    ImageUploader::Options uploaderOptions()
     {
-        responseJson = responseJson[key];
+        ImageUploader::Options options;
+        options.url =
+            QUrl(getSettings()->imageUploaderUrl.getValue().isEmpty()
+                     ? getSettings()->imageUploaderUrl.getDefaultValue()
+                     : getSettings()->imageUploaderUrl);
+        options.formField =
+            getSettings()->imageUploaderFormField.getValue().isEmpty()
+                ? getSettings()->imageUploaderFormField.getDefaultValue()
+                : getSettings()->imageUploaderFormField;
+        options.headers =
+            parseHeaderList(getSettings()->imageUploaderHeaders.getValue());
+        options.linkPattern = getSettings()->imageUploaderLink;
+        options.deletionLinkPattern = getSettings()->imageUploaderDeletionLink;
+        return options;
     }
-    return responseJson.toString();
-}
 
-QString getLinkFromResponse(NetworkResult response, QString pattern)
-{
-    QRegularExpression regExp("{(.+)}",
-                              QRegularExpression::InvertedGreedinessOption);
-    auto match = regExp.match(pattern);
+    QString statusText(const std::vector<ImageUploader::Item> &items)
+    {
+        QStringList parts;
+        bool failed = false;
+
+        for (const auto &item : items)
+        {
+            auto name = item.name.toHtmlEscaped();
+            switch (item.state)
+            {
+                case ImageUploader::State::Encoding:
+                    parts.append(QString("%1 encoding").arg(name));
+                    break;
+                case ImageUploader::State::Queued:
+                    parts.append(QString("%1 queued").arg(name));
+                    break;
+                case ImageUploader::State::Uploading:
+                    parts.append(QString("%1 %2%")
+                                     .arg(name)
+                                     .arg(int(item.progress * 100)));
+                    break;
+                case ImageUploader::State::Failed:
+                    parts.append(QString("%1 failed").arg(name));
+                    failed = true;
+                    break;
+            }
+        }
+
+        if (parts.isEmpty())
+        {
+            return QString();
+        }
+
+        auto text = "Uploading: " + parts.join(", ");
+        if (failed)
+        {
+            text += " - <a href=\"retry\">retry</a> or "
+                    "<a href=\"cancel\">cancel</a>";
+        }
+        return text;
+    }
 
-    while (match.hasMatch())
+    void updateStatus(ImageUploader &uploader)
     {
-        pattern.replace(match.captured(0),
-                        getJSONValue(response.parseJson(), match.captured(1)));
-        match = regExp.match(pattern);
+        // Every text edit that has images in the queue
+        std::unordered_map<ResizingTextEdit *,
+                           std::vector<ImageUploader::Item>>
+            itemsByTextEdit;
+        for (const auto &target : uploadTargets)
+        {
+            if (target.second.textEdit)
+            {
+                itemsByTextEdit[target.second.textEdit.data()];
+            }
+        }
+
+        for (auto &&item : uploader.items())
+        {
+            auto it = uploadTargets.find(item.id);
+            if (it != uploadTargets.end() && it->second.textEdit)
+            {
+                itemsByTextEdit[it->second.textEdit.data()].push_back(
+                    std::move(item));
+            }
+        }
+
+        for (const auto &pair : itemsByTextEdit)
+        {
+            pair.first->setStatusText(statusText(pair.second));
+        }
     }
-    return pattern;
-}
 
-void uploadImageToNuuls(RawImageData imageData, ChannelPtr channel,
-                        ResizingTextEdit &textEdit)
-{
-    const static char *const boundary = "thisistheboudaryasd";
-    const static QString contentType =
-        QString("multipart/form-data; boundary=%1").arg(boundary);
-    QUrl url(getSettings()->imageUploaderUrl.getValue().isEmpty()
-                 ? getSettings()->imageUploaderUrl.getDefaultValue()
-                 : getSettings()->imageUploaderUrl);
-    QString formField(
-        getSettings()->imageUploaderFormField.getValue().isEmpty()
-            ? getSettings()->imageUploaderFormField.getDefaultValue()
-            : getSettings()->imageUploaderFormField);
-    auto extraHeaders =
-        parseHeaderList(getSettings()->imageUploaderHeaders.getValue());
-    QString originalFilePath = imageData.filePath;
-
-    QHttpMultiPart *payload = new QHttpMultiPart(QHttpMultiPart::FormDataType);
-    QHttpPart part = QHttpPart();
-    part.setBody(imageData.data);
-    part.setHeader(QNetworkRequest::ContentTypeHeader,
-                   QString("image/%1").arg(imageData.format));
-    part.setHeader(QNetworkRequest::ContentLengthHeader,
-                   QVariant(imageData.data.length()));
-    part.setHeader(QNetworkRequest::ContentDispositionHeader,
-                   QString("form-data; name=\"%1\"; filename=\"control_v.%2\"")
-                       .arg(formField)
-                       .arg(imageData.format));
-    payload->setBoundary(boundary);
-    payload->append(part);
-
-    NetworkRequest(url, NetworkRequestType::Post)
-        .header("Content-Type", contentType)
-        .headerList(extraHeaders)
-        .multiPart(payload)
-        .onSuccess([&textEdit, channel,
-                    originalFilePath](NetworkResult result) -> Outcome {
-            QString link = getSettings()->imageUploaderLink.getValue().isEmpty()
-                               ? result.getData()
-                               : getLinkFromResponse(
-                                     result, getSettings()->imageUploaderLink);
-            QString deletionLink =
-                getSettings()->imageUploaderDeletionLink.getValue().isEmpty()
-                    ? ""
-                    : getLinkFromResponse(
-                          result, getSettings()->imageUploaderDeletionLink);
-            qCDebug(chatterinoNuulsuploader) << link << deletionLink;
-            textEdit.insertPlainText(link + " ");
-            if (uploadQueue.empty())
+    // Forgets images that are no longer queued and clears the status text of
+    // text edits that have nothing left to upload
+    void removeTarget(ImageUploader &uploader, int id)
+    {
+        auto it = uploadTargets.find(id);
+        if (it == uploadTargets.end())
+        {
+            return;
+        }
+
+        auto textEdit = it->second.textEdit;
+        uploadTargets.erase(it);
+
+        updateStatus(uploader);
+        if (textEdit &&
+            std::none_of(uploadTargets.begin(), uploadTargets.end(),
+                         [&](const auto &target) {
+                             return target.second.textEdit == textEdit;
+                         }))
+        {
+            textEdit->setStatusText(QString());
+        }
+    }
+
+    std::shared_ptr<ImageUploader> makeUploader()
+    {
+        auto uploader = std::make_shared<ImageUploader>(uploaderOptions);
+        auto &self = *uploader;
+
+        uploader->itemsChanged.connect([&self] {
+            updateStatus(self);
+        });
+
+        uploader->uploaded.connect([&self](ImageUploader::Result result) {
+            auto it = uploadTargets.find(result.id);
+            if (it == uploadTargets.end())
             {
-                channel->addMessage(makeSystemMessage(
-                    QString("Your image has been uploaded to %1 %2.")
-                        .arg(link)
-                        .arg(deletionLink.isEmpty()
-                                 ? ""
-                                 : QString("(Deletion link: %1 )")
-                                       .arg(deletionLink))));
-                uploadMutex.unlock();
+                return;
             }
-            else
+            auto target = it->second;
+
+            if (target.textEdit)
             {
-                channel->addMessage(makeSystemMessage(
-                    QString("Your image has been uploaded to %1 %2. %3 left. "
-                            "Please wait until all of them are uploaded. "
-                            "About %4 seconds left.")
-                        .arg(link)
-                        .arg(deletionLink.isEmpty()
-                                 ? ""
-                                 : QString("(Deletion link: %1 )")
-                                       .arg(deletionLink))
-                        .arg(uploadQueue.size())
-                        .arg(uploadQueue.size() * (UPLOAD_DELAY / 1000 + 1))));
-                // 2 seconds for the timer that's there not to spam the remote server
-                // and 1 second of actual uploading.
-
-                QTimer::singleShot(UPLOAD_DELAY, [channel, &textEdit]() {
-                    uploadImageToNuuls(uploadQueue.front(), channel, textEdit);
-                    uploadQueue.pop();
+                target.textEdit->insertPlainText(result.link + " ");
+            }
+            target.channel->addMessage(makeSystemMessage(
+                QString("Your image has been uploaded to %1 %2.")
+                    .arg(result.link)
+                    .arg(result.deletionLink.isEmpty()
+                             ? ""
+                             : QString("(Deletion link: %1 )")
+                                   .arg(result.deletionLink))));
+            logToFile(result.filePath, result.link, result.deletionLink,
+                      target.channel);
+
+            removeTarget(self, result.id);
+        });
+
+        uploader->failed.connect([&self](ImageUploader::Error error) {
+            auto it = uploadTargets.find(error.id);
+            if (it == uploadTargets.end())
+            {
+                return;
+            }
+            auto target = it->second;
+
+            auto items = self.items();
+            bool queued =
+                std::any_of(items.begin(), items.end(), [&](const auto &item) {
+                    return item.id == error.id;
                 });
+
+            if (queued)
+            {
+                target.channel->addMessage(makeSystemMessage(
+                    QString("An error happened while uploading your image: "
+                            "%1. Your images are still queued, retry or "
+                            "cancel the upload below the input box.")
+                        .arg(error.message)));
             }
+            else
+            {
+                target.channel->addMessage(makeSystemMessage(
+                    QString("Cannot upload image: %1").arg(error.message)));
+                removeTarget(self, error.id);
+            }
+        });
 
-            logToFile(originalFilePath, link, deletionLink, channel);
-
-            return Success;
-        })
-        .onError([channel](NetworkResult result) -> bool {
-            channel->addMessage(makeSystemMessage(
-                QString("An error happened while uploading your image: %1")
-                    .arg(result.status())));
-            uploadMutex.unlock();
-            return true;
-        })
-        .execute();
-}
+        return uploader;
+    }
+
+    ImageUploader &getUploader()
+    {
+        static auto instance = makeUploader();
+        return *instance;
+    }
+
+}  // namespace
 
 void upload(const QMimeData *source, ChannelPtr channel,
             ResizingTextEdit &outputTextEdit)
 {
-    if (!uploadMutex.tryLock())
-    {
-        channel->addMessage(makeSystemMessage(
-            QString("Please wait until the upload finishes.")));
-        return;
-    }
+    auto &uploader = getUploader();
+    std::vector<int> ids;
 
-    channel->addMessage(makeSystemMessage(QString("Started upload...")));
     if (source->hasUrls())
     {
         auto mimeDb = QMimeDatabase();
@@ -233,101 +285,96 @@ void upload(const QMimeData *source, ChannelPtr channel,
         {
             QString localPath = path.toLocalFile();
             QMimeType mime = mimeDb.mimeTypeForUrl(path);
-            if (mime.name().startsWith("image") && !mime.inherits("image/gif"))
-            {
-                channel->addMessage(makeSystemMessage(
-                    QString("Uploading image: %1").arg(localPath)));
-                QImage img = QImage(localPath);
-                if (img.isNull())
-                {
-                    channel->addMessage(
-                        makeSystemMessage(QString("Couldn't load image :(")));
-                    uploadMutex.unlock();
-                    return;
-                }
-
-                boost::optional<QByteArray> imageData = convertToPng(img);
-                if (imageData)
-                {
-                    RawImageData data = {imageData.get(), "png", localPath};
-                    uploadQueue.push(data);
-                }
-                else
-                {
-                    channel->addMessage(makeSystemMessage(
-                        QString("Cannot upload file: %1. Couldn't convert "
-                                "image to png.")
-                            .arg(localPath)));
-                    uploadMutex.unlock();
-                    return;
-                }
-            }
-            else if (mime.inherits("image/gif"))
+            if (mime.inherits("image/gif"))
             {
-                channel->addMessage(makeSystemMessage(
-                    QString("Uploading GIF: %1").arg(localPath)));
                 QFile file(localPath);
                 bool isOkay = file.open(QIODevice::ReadOnly);
                 if (!isOkay)
                 {
-                    channel->addMessage(
-                        makeSystemMessage(QString("Failed to open file. :(")));
-                    uploadMutex.unlock();
-                    return;
+                    channel->addMessage(makeSystemMessage(
+                        QString("Failed to open file: %1").arg(localPath)));
+                    continue;
                 }
-                RawImageData data = {file.readAll(), "gif", localPath};
-                uploadQueue.push(data);
-                file.close();
-                // file.readAll() => might be a bit big but it /should/ work
+                // GIFs are uploaded as they are, re-encoding would drop the
+                // animation
+                ids.push_back(uploader.add({file.readAll(), "gif", localPath}));
+            }
+            else if (mime.name().startsWith("image"))
+            {
+                // Loaded and encoded on a worker thread
+                ids.push_back(uploader.addFile(localPath));
             }
             else
             {
                 channel->addMessage(makeSystemMessage(
                     QString("Cannot upload file: %1. Not an image.")
                         .arg(localPath)));
-                uploadMutex.unlock();
-                return;
             }
         }
-        if (!uploadQueue.empty())
-        {
-            uploadImageToNuuls(uploadQueue.front(), channel, outputTextEdit);
-            uploadQueue.pop();
-        }
     }
     else if (source->hasFormat("image/png"))
     {
         // the path to file is not present every time, thus the filePath is empty
-        uploadImageToNuuls({source->data("image/png"), "png", ""}, channel,
-                           outputTextEdit);
+        ids.push_back(uploader.add({source->data("image/png"), "png", ""}));
     }
     else if (source->hasFormat("image/jpeg"))
     {
-        uploadImageToNuuls({source->data("image/jpeg"), "jpeg", ""}, channel,
-                           outputTextEdit);
+        ids.push_back(uploader.add({source->data("image/jpeg"), "jpeg", ""}));
     }
     else if (source->hasFormat("image/gif"))
     {
-        uploadImageToNuuls({source->data("image/gif"), "gif", ""}, channel,
-                           outputTextEdit);
+        ids.push_back(uploader.add({source->data("image/gif"), "gif", ""}));
     }
-
     else
-    {  // not PNG, try loading it into QImage and save it to a PNG.
-        QImage image = qvariant_cast<QImage>(source->imageData());
-        boost::optional<QByteArray> imageData = convertToPng(image);
-        if (imageData)
-        {
-            uploadImageToNuuls({imageData.get(), "png", ""}, channel,
-                               outputTextEdit);
-        }
-        else
+    {
+        ids.push_back(
+            uploader.add(qvariant_cast<QImage>(source->imageData())));
+    }
+
+    if (ids.empty())
+    {
+        return;
+    }
+
+    for (auto id : ids)
+    {
+        uploadTargets[id] = {channel, &outputTextEdit};
+    }
+    updateStatus(uploader);
+
+    channel->addMessage(makeSystemMessage(
+        uploader.hasFailed()
+            ? QString("Your images are queued, but a previous upload "
+                      "failed. Retry or cancel it below the input box.")
+            : QString("Started upload...")));
+}
+
+void retryUploads()
+{
+    getUploader().retry();
+}
+
+void cancelUploads()
+{
+    auto &uploader = getUploader();
+    uploader.clear();
+
+    auto items = uploader.items();
+    std::vector<int> removed;
+    for (const auto &target : uploadTargets)
+    {
+        if (std::none_of(items.begin(), items.end(), [&](const auto &item) {
+                return item.id == target.first;
+            }))
         {
-            channel->addMessage(makeSystemMessage(
-                QString("Cannot upload file, failed to convert to png.")));
-            uploadMutex.unlock();
+            removed.push_back(target.first);
         }
     }
+
+    for (auto id : removed)
+    {
+        removeTarget(uploader, id);
+    }
 }
 
 }  // namespace chatterino
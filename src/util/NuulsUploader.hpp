@@ -1,20 +1,20 @@
 #include "common/Channel.hpp"
+#include "util/ImageUploader.hpp"
 #include "widgets/helper/ResizingTextEdit.hpp"
 
 #include <QMimeData>
 #include <QString>
 
 namespace chatterino {
-struct RawImageData {
-    QByteArray data;
-    QString format;
-    QString filePath;
-};
 
-void upload(QByteArray imageData, ChannelPtr channel,
-            ResizingTextEdit &textEdit, std::string format);
-void upload(RawImageData imageData, ChannelPtr channel,
-            ResizingTextEdit &textEdit);
+// Queues the images in source for upload. Links are inserted into
+// outputTextEdit once they are uploaded, the progress is shown in its status
+// text.
 void upload(const QMimeData *source, ChannelPtr channel,
             ResizingTextEdit &outputTextEdit);
+// Resumes uploading after an upload failed
+void retryUploads();
+// Drops all images that aren't being uploaded right now
+void cancelUploads();
+
 }  // namespace chatterino
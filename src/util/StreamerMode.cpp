@@ -6,6 +6,7 @@
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Settings.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/PostToThread.hpp"
 #include "widgets/Notebook.hpp"
 #include "widgets/Window.hpp"
 #include "widgets/helper/NotebookTab.hpp"
@@ -19,120 +20,284 @@
 #    pragma comment(lib, "Wtsapi32.lib")
 #endif
 
+#ifdef Q_OS_LINUX
+#    include <dirent.h>
+#endif
+
 #include <QProcess>
+#include <QThread>
+#include <boost/optional.hpp>
 
-namespace chatterino {
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
 
-constexpr int cooldownInS = 10;
+namespace chatterino {
 
-bool shouldShowWarning = true;
+namespace {
 
-const QStringList &broadcastingBinaries()
-{
-#ifdef USEWINSDK
-    static QStringList bins = {"obs.exe", "obs64.exe"};
+#ifdef Q_OS_LINUX
+    // Reading /proc is cheap, so the detection can react quickly
+    constexpr std::chrono::seconds pollInterval(3);
 #else
-    static QStringList bins = {"obs"};
+    constexpr std::chrono::seconds pollInterval(10);
 #endif
-    return bins;
-}
 
-bool isInStreamerMode()
-{
-    switch (getSettings()->enableStreamerMode.getEnum())
+#ifdef Q_OS_LINUX
+    /**
+     * Looks for the binaries in the names of all running processes in
+     * /proc. Returns none if /proc can't be read.
+     **/
+    boost::optional<bool> scanProc(const QStringList &binaries)
     {
-        case StreamerModeSetting::Enabled:
-            return true;
-        case StreamerModeSetting::Disabled:
-            return false;
-        case StreamerModeSetting::DetectObs:
+        DIR *proc = opendir("/proc");
+        if (proc == nullptr)
+        {
+            return boost::none;
+        }
 
-#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
-
-            static bool cache = false;
-            static QDateTime time = QDateTime();
-
-            if (time.isValid() &&
-                time.addSecs(cooldownInS) > QDateTime::currentDateTime())
+        bool found = false;
+        while (!found)
+        {
+            const dirent *entry = readdir(proc);
+            if (entry == nullptr)
             {
-                return cache;
+                break;
             }
-            time = QDateTime::currentDateTime();
 
-            QProcess p;
-            p.start("pgrep", {"-x", broadcastingBinaries().join("|")},
-                    QIODevice::NotOpen);
-
-            if (p.waitForFinished(1000) &&
-                p.exitStatus() == QProcess::NormalExit)
+            // Only the numeric entries are processes
+            if (!std::isdigit(static_cast<unsigned char>(entry->d_name[0])))
             {
-                cache = (p.exitCode() == 0);
-                return (p.exitCode() == 0);
+                continue;
             }
 
-            // Fallback to false and showing a warning
+            // The process might have exited in the meantime, then the file
+            // doesn't exist anymore and name stays empty
+            std::ifstream comm(std::string("/proc/") + entry->d_name +
+                               "/comm");
+            std::string name;
+            std::getline(comm, name);
+
+            found = !name.empty() &&
+                    binaries.contains(QString::fromStdString(name));
+        }
 
-            if (shouldShowWarning)
+        closedir(proc);
+        return found;
+    }
+#endif
+
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+    // Returns none if pgrep couldn't be run
+    boost::optional<bool> runPgrep(const QStringList &binaries)
+    {
+        QProcess p;
+        p.start("pgrep", {"-x", binaries.join("|")}, QIODevice::NotOpen);
+
+        if (p.waitForFinished(1000) && p.exitStatus() == QProcess::NormalExit)
+        {
+            return p.exitCode() == 0;
+        }
+
+        return boost::none;
+    }
+#endif
+
+#ifdef USEWINSDK
+    bool enumerateProcesses(const QStringList &binaries)
+    {
+        if (!IsWindowsVistaOrGreater())
+        {
+            return false;
+        }
+
+        WTS_PROCESS_INFO *pWPIs = nullptr;
+        DWORD dwProcCount = 0;
+        bool found = false;
+
+        if (WTSEnumerateProcesses(WTS_CURRENT_SERVER_HANDLE, NULL, 1, &pWPIs,
+                                  &dwProcCount))
+        {
+            //Go through all processes retrieved
+            for (DWORD i = 0; i < dwProcCount && !found; i++)
             {
-                shouldShowWarning = false;
+                QString processName = QString::fromUtf16(
+                    reinterpret_cast<char16_t *>(pWPIs[i].pProcessName));
 
-                getApp()->twitch->addGlobalSystemMessage(
-                    "Streamer Mode is set to Automatic, but pgrep is missing. "
-                    "Install it to fix the issue or set Streamer Mode to "
-                    "Enabled or Disabled in the Settings.");
+                found = binaries.contains(processName);
             }
+        }
 
-            qCWarning(chatterinoStreamerMode) << "pgrep execution timed out!";
+        if (pWPIs)
+        {
+            WTSFreeMemory(pWPIs);
+        }
 
-            cache = false;
-            return false;
+        return found;
+    }
 #endif
 
-#ifdef USEWINSDK
-            if (!IsWindowsVistaOrGreater())
+    /**
+     * Looks for broadcasting software on its own thread, so that
+     * isInStreamerMode(), which is called while painting and building
+     * messages, only reads an atomic.
+     *
+     * Only polls while the setting is set to DetectObs.
+     **/
+    class BroadcastingDetector
+    {
+    public:
+        BroadcastingDetector()
+            : binaries_(broadcastingBinaries())
+        {
+            this->detecting_ = getSettings()->enableStreamerMode.getEnum() ==
+                               StreamerModeSetting::DetectObs;
+            getSettings()->enableStreamerMode.connect(
+                [this] {
+                    {
+                        std::lock_guard<std::mutex> lock(this->mutex_);
+                        this->detecting_ =
+                            getSettings()->enableStreamerMode.getEnum() ==
+                            StreamerModeSetting::DetectObs;
+                    }
+                    this->wake_.notify_one();
+
+                    streamerModeChanged().invoke();
+                },
+                false);
+
+            // Never stopped, the detector lives until the process exits
+            QThread::create([this] {
+                this->run();
+            })->start(QThread::LowPriority);
+        }
+
+        bool isBroadcasting() const
+        {
+            return this->broadcasting_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        void run()
+        {
+            while (true)
             {
-                return false;
+                {
+                    std::unique_lock<std::mutex> lock(this->mutex_);
+                    this->wake_.wait(lock, [this] {
+                        return this->detecting_;
+                    });
+                }
+
+                this->update(this->detect());
+
+                std::unique_lock<std::mutex> lock(this->mutex_);
+                this->wake_.wait_for(lock, pollInterval);
             }
-            static bool cache = false;
-            static QDateTime time = QDateTime();
+        }
 
-            if (time.isValid() &&
-                time.addSecs(cooldownInS) > QDateTime::currentDateTime())
+        bool detect()
+        {
+#ifdef Q_OS_LINUX
+            if (auto found = scanProc(this->binaries_))
             {
-                return cache;
+                return *found;
             }
-            time = QDateTime::currentDateTime();
+#endif
 
-            WTS_PROCESS_INFO *pWPIs = nullptr;
-            DWORD dwProcCount = 0;
+#if defined(Q_OS_LINUX) || defined(Q_OS_MACOS)
+            if (auto found = runPgrep(this->binaries_))
+            {
+                return *found;
+            }
 
-            if (WTSEnumerateProcesses(WTS_CURRENT_SERVER_HANDLE, NULL, 1,
-                                      &pWPIs, &dwProcCount))
+            // Fallback to false and showing a warning
+            if (this->shouldShowWarning_)
             {
-                //Go through all processes retrieved
-                for (DWORD i = 0; i < dwProcCount; i++)
-                {
-                    QString processName = QString::fromUtf16(
-                        reinterpret_cast<char16_t *>(pWPIs[i].pProcessName));
+                this->shouldShowWarning_ = false;
 
-                    if (broadcastingBinaries().contains(processName))
-                    {
-                        cache = true;
-                        return true;
-                    }
-                }
+                postToThread([] {
+                    getApp()->twitch->addGlobalSystemMessage(
+                        "Streamer Mode is set to Automatic, but pgrep is "
+                        "missing. Install it to fix the issue or set "
+                        "Streamer Mode to Enabled or Disabled in the "
+                        "Settings.");
+                });
             }
 
-            if (pWPIs)
+            qCWarning(chatterinoStreamerMode) << "pgrep execution timed out!";
+            return false;
+#elif defined(USEWINSDK)
+            return enumerateProcesses(this->binaries_);
+#else
+            return false;
+#endif
+        }
+
+        void update(bool broadcasting)
+        {
+            if (this->broadcasting_.exchange(broadcasting) == broadcasting)
             {
-                WTSFreeMemory(pWPIs);
+                return;
             }
 
-            cache = false;
+            qCDebug(chatterinoStreamerMode)
+                << "Broadcasting software running:" << broadcasting;
+
+            postToThread([] {
+                streamerModeChanged().invoke();
+            });
+        }
+
+        const QStringList binaries_;
+        std::atomic<bool> broadcasting_{false};
+        bool shouldShowWarning_ = true;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        bool detecting_ = false;
+    };
+
+    BroadcastingDetector &detector()
+    {
+        static auto *instance = new BroadcastingDetector;
+        return *instance;
+    }
+
+}  // namespace
+
+const QStringList &broadcastingBinaries()
+{
+#ifdef USEWINSDK
+    static QStringList bins = {"obs.exe", "obs64.exe"};
+#else
+    static QStringList bins = {"obs"};
 #endif
+    return bins;
+}
+
+bool isInStreamerMode()
+{
+    switch (getSettings()->enableStreamerMode.getEnum())
+    {
+        case StreamerModeSetting::Enabled:
+            return true;
+        case StreamerModeSetting::Disabled:
             return false;
+        case StreamerModeSetting::DetectObs:
+            return detector().isBroadcasting();
     }
     return false;
 }
 
+pajlada::Signals::NoArgSignal &streamerModeChanged()
+{
+    static pajlada::Signals::NoArgSignal signal;
+    return signal;
+}
+
 }  // namespace chatterino
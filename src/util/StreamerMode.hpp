@@ -1,12 +1,18 @@
 #pragma once
 
 #include <QStringList>
+#include <pajlada/signals/signal.hpp>
 
 namespace chatterino {
 
 enum StreamerModeSetting { Disabled = 0, Enabled = 1, DetectObs = 2 };
 
 const QStringList &broadcastingBinaries();
+
+// Never blocks, the broadcasting software is detected in the background
 bool isInStreamerMode();
 
+// Invoked on the GUI thread when isInStreamerMode() might have changed
+pajlada::Signals::NoArgSignal &streamerModeChanged();
+
 }  // namespace chatterino
@@ -18,7 +18,7 @@
 
 namespace chatterino {
 
-Scrollbar::Scrollbar(ChannelView *parent)
+Scrollbar::Scrollbar(QWidget *parent)
     : BaseWidget(parent)
     , currentValueAnimation_(this, "currentValue_")
 {
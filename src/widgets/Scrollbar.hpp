@@ -11,14 +11,12 @@
 
 namespace chatterino {
 
-class ChannelView;
-
 class Scrollbar : public BaseWidget
 {
     Q_OBJECT
 
 public:
-    Scrollbar(ChannelView *parent = nullptr);
+    Scrollbar(QWidget *parent = nullptr);
 
     void addHighlight(ScrollbarHighlight highlight);
     void addHighlightsAtStart(
@@ -6,46 +6,28 @@
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/hotkeys/HotkeyController.hpp"
 #include "debug/Benchmark.hpp"
-#include "messages/Message.hpp"
-#include "messages/MessageBuilder.hpp"
+#include "messages/Link.hpp"
 #include "providers/twitch/TwitchChannel.hpp"
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Emotes.hpp"
 #include "singletons/WindowManager.hpp"
+#include "util/PostToThread.hpp"
 #include "widgets/Notebook.hpp"
 #include "widgets/Scrollbar.hpp"
-#include "widgets/helper/ChannelView.hpp"
+#include "widgets/helper/EmoteGrid.hpp"
 #include "widgets/helper/TrimRegExpValidator.hpp"
 
 #include <QAbstractButton>
 #include <QHBoxLayout>
+#include <QPointer>
 #include <QRegularExpression>
 #include <QTabWidget>
+#include <QtConcurrent>
 
 namespace chatterino {
 namespace {
-    auto makeTitleMessage(const QString &title)
+    EmoteGridSection makeSection(const QString &title, const EmoteMap &map)
     {
-        MessageBuilder builder;
-        builder.emplace<TextElement>(title, MessageElementFlag::Text);
-        builder->flags.set(MessageFlag::Centered);
-        return builder.release();
-    }
-    auto makeEmoteMessage(const EmoteMap &map,
-                          const MessageElementFlag &emoteFlag)
-    {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-
-        if (map.empty())
-        {
-            builder.emplace<TextElement>("no emotes available",
-                                         MessageElementFlag::Text,
-                                         MessageColor::System);
-            return builder.release();
-        }
-
         std::vector<std::pair<EmoteName, EmotePtr>> vec(map.begin(), map.end());
         std::sort(vec.begin(), vec.end(),
                   [](const std::pair<EmoteName, EmotePtr> &l,
@@ -53,41 +35,43 @@ namespace {
                       return CompletionModel::compareStrings(l.first.string,
                                                              r.first.string);
                   });
+
+        EmoteGridSection section{title, {}, {}};
+        section.items.reserve(vec.size());
         for (const auto &emote : vec)
         {
-            builder
-                .emplace<EmoteElement>(
-                    emote.second,
-                    MessageElementFlags{MessageElementFlag::AlwaysShow,
-                                        emoteFlag})
-                ->setLink(Link(Link::InsertText, emote.first.string));
+            section.items.push_back(
+                {emote.first.string, emote.first.string, {}, emote.second});
         }
 
-        return builder.release();
+        return section;
     }
-    auto makeEmojiMessage(EmojiMap &emojiMap)
+    EmoteGridSection makeEmojiSection(const QString &title,
+                                      EmojiMap &emojiMap)
     {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-
-        emojiMap.each([&builder](const auto &key, const auto &value) {
-            builder
-                .emplace<EmoteElement>(
-                    value->emote,
-                    MessageElementFlags{MessageElementFlag::AlwaysShow,
-                                        MessageElementFlag::EmojiAll})
-                ->setLink(Link(Link::Type::InsertText,
-                               ":" + value->shortCodes[0] + ":"));
+        EmoteGridSection section{title, {}, {}};
+
+        emojiMap.each([&section](const auto &key, const auto &value) {
+            section.items.push_back({value->shortCodes[0],
+                                     ":" + value->shortCodes[0] + ":",
+                                     {},
+                                     value->emote});
         });
 
-        return builder.release();
+        return section;
+    }
+    EmotePtr resolveTwitchEmote(const EmoteGridItem &item)
+    {
+        return getApp()->emotes->twitch.getOrCreateEmote(EmoteId{item.id},
+                                                         EmoteName{item.name});
     }
     void addEmoteSets(
-        std::vector<std::shared_ptr<TwitchAccount::EmoteSet>> sets,
-        Channel &globalChannel, Channel &subChannel, QString currentChannelName)
+        const std::vector<std::shared_ptr<TwitchAccount::EmoteSet>> &sets,
+        EmoteGridModel &globalModel, EmoteGridModel &subModel,
+        const QString &currentChannelName)
     {
-        QMap<QString, QPair<bool, std::vector<MessagePtr>>> mapOfSets;
+        // The emotes are only created once their section is shown
+        QMap<QString, QPair<bool, EmoteGridSection>> mapOfSets;
 
         for (const auto &set : sets)
         {
@@ -101,58 +85,37 @@ namespace {
             auto channelName = set->channelName;
             auto text = set->text.isEmpty() ? "Twitch" : set->text;
 
-            // EMOTES
-            MessageBuilder builder;
-            builder->flags.set(MessageFlag::Centered);
-            builder->flags.set(MessageFlag::DisableCompactEmotes);
-
             // If value of map is empty, create init pair and add title.
             if (mapOfSets.find(channelName) == mapOfSets.end())
             {
-                std::vector<MessagePtr> b;
-                b.push_back(makeTitleMessage(text));
-                mapOfSets[channelName] = qMakePair(set->key == "0", b);
+                mapOfSets[channelName] = qMakePair(
+                    set->key == "0",
+                    EmoteGridSection{text, {}, resolveTwitchEmote});
             }
 
+            // EMOTES
+            auto &items = mapOfSets[channelName].second.items;
             for (const auto &emote : set->emotes)
             {
-                builder
-                    .emplace<EmoteElement>(
-                        getApp()->emotes->twitch.getOrCreateEmote(emote.id,
-                                                                  emote.name),
-                        MessageElementFlags{MessageElementFlag::AlwaysShow,
-                                            MessageElementFlag::TwitchEmote})
-                    ->setLink(Link(Link::InsertText, emote.name.string));
+                items.push_back(
+                    {emote.name.string, emote.name.string, emote.id.string});
             }
-
-            mapOfSets[channelName].second.push_back(builder.release());
         }
 
-        // Output to channel all created messages,
-        // That contain title or emotes.
         // Put current channel emotes at the top
-        auto currentChannelPair = mapOfSets[currentChannelName];
-        for (auto message : currentChannelPair.second)
+        auto currentChannelIt = mapOfSets.find(currentChannelName);
+        if (currentChannelIt != mapOfSets.end())
         {
-            subChannel.addMessage(message);
+            subModel.addSection(std::move(currentChannelIt->second));
+            mapOfSets.erase(currentChannelIt);
         }
-        mapOfSets.remove(currentChannelName);
 
-        foreach (auto pair, mapOfSets)
+        for (auto &pair : mapOfSets)
         {
-            auto &channel = pair.first ? globalChannel : subChannel;
-            for (auto message : pair.second)
-            {
-                channel.addMessage(message);
-            }
+            auto &model = pair.first ? globalModel : subModel;
+            model.addSection(std::move(pair.second));
         }
     }
-    void addEmotes(Channel &channel, const EmoteMap &map, const QString &title,
-                   const MessageElementFlag &emoteFlag)
-    {
-        channel.addMessage(makeTitleMessage(title));
-        channel.addMessage(makeEmoteMessage(map, emoteFlag));
-    };
 }  // namespace
 
 EmotePopup::EmotePopup(QWidget *parent)
@@ -192,12 +155,8 @@ EmotePopup::EmotePopup(QWidget *parent)
     };
 
     auto makeView = [&](QString tabTitle, bool addToNotebook = true) {
-        auto view = new ChannelView();
+        auto view = new EmoteGrid();
 
-        view->setOverrideFlags(MessageElementFlags{
-            MessageElementFlag::Default, MessageElementFlag::AlwaysShow,
-            MessageElementFlag::EmoteImages});
-        view->setEnableScrollingToBottom(false);
         view->linkClicked.connect(clicked);
 
         if (addToNotebook)
@@ -209,6 +168,7 @@ EmotePopup::EmotePopup(QWidget *parent)
     };
 
     this->searchView_ = makeView("", false);
+    this->searchView_->setPlaceholderText("no emotes found");
     this->searchView_->hide();
     layout->addWidget(this->searchView_);
 
@@ -221,7 +181,10 @@ EmotePopup::EmotePopup(QWidget *parent)
     this->globalEmotesView_ = makeView("Global");
     this->viewEmojis_ = makeView("Emojis");
 
-    this->loadEmojis(*this->viewEmojis_, getApp()->emotes->emojis.emojis);
+    this->subEmotesView_->setPlaceholderText(
+        "no subscription emotes available");
+
+    this->loadEmojis();
     this->addShortcuts();
     this->signalHolder_.managedConnect(getApp()->hotkeys->onItemsUpdated,
                                        [this]() {
@@ -292,10 +255,14 @@ void EmotePopup::addShortcuts()
                  return "scrollPage hotkey called without arguments!";
              }
              auto direction = arguments.at(0);
-             auto channelView = dynamic_cast<ChannelView *>(
-                 this->notebook_->getSelectedPage());
+             auto grid =
+                 dynamic_cast<EmoteGrid *>(this->notebook_->getSelectedPage());
+             if (grid == nullptr)
+             {
+                 return "";
+             }
 
-             auto &scrollbar = channelView->getScrollBar();
+             auto &scrollbar = grid->getScrollBar();
              if (direction == "up")
              {
                  scrollbar.offset(-scrollbar.getLargeChange());
@@ -339,117 +306,64 @@ void EmotePopup::loadChannel(ChannelPtr channel)
         return;
     }
 
-    auto subChannel = std::make_shared<Channel>("", Channel::Type::None);
-    auto globalChannel = std::make_shared<Channel>("", Channel::Type::None);
-    auto channelChannel = std::make_shared<Channel>("", Channel::Type::None);
+    EmoteGridModel subModel;
+    EmoteGridModel globalModel;
+    EmoteGridModel channelModel;
+    EmoteGridModel searchModel;
+
+    const auto &emoteSets =
+        getApp()->accounts->twitch.getCurrent()->accessEmotes()->emoteSets;
+    const auto &bttvGlobal = *getApp()->twitch->getBttvEmotes().emotes();
+    const auto &ffzGlobal = *getApp()->twitch->getFfzEmotes().emotes();
+    const auto &bttvChannel = *this->twitchChannel_->bttvEmotes();
+    const auto &ffzChannel = *this->twitchChannel_->ffzEmotes();
 
     // twitch
-    addEmoteSets(
-        getApp()->accounts->twitch.getCurrent()->accessEmotes()->emoteSets,
-        *globalChannel, *subChannel, this->channel_->getName());
+    addEmoteSets(emoteSets, globalModel, subModel, this->channel_->getName());
+    addEmoteSets(emoteSets, searchModel, searchModel,
+                 this->channel_->getName());
 
     // global
-    addEmotes(*globalChannel, *getApp()->twitch->getBttvEmotes().emotes(),
-              "BetterTTV", MessageElementFlag::BttvEmote);
-    addEmotes(*globalChannel, *getApp()->twitch->getFfzEmotes().emotes(),
-              "FrankerFaceZ", MessageElementFlag::FfzEmote);
+    globalModel.addSection(makeSection("BetterTTV", bttvGlobal));
+    globalModel.addSection(makeSection("FrankerFaceZ", ffzGlobal));
+    searchModel.addSection(makeSection("BetterTTV (Global)", bttvGlobal));
+    searchModel.addSection(makeSection("FrankerFaceZ (Global)", ffzGlobal));
 
     // channel
-    addEmotes(*channelChannel, *this->twitchChannel_->bttvEmotes(), "BetterTTV",
-              MessageElementFlag::BttvEmote);
-    addEmotes(*channelChannel, *this->twitchChannel_->ffzEmotes(),
-              "FrankerFaceZ", MessageElementFlag::FfzEmote);
+    channelModel.addSection(makeSection("BetterTTV", bttvChannel));
+    channelModel.addSection(makeSection("FrankerFaceZ", ffzChannel));
+    searchModel.addSection(makeSection("BetterTTV (Channel)", bttvChannel));
+    searchModel.addSection(makeSection("FrankerFaceZ (Channel)", ffzChannel));
 
-    this->globalEmotesView_->setChannel(globalChannel);
-    this->subEmotesView_->setChannel(subChannel);
-    this->channelEmotesView_->setChannel(channelChannel);
-
-    if (subChannel->getMessageSnapshot().size() == 0)
-    {
-        MessageBuilder builder;
-        builder->flags.set(MessageFlag::Centered);
-        builder->flags.set(MessageFlag::DisableCompactEmotes);
-        builder.emplace<TextElement>("no subscription emotes available",
-                                     MessageElementFlag::Text,
-                                     MessageColor::System);
-        subChannel->addMessage(builder.release());
-    }
-}
-
-void EmotePopup::loadEmojis(ChannelView &view, EmojiMap &emojiMap)
-{
-    ChannelPtr emojiChannel(new Channel("", Channel::Type::None));
-    emojiChannel->addMessage(makeEmojiMessage(emojiMap));
+    // emojis
+    searchModel.addSection(
+        makeEmojiSection("Emojis", getApp()->emotes->emojis.emojis));
 
-    view.setChannel(emojiChannel);
-}
+    this->globalEmotesView_->setModel(std::move(globalModel));
+    this->subEmotesView_->setModel(std::move(subModel));
+    this->channelEmotesView_->setModel(std::move(channelModel));
 
-void EmotePopup::loadEmojis(Channel &channel, EmojiMap &emojiMap,
-                            const QString &title)
-{
-    channel.addMessage(makeTitleMessage(title));
-    channel.addMessage(makeEmojiMessage(emojiMap));
+    this->searchModel_ = std::move(searchModel);
+    this->filterEmotes(this->search_->text());
 }
 
-void EmotePopup::filterTwitchEmotes(std::shared_ptr<Channel> searchChannel,
-                                    const QString &searchText)
+void EmotePopup::loadEmojis()
 {
-    auto twitchEmoteSets =
-        getApp()->accounts->twitch.getCurrent()->accessEmotes()->emoteSets;
-    std::vector<std::shared_ptr<TwitchAccount::EmoteSet>> twitchGlobalEmotes{};
-
-    for (const auto &set : twitchEmoteSets)
-    {
-        auto setCopy = std::make_shared<TwitchAccount::EmoteSet>(*set);
-        auto setIt =
-            std::remove_if(setCopy->emotes.begin(), setCopy->emotes.end(),
-                           [searchText](auto &emote) {
-                               return !emote.name.string.contains(
-                                   searchText, Qt::CaseInsensitive);
-                           });
-        setCopy->emotes.resize(std::distance(setCopy->emotes.begin(), setIt));
-
-        if (setCopy->emotes.size() > 0)
-            twitchGlobalEmotes.push_back(setCopy);
-    }
-
-    auto bttvGlobalEmotes = this->filterEmoteMap(
-        searchText, getApp()->twitch->getBttvEmotes().emotes());
-    auto ffzGlobalEmotes = this->filterEmoteMap(
-        searchText, getApp()->twitch->getFfzEmotes().emotes());
-
-    // twitch
-    addEmoteSets(twitchGlobalEmotes, *searchChannel, *searchChannel,
-                 this->channel_->getName());
+    auto &emojis = getApp()->emotes->emojis.emojis;
 
-    // global
-    if (bttvGlobalEmotes->size() > 0)
-        addEmotes(*searchChannel, *bttvGlobalEmotes, "BetterTTV (Global)",
-                  MessageElementFlag::BttvEmote);
-    if (ffzGlobalEmotes->size() > 0)
-        addEmotes(*searchChannel, *ffzGlobalEmotes, "FrankerFaceZ (Global)",
-                  MessageElementFlag::FfzEmote);
-
-    if (!this->twitchChannel_)
-    {
-        return;
-    }
+    EmoteGridModel model;
+    model.addSection(makeEmojiSection("", emojis));
+    this->viewEmojis_->setModel(std::move(model));
 
-    auto bttvChannelEmotes =
-        this->filterEmoteMap(searchText, this->twitchChannel_->bttvEmotes());
-    auto ffzChannelEmotes =
-        this->filterEmoteMap(searchText, this->twitchChannel_->ffzEmotes());
-    // channel
-    if (bttvChannelEmotes->size() > 0)
-        addEmotes(*searchChannel, *bttvChannelEmotes, "BetterTTV (Channel)",
-                  MessageElementFlag::BttvEmote);
-    if (ffzChannelEmotes->size() > 0)
-        addEmotes(*searchChannel, *ffzChannelEmotes, "FrankerFaceZ (Channel)",
-                  MessageElementFlag::FfzEmote);
+    // Until a Twitch channel is loaded only emojis can be searched
+    this->searchModel_ = EmoteGridModel();
+    this->searchModel_.addSection(makeEmojiSection("Emojis", emojis));
 }
 
 void EmotePopup::filterEmotes(const QString &searchText)
 {
+    auto generation = ++*this->searchGeneration_;
+
     if (searchText.length() == 0)
     {
         this->notebook_->show();
@@ -457,49 +371,36 @@ void EmotePopup::filterEmotes(const QString &searchText)
 
         return;
     }
-    auto searchChannel = std::make_shared<Channel>("", Channel::Type::None);
 
-    // true in special channels like /mentions
-    if (this->channel_->isTwitchChannel())
-    {
-        this->filterTwitchEmotes(searchChannel, searchText);
-    }
+    // The names are compared on a worker thread, a search is cancelled as
+    // soon as the text changes again
+    auto index = this->searchModel_.nameIndex();
+    auto currentGeneration = this->searchGeneration_;
+    QPointer<EmotePopup> self(this);
 
-    EmojiMap filteredEmojis{};
-    int emojiCount = 0;
+    QtConcurrent::run([=] {
+        auto positions = index->search(searchText, [&] {
+            return currentGeneration->load() != generation;
+        });
+        if (!positions)
+        {
+            return;
+        }
 
-    getApp()->emotes->emojis.emojis.each(
-        [&, searchText](const auto &name, std::shared_ptr<EmojiData> &emoji) {
-            if (emoji->shortCodes[0].contains(searchText, Qt::CaseInsensitive))
+        postToThread([=, positions = std::move(*positions)] {
+            if (self == nullptr ||
+                self->searchGeneration_->load() != generation)
             {
-                filteredEmojis.insert(name, emoji);
-                emojiCount++;
+                return;
             }
-        });
-    // emojis
-    if (emojiCount > 0)
-        this->loadEmojis(*searchChannel, filteredEmojis, "Emojis");
-
-    this->searchView_->setChannel(searchChannel);
-
-    this->notebook_->hide();
-    this->searchView_->show();
-}
-
-EmoteMap *EmotePopup::filterEmoteMap(const QString &text,
-                                     std::shared_ptr<const EmoteMap> emotes)
-{
-    auto filteredMap = new EmoteMap();
 
-    for (const auto &emote : *emotes)
-    {
-        if (emote.first.string.contains(text, Qt::CaseInsensitive))
-        {
-            filteredMap->insert(emote);
-        }
-    }
+            self->searchView_->setModel(
+                self->searchModel_.filtered(positions));
 
-    return filteredMap;
+            self->notebook_->hide();
+            self->searchView_->show();
+        });
+    });
 }
 
 void EmotePopup::closeEvent(QCloseEvent *event)
@@ -4,15 +4,18 @@
 #include "providers/twitch/TwitchChannel.hpp"
 #include "widgets/BasePopup.hpp"
 #include "widgets/Notebook.hpp"
+#include "widgets/helper/EmoteGridModel.hpp"
 
 #include <pajlada/signals/signal.hpp>
 
 #include <QLineEdit>
 
+#include <atomic>
+
 namespace chatterino {
 
 struct Link;
-class ChannelView;
+class EmoteGrid;
 class Channel;
 using ChannelPtr = std::shared_ptr<Channel>;
 
@@ -28,15 +31,15 @@ public:
     pajlada::Signals::Signal<Link> linkClicked;
 
 private:
-    ChannelView *globalEmotesView_{};
-    ChannelView *channelEmotesView_{};
-    ChannelView *subEmotesView_{};
-    ChannelView *viewEmojis_{};
+    EmoteGrid *globalEmotesView_{};
+    EmoteGrid *channelEmotesView_{};
+    EmoteGrid *subEmotesView_{};
+    EmoteGrid *viewEmojis_{};
     /**
      * @brief Visible only when the user has specified a search query into the `search_` input.
      * Otherwise the `notebook_` and all other views are visible.
      */
-    ChannelView *searchView_{};
+    EmoteGrid *searchView_{};
 
     ChannelPtr channel_;
     TwitchChannel *twitchChannel_{};
@@ -44,13 +47,15 @@ private:
     QLineEdit *search_;
     Notebook *notebook_;
 
-    void loadEmojis(ChannelView &view, EmojiMap &emojiMap);
-    void loadEmojis(Channel &channel, EmojiMap &emojiMap, const QString &title);
-    void filterTwitchEmotes(std::shared_ptr<Channel> searchChannel,
-                            const QString &searchText);
+    // Everything that can be searched for, with the titles of the search view
+    EmoteGridModel searchModel_;
+    // Incremented for every search and when searchModel_ changes. Searches
+    // on the worker thread stop once it doesn't match their generation.
+    std::shared_ptr<std::atomic<uint64_t>> searchGeneration_ =
+        std::make_shared<std::atomic<uint64_t>>(0);
+
+    void loadEmojis();
     void filterEmotes(const QString &text);
-    EmoteMap *filterEmoteMap(const QString &text,
-                             std::shared_ptr<const EmoteMap> emotes);
     void addShortcuts() override;
 };
 
@@ -89,15 +89,13 @@ namespace {
 
     ChannelPtr filterMessages(const QString &userName, ChannelPtr channel)
     {
-        LimitedQueueSnapshot<MessagePtr> snapshot =
-            channel->getMessageSnapshot();
-
         ChannelPtr channelPtr(
             new Channel(channel->getName(), Channel::Type::None));
 
-        for (size_t i = 0; i < snapshot.size(); i++)
+        // Only looks at the messages related to the user instead of all
+        // messages of the channel
+        for (const auto &message : channel->findMessagesByUser(userName))
         {
-            MessagePtr message = snapshot[i];
             if (checkMessageUserName(userName, message))
             {
                 channelPtr->addMessage(message);
@@ -747,21 +745,19 @@ void UserInfoPopup::updateLatestMessages()
     this->refreshConnection_ =
         std::make_unique<pajlada::Signals::ScopedConnection>(
             this->underlyingChannel_->messageAppended.connect(
-                [this, hasMessages](auto message, auto) {
+                [this](auto message, auto) {
                     if (!checkMessageUserName(this->userName_, message))
                         return;
 
-                    if (hasMessages)
-                    {
-                        // display message in ChannelView
-                        this->ui_.latestMessages->channel()->addMessage(
-                            message);
-                    }
-                    else
+                    // display message in ChannelView
+                    this->ui_.latestMessages->channel()->addMessage(message);
+
+                    if (this->ui_.latestMessages->isHidden())
                     {
-                        // The ChannelView is currently hidden, so manually refresh
-                        // and display the latest messages
-                        this->updateLatestMessages();
+                        // This is the user's first message
+                        this->ui_.latestMessages->show();
+                        this->ui_.noMessagesLabel->hide();
+                        this->adjustSize();
                     }
                 }));
 }
@@ -8,6 +8,7 @@
 #include <QMessageBox>
 #include <QPainter>
 #include <QScreen>
+#include <QtConcurrent>
 #include <algorithm>
 #include <chrono>
 #include <cmath>
@@ -19,7 +20,9 @@
 #include "common/QLogging.hpp"
 #include "controllers/accounts/AccountController.hpp"
 #include "controllers/commands/CommandController.hpp"
+#include "controllers/filters/FilterCache.hpp"
 #include "debug/Benchmark.hpp"
+#include "debug/Trace.hpp"
 #include "messages/Emote.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Message.hpp"
@@ -32,6 +35,7 @@
 #include "providers/twitch/TwitchIrcServer.hpp"
 #include "singletons/Resources.hpp"
 #include "singletons/Settings.hpp"
+#include "singletons/SettingsSnapshot.hpp"
 #include "singletons/Theme.hpp"
 #include "singletons/TooltipPreviewImage.hpp"
 #include "singletons/WindowManager.hpp"
@@ -40,6 +44,7 @@
 #include "util/Helpers.hpp"
 #include "util/IncognitoBrowser.hpp"
 #include "util/StreamerMode.hpp"
+#include "util/PostToThread.hpp"
 #include "util/Twitch.hpp"
 #include "widgets/Scrollbar.hpp"
 #include "widgets/TooltipWidget.hpp"
@@ -57,6 +62,12 @@
 
 namespace chatterino {
 namespace {
+    // Messages filtered between checks whether the refilter is still needed
+    constexpr size_t REFILTER_CHUNK_SIZE = 256;
+    // Messages materialized per event loop iteration when a view with a
+    // large backlog is resumed. The first chunk also fills the view.
+    constexpr size_t MATERIALIZE_CHUNK_SIZE = 100;
+
     void addEmoteContextMenuItems(const Emote &emote,
                                   MessageElementFlags creatorFlags, QMenu &menu)
     {
@@ -147,6 +158,22 @@ ChannelView::ChannelView(BaseWidget *parent)
         crossPlatformCopy(this->getSelectedText());
     });
 
+    this->releaseLayoutsTimer_.setSingleShot(true);
+    this->releaseLayoutsTimer_.setInterval(30 * 1000);
+    QObject::connect(&this->releaseLayoutsTimer_, &QTimer::timeout, this,
+                     [this] {
+                         auto snapshot = this->messages_.getSnapshot();
+                         for (size_t i = 0; i < snapshot.size(); i++)
+                         {
+                             snapshot[i]->deleteCache();
+                         }
+                     });
+
+    this->backfillTimer_.setInterval(0);
+    QObject::connect(&this->backfillTimer_, &QTimer::timeout, this, [this] {
+        this->backfillMessages(MATERIALIZE_CHUNK_SIZE);
+    });
+
     this->clickTimer_ = new QTimer(this);
     this->clickTimer_->setSingleShot(true);
     this->clickTimer_->setInterval(500);
@@ -158,6 +185,11 @@ ChannelView::ChannelView(BaseWidget *parent)
     this->setFocusPolicy(Qt::FocusPolicy::StrongFocus);
 }
 
+ChannelView::~ChannelView()
+{
+    this->cancelRefilter();
+}
+
 void ChannelView::initializeLayout()
 {
     this->goToBottom_ = new EffectLabel(this, 0);
@@ -198,13 +230,16 @@ void ChannelView::initializeSignals()
 
     this->signalHolder_.managedConnect(getApp()->windows->gifRepaintRequested,
                                        [&] {
-                                           this->queueUpdate();
+                                           this->repaintAnimatedImages();
                                        });
 
     this->signalHolder_.managedConnect(
         getApp()->windows->layoutRequested, [&](Channel *channel) {
+            // Callers pass the channel the messages are in, channel_ is
+            // only this view's proxy of it
             if (this->isVisible() &&
-                (channel == nullptr || this->channel_.get() == channel))
+                (channel == nullptr ||
+                 this->underlyingChannel_.get() == channel))
             {
                 this->queueLayout();
             }
@@ -365,8 +400,38 @@ void ChannelView::queueUpdate()
     //    this->updateTimer.start();
 }
 
+void ChannelView::repaintAnimatedImages()
+{
+    if (!this->isVisible())
+    {
+        return;
+    }
+
+    // Messages that didn't change aren't painted again, see drawMessages
+    QRegion region;
+    for (auto &area : this->animatedImages_)
+    {
+        if (area.image->frameIndex() != area.frameIndex)
+        {
+            area.frameIndex = area.image->frameIndex();
+            region += area.rect;
+        }
+    }
+
+    if (!region.isEmpty())
+    {
+        this->update(region);
+    }
+}
+
 void ChannelView::queueLayout()
 {
+    if (this->suspended_)
+    {
+        // performed when the view gets shown again
+        return;
+    }
+
     //    if (!this->layoutCooldown->isActive()) {
     this->performLayout();
 
@@ -378,7 +443,7 @@ void ChannelView::queueLayout()
 
 void ChannelView::performLayout(bool causedByScrollbar)
 {
-    // BenchmarkGuard benchmark("layout");
+    TraceScope trace("ChannelView::performLayout");
 
     /// Get messages and check if there are at least 1
     auto messages = this->getMessagesSnapshot();
@@ -404,6 +469,7 @@ void ChannelView::layoutVisibleMessages(
     const auto layoutWidth = this->getLayoutWidth();
     const auto flags = this->getFlags();
     auto redrawRequired = false;
+    int64_t relayoutCount = 0;
 
     if (messages.size() > start)
     {
@@ -414,13 +480,18 @@ void ChannelView::layoutVisibleMessages(
         {
             auto message = messages[i];
 
-            redrawRequired |=
-                message->layout(layoutWidth, this->scale(), flags);
+            if (message->layout(layoutWidth, this->scale(), flags))
+            {
+                redrawRequired = true;
+                relayoutCount++;
+            }
 
             y += message->getHeight();
         }
     }
 
+    Trace::counter("visible message relayouts", relayoutCount);
+
     if (redrawRequired)
         this->queueUpdate();
 }
@@ -486,6 +557,9 @@ void ChannelView::clearMessages()
 {
     // Clear all stored messages in this chat widget
     this->messages_.clear();
+    this->pendingMessages_.clear();
+    this->backfillMessages_.clear();
+    this->backfillTimer_.stop();
     this->scrollBar_->clearHighlights();
     this->queueLayout();
 
@@ -563,6 +637,8 @@ const boost::optional<MessageElementFlags> &ChannelView::getOverrideFlags()
 
 LimitedQueueSnapshot<MessageLayoutPtr> ChannelView::getMessagesSnapshot()
 {
+    this->materializePendingMessages();
+
     if (!this->paused() /*|| this->scrollBar_->isVisible()*/)
     {
         this->snapshot_ = this->messages_.getSnapshot();
@@ -585,6 +661,7 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
 {
     /// Clear connections from the last channel
     this->channelConnections_.clear();
+    this->cancelRefilter();
 
     this->clearMessages();
     this->scrollBar_->clearHighlights();
@@ -592,6 +669,8 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
     /// make copy of channel and expose
     this->channel_ = std::make_unique<Channel>(underlyingChannel->getName(),
                                                underlyingChannel->getType());
+    // Filters see the live status of the underlying channel
+    this->underlyingChannel_ = underlyingChannel;
 
     //
     // Proxy channel connections
@@ -708,8 +787,6 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
         }
     }
 
-    this->underlyingChannel_ = underlyingChannel;
-
     this->queueLayout();
     this->queueUpdate();
 
@@ -725,7 +802,14 @@ void ChannelView::setChannel(ChannelPtr underlyingChannel)
 
 void ChannelView::setFilters(const QList<QUuid> &ids)
 {
+    auto previousIds = this->getFilterIds();
     this->channelFilters_ = std::make_shared<FilterSet>(ids);
+
+    if (this->underlyingChannel_ &&
+        previousIds != this->channelFilters_->filterIds())
+    {
+        this->refilterMessages();
+    }
 }
 
 const QList<QUuid> ChannelView::getFilterIds() const
@@ -752,12 +836,149 @@ bool ChannelView::shouldIncludeMessage(const MessagePtr &m) const
                 m->loginName, Qt::CaseInsensitive) == 0)
             return true;
 
-        return this->channelFilters_->filter(m, this->channel_);
+        return this->channelFilters_->filter(m, this->underlyingChannel_);
     }
 
     return true;
 }
 
+void ChannelView::refilterMessages()
+{
+    TraceScope trace("ChannelView::refilterMessages");
+
+    this->cancelRefilter();
+
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    this->refilterCancelled_ = cancelled;
+
+    // Everything the worker needs is copied here, it must not touch the view
+    // or any settings
+    auto snapshot = this->underlyingChannel_->getMessageSnapshot();
+    auto filters = this->channelFilters_->filters();
+    QString ownName;
+    if (getSettings()->excludeUserMessagesFromFilter)
+    {
+        ownName = getApp()->accounts->twitch.getCurrent()->getUserName();
+    }
+    auto watchingName = getApp()->twitch->watchingChannel.get()->getName();
+    auto live = filterparser::isChannelLive(this->underlyingChannel_.get());
+
+    QtConcurrent::run([this, cancelled, snapshot, filters, ownName,
+                       watchingName, live] {
+        std::vector<MessagePtr> included;
+
+        for (size_t start = 0; start < snapshot.size();
+             start += REFILTER_CHUNK_SIZE)
+        {
+            // The filters or the channel changed again, this result would
+            // be thrown away anyway
+            if (*cancelled)
+            {
+                return;
+            }
+
+            auto end = std::min(start + REFILTER_CHUNK_SIZE, snapshot.size());
+            for (size_t i = start; i < end; i++)
+            {
+                const auto &message = snapshot[i];
+
+                bool isOwnMessage =
+                    !ownName.isEmpty() &&
+                    ownName.compare(message->loginName,
+                                    Qt::CaseInsensitive) == 0;
+                FilterCache::Context context{
+                    live,
+                    filterparser::isWatchingChannel(message, watchingName),
+                };
+                if (isOwnMessage ||
+                    filterMessage(FilterCache::instance(), filters, message,
+                                  context, [&] {
+                                      return filterparser::buildContextMap(
+                                          message, context.live,
+                                          context.watching);
+                                  }))
+                {
+                    included.push_back(message);
+                }
+            }
+        }
+
+        MessagePtr lastFiltered;
+        if (snapshot.size() > 0)
+        {
+            lastFiltered = snapshot[snapshot.size() - 1];
+        }
+
+        postToThread([this, cancelled, included = std::move(included),
+                      lastFiltered]() mutable {
+            if (*cancelled)
+            {
+                return;
+            }
+            this->applyRefilter(std::move(included), lastFiltered);
+        });
+    });
+}
+
+void ChannelView::cancelRefilter()
+{
+    if (this->refilterCancelled_)
+    {
+        *this->refilterCancelled_ = true;
+        this->refilterCancelled_.reset();
+    }
+}
+
+void ChannelView::applyRefilter(std::vector<MessagePtr> included,
+                                const MessagePtr &lastFiltered)
+{
+    TraceScope trace("ChannelView::applyRefilter");
+
+    this->refilterCancelled_.reset();
+
+    // Messages that arrived while the worker was busy aren't part of its
+    // result yet
+    auto current = this->underlyingChannel_->getMessageSnapshot();
+    size_t newMessagesStart = 0;
+    if (lastFiltered)
+    {
+        newMessagesStart = current.size();
+        for (size_t i = current.size(); i > 0; i--)
+        {
+            if (current[i - 1] == lastFiltered)
+            {
+                newMessagesStart = i;
+                break;
+            }
+        }
+    }
+    for (size_t i = newMessagesStart; i < current.size(); i++)
+    {
+        if (this->shouldIncludeMessage(current[i]))
+        {
+            included.push_back(current[i]);
+        }
+    }
+
+    // Swap out all messages at once, so the old and new filters are never
+    // mixed on screen
+    this->clearMessages();
+    for (const auto &message : included)
+    {
+        if (this->suspended_)
+        {
+            this->addPendingMessage(message);
+        }
+        else
+        {
+            this->addMessageLayout(message);
+        }
+    }
+
+    this->queueLayout();
+    this->queueUpdate();
+}
+
 ChannelPtr ChannelView::sourceChannel() const
 {
     return this->sourceChannel_;
@@ -776,7 +997,7 @@ bool ChannelView::hasSourceChannel() const
 void ChannelView::messageAppended(MessagePtr &message,
                                   boost::optional<MessageFlags> overridingFlags)
 {
-    MessageLayoutPtr deleted;
+    TraceScope trace("ChannelView::messageAppended");
 
     auto *messageFlags = &message->flags;
     if (overridingFlags)
@@ -784,18 +1005,28 @@ void ChannelView::messageAppended(MessagePtr &message,
         messageFlags = overridingFlags.get_ptr();
     }
 
-    auto messageRef = new MessageLayout(message);
-
-    if (this->lastMessageHasAlternateBackground_)
+    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
     {
-        messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
+        if (messageFlags->has(MessageFlag::Highlighted) &&
+            messageFlags->has(MessageFlag::ShowInMentions) &&
+            !messageFlags->has(MessageFlag::Subscription) &&
+            (getSettings()->highlightMentions ||
+             this->channel_->getType() != Channel::Type::TwitchMentions))
+
+        {
+            this->requestTabHighlight(HighlightState::Highlighted);
+        }
+        else
+        {
+            this->requestTabHighlight(HighlightState::NewMessage);
+        }
     }
-    if (this->channel_->shouldIgnoreHighlights())
+
+    if (this->suspended_)
     {
-        messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+        this->addPendingMessage(message);
+        return;
     }
-    this->lastMessageHasAlternateBackground_ =
-        !this->lastMessageHasAlternateBackground_;
 
     if (!this->scrollBar_->isAtBottom() &&
         this->scrollBar_->getCurrentValueAnimation().state() ==
@@ -809,6 +1040,29 @@ void ChannelView::messageAppended(MessagePtr &message,
         loop.exec();
     }
 
+    this->addMessageLayout(message);
+
+    this->messageWasAdded_ = true;
+    this->queueLayout();
+}
+
+void ChannelView::addMessageLayout(const MessagePtr &message)
+{
+    MessageLayoutPtr deleted;
+
+    auto messageRef = new MessageLayout(message);
+
+    if (this->lastMessageHasAlternateBackground_)
+    {
+        messageRef->flags.set(MessageLayoutFlag::AlternateBackground);
+    }
+    if (this->channel_->shouldIgnoreHighlights())
+    {
+        messageRef->flags.set(MessageLayoutFlag::IgnoreHighlights);
+    }
+    this->lastMessageHasAlternateBackground_ =
+        !this->lastMessageHasAlternateBackground_;
+
     if (this->messages_.pushBack(MessageLayoutPtr(messageRef), deleted))
     {
         if (this->paused())
@@ -825,34 +1079,198 @@ void ChannelView::messageAppended(MessagePtr &message,
         }
     }
 
-    if (!messageFlags->has(MessageFlag::DoNotTriggerNotification))
+    if (this->showScrollbarHighlights())
     {
-        if (messageFlags->has(MessageFlag::Highlighted) &&
-            messageFlags->has(MessageFlag::ShowInMentions) &&
-            !messageFlags->has(MessageFlag::Subscription) &&
-            (getSettings()->highlightMentions ||
-             this->channel_->getType() != Channel::Type::TwitchMentions))
+        this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+    }
+}
+
+void ChannelView::addPendingMessage(const MessagePtr &message)
+{
+    MessagePtr deleted;
+    this->pendingMessages_.pushBack(message, deleted);
+}
 
+void ChannelView::requestTabHighlight(HighlightState state)
+{
+    if (this->suspended_)
+    {
+        // The tab keeps its highlight until it gets selected, which resumes
+        // this view, so there is no need to repeat a request
+        if (this->suspendedHighlightState_ == HighlightState::Highlighted ||
+            this->suspendedHighlightState_ == state)
         {
-            this->tabHighlightRequested.invoke(HighlightState::Highlighted);
+            return;
         }
-        else
+        this->suspendedHighlightState_ = state;
+    }
+
+    this->tabHighlightRequested.invoke(state);
+}
+
+void ChannelView::suspend()
+{
+    if (this->suspended_)
+    {
+        return;
+    }
+
+    this->suspended_ = true;
+    this->suspendedHighlightState_ = HighlightState::None;
+
+    this->releaseLayoutsTimer_.start();
+}
+
+void ChannelView::resume()
+{
+    if (!this->suspended_)
+    {
+        return;
+    }
+
+    TraceScope trace("ChannelView::resume");
+
+    this->suspended_ = false;
+    this->releaseLayoutsTimer_.stop();
+
+    auto pending = this->pendingMessages_.getSnapshot();
+    if (pending.size() <= MATERIALIZE_CHUNK_SIZE)
+    {
+        this->materializePendingMessages();
+        this->performLayout();
+        return;
+    }
+
+    // Only the newest messages are needed to fill the view. The rest of
+    // the messages are taken out and added above them in chunks from the
+    // backfill timer, so a large backlog doesn't block the GUI thread.
+    std::deque<MessagePtr> messages;
+    messages.swap(this->backfillMessages_);
+
+    auto current = this->messages_.getSnapshot();
+    for (size_t i = 0; i < current.size(); i++)
+    {
+        messages.push_back(current[i]->getMessagePtr());
+    }
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        messages.push_back(pending[i]);
+    }
+    while (messages.size() > this->messages_.limit())
+    {
+        messages.pop_front();
+    }
+
+    // The selection points into the layouts that are thrown away
+    this->selection_ = Selection();
+    this->pendingMessages_.clear();
+    this->messages_.clear();
+    this->scrollBar_->clearHighlights();
+
+    Trace::counter("materialized messages", int64_t(MATERIALIZE_CHUNK_SIZE));
+
+    auto backfillEnd =
+        messages.size() - std::min(messages.size(), MATERIALIZE_CHUNK_SIZE);
+    this->lastMessageHasAlternateBackground_ = backfillEnd % 2 == 1;
+    for (size_t i = backfillEnd; i < messages.size(); i++)
+    {
+        this->addMessageLayout(messages[i]);
+    }
+
+    messages.resize(backfillEnd);
+    this->backfillMessages_ = std::move(messages);
+    this->backfillTimer_.start();
+
+    this->messageWasAdded_ = true;
+    this->performLayout();
+}
+
+void ChannelView::materializePendingMessages()
+{
+    if (this->pendingMessages_.empty())
+    {
+        return;
+    }
+
+    auto pending = this->pendingMessages_.getSnapshot();
+    this->pendingMessages_.clear();
+
+    Trace::counter("materialized messages", int64_t(pending.size()));
+
+    for (size_t i = 0; i < pending.size(); i++)
+    {
+        this->addMessageLayout(pending[i]);
+    }
+
+    this->messageWasAdded_ = true;
+}
+
+void ChannelView::backfillMessages(size_t count)
+{
+    count = std::min(count, this->backfillMessages_.size());
+    if (count == 0)
+    {
+        this->backfillTimer_.stop();
+        return;
+    }
+
+    TraceScope trace("ChannelView::backfillMessages");
+
+    // The end of backfillMessages_ is right above the first message in
+    // messages_
+    auto start = this->backfillMessages_.size() - count;
+
+    std::vector<MessageLayoutPtr> layouts;
+    std::vector<ScrollbarHighlight> highlights;
+    layouts.reserve(count);
+    highlights.reserve(count);
+
+    for (size_t i = start; i < this->backfillMessages_.size(); i++)
+    {
+        const auto &message = this->backfillMessages_[i];
+        auto layout = new MessageLayout(message);
+
+        // Same alternating background as if they had been appended in order
+        if (i % 2 == 1)
+        {
+            layout->flags.set(MessageLayoutFlag::AlternateBackground);
+        }
+        if (this->channel_->shouldIgnoreHighlights())
         {
-            this->tabHighlightRequested.invoke(HighlightState::NewMessage);
+            layout->flags.set(MessageLayoutFlag::IgnoreHighlights);
         }
+
+        layouts.push_back(MessageLayoutPtr(layout));
+        highlights.push_back(message->getScrollBarHighlight());
+    }
+    this->backfillMessages_.resize(start);
+
+    if (this->messages_.pushFront(layouts).size() > 0)
+    {
+        if (this->scrollBar_->isAtBottom())
+            this->scrollBar_->scrollToBottom();
+        else
+            this->scrollBar_->offset(qreal(layouts.size()));
     }
 
     if (this->showScrollbarHighlights())
     {
-        this->scrollBar_->addHighlight(message->getScrollBarHighlight());
+        this->scrollBar_->addHighlightsAtStart(highlights);
+    }
+
+    if (this->backfillMessages_.empty())
+    {
+        this->backfillTimer_.stop();
     }
 
-    this->messageWasAdded_ = true;
     this->queueLayout();
 }
 
 void ChannelView::messageAddedAtStart(std::vector<MessagePtr> &messages)
 {
+    // These are older than the messages that still have to be backfilled
+    this->backfillMessages(this->backfillMessages_.size());
+
     std::vector<MessageLayoutPtr> messageRefs;
     messageRefs.resize(messages.size());
 
@@ -915,6 +1333,11 @@ void ChannelView::messageRemoveFromStart(MessagePtr &message)
 
 void ChannelView::messageReplaced(size_t index, MessagePtr &replacement)
 {
+    // The index refers to the channel's messages, which include the
+    // backfilled and pending ones
+    this->backfillMessages(this->backfillMessages_.size());
+    this->materializePendingMessages();
+
     if (index >= this->messages_.getSnapshot().size())
     {
         return;
@@ -939,7 +1362,7 @@ void ChannelView::messageReplaced(size_t index, MessagePtr &replacement)
     this->scrollBar_->replaceHighlight(index,
                                        replacement->getScrollBarHighlight());
 
-    this->messages_.replaceItem(message, newItem);
+    this->messages_.replaceItem(index, newItem);
     this->queueLayout();
 }
 
@@ -1030,16 +1453,16 @@ MessageElementFlags ChannelView::getFlags() const
     return flags;
 }
 
-void ChannelView::paintEvent(QPaintEvent * /*event*/)
+void ChannelView::paintEvent(QPaintEvent *event)
 {
-    //    BenchmarkGuard benchmark("paint");
+    TraceScope trace("ChannelView::paintEvent");
 
     QPainter painter(this);
 
     painter.fillRect(rect(), this->theme->splits.background);
 
     // draw messages
-    this->drawMessages(painter);
+    this->drawMessages(painter, event->region());
 
     // draw paused sign
     if (this->paused())
@@ -1053,12 +1476,14 @@ void ChannelView::paintEvent(QPaintEvent * /*event*/)
 
 // if overlays is false then it draws the message, if true then it draws things
 // such as the grey overlay when a message is disabled
-void ChannelView::drawMessages(QPainter &painter)
+void ChannelView::drawMessages(QPainter &painter, const QRegion &region)
 {
     auto messagesSnapshot = this->getMessagesSnapshot();
 
     size_t start = size_t(this->scrollBar_->getCurrentValue());
 
+    this->animatedImages_.clear();
+
     if (start >= messagesSnapshot.size())
     {
         return;
@@ -1072,19 +1497,26 @@ void ChannelView::drawMessages(QPainter &painter)
 
     auto app = getApp();
     bool isMentions = this->underlyingChannel_ == app->twitch->mentionsChannel;
+    auto settings = getSettingsSnapshot();
 
     for (size_t i = start; i < messagesSnapshot.size(); ++i)
     {
         MessageLayout *layout = messagesSnapshot[i].get();
 
         bool isLastMessage = false;
-        if (getSettings()->showLastMessageIndicator)
+        if (settings->showLastMessageIndicator)
         {
             isLastMessage = this->lastReadMessage_.get() == layout;
         }
 
-        layout->paint(painter, DRAW_WIDTH, y, i, this->selection_,
-                      isLastMessage, windowFocused, isMentions);
+        // Animation ticks only repaint the animated images
+        if (region.intersects(
+                QRect(0, y, this->width(), layout->getHeight())))
+        {
+            layout->paint(painter, DRAW_WIDTH, y, i, this->selection_,
+                          isLastMessage, windowFocused, isMentions);
+        }
+        layout->addAnimatedImageAreas(this->animatedImages_, y);
 
         y += layout->getHeight();
 
@@ -2145,6 +2577,11 @@ void ChannelView::mouseDoubleClickEvent(QMouseEvent *event)
     }
 }
 
+void ChannelView::showEvent(QShowEvent *)
+{
+    this->resume();
+}
+
 void ChannelView::hideEvent(QHideEvent *)
 {
     for (auto &layout : this->messagesOnScreen_)
@@ -2153,6 +2590,8 @@ void ChannelView::hideEvent(QHideEvent *)
     }
 
     this->messagesOnScreen_.clear();
+
+    this->suspend();
 }
 
 void ChannelView::showUserInfoPopup(const QString &userName,
@@ -6,6 +6,8 @@
 #include <QWheelEvent>
 #include <QWidget>
 #include <pajlada/signals/signal.hpp>
+#include <atomic>
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -15,6 +17,7 @@
 #include "messages/LimitedQueue.hpp"
 #include "messages/LimitedQueueSnapshot.hpp"
 #include "messages/Selection.hpp"
+#include "messages/layouts/MessageLayoutContainer.hpp"
 #include "widgets/BaseWidget.hpp"
 
 namespace chatterino {
@@ -62,6 +65,7 @@ class ChannelView final : public BaseWidget
 
 public:
     explicit ChannelView(BaseWidget *parent = nullptr);
+    ~ChannelView() override;
 
     void queueUpdate();
     Scrollbar &getScrollBar();
@@ -131,6 +135,7 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event) override;
     void mouseDoubleClickEvent(QMouseEvent *event) override;
 
+    void showEvent(QShowEvent *) override;
     void hideEvent(QHideEvent *) override;
 
     void handleLinkClick(QMouseEvent *event, const Link &link,
@@ -150,13 +155,28 @@ private:
     void messageRemoveFromStart(MessagePtr &message);
     void messageReplaced(size_t index, MessagePtr &replacement);
 
+    // Creates the layout for an appended message and adds it to messages_
+    void addMessageLayout(const MessagePtr &message);
+    // Records a message that arrived while the view is suspended
+    void addPendingMessage(const MessagePtr &message);
+    void requestTabHighlight(HighlightState state);
+
+    void suspend();
+    void resume();
+    void materializePendingMessages();
+    // Adds up to count of the backfilled messages above the ones in messages_
+    void backfillMessages(size_t count);
+
     void performLayout(bool causedByScollbar = false);
     void layoutVisibleMessages(
         LimitedQueueSnapshot<MessageLayoutPtr> &messages);
     void updateScrollbar(LimitedQueueSnapshot<MessageLayoutPtr> &messages,
                          bool causedByScrollbar);
 
-    void drawMessages(QPainter &painter);
+    // Only paints the messages that intersect region
+    void drawMessages(QPainter &painter, const QRegion &region);
+    // Repaints the animated images whose frame changed
+    void repaintAnimatedImages();
     void setSelection(const SelectionItem &start, const SelectionItem &end);
     MessageElementFlags getFlags() const;
     void selectWholeMessage(MessageLayout *layout, int &messageIndex);
@@ -225,6 +245,16 @@ private:
     // Returns true if message should be included
     bool shouldIncludeMessage(const MessagePtr &m) const;
 
+    // Filters the messages of the underlying channel again on a worker
+    // thread and replaces the shown messages once that's done
+    void refilterMessages();
+    void cancelRefilter();
+    void applyRefilter(std::vector<MessagePtr> included,
+                       const MessagePtr &lastFiltered);
+
+    // Set when a running refilter is outdated (or the view is destroyed)
+    std::shared_ptr<std::atomic<bool>> refilterCancelled_;
+
     // Returns whether the scrollbar should have highlights
     bool showScrollbarHighlights() const;
 
@@ -261,12 +291,29 @@ private:
 
     LimitedQueue<MessageLayoutPtr> messages_;
 
+    // While the view is hidden (background tab, minimized window) appended
+    // messages are only recorded and their layouts get created once the view
+    // is shown again
+    bool suspended_ = true;
+    LimitedQueue<MessagePtr> pendingMessages_;
+    // Older messages of a large backlog, they are added above the newest
+    // ones in chunks after the view got resumed
+    std::deque<MessagePtr> backfillMessages_;
+    QTimer backfillTimer_;
+    // Highest tab highlight requested since the view got suspended, used to
+    // not repeat the same request for every message
+    HighlightState suspendedHighlightState_{};
+    // Releases the layouts of a view that stayed hidden for a while
+    QTimer releaseLayoutsTimer_;
+
     pajlada::Signals::SignalHolder signalHolder_;
 
     // channelConnections_ will be cleared when the underlying channel of the channelview changes
     pajlada::Signals::SignalHolder channelConnections_;
 
     std::unordered_set<std::shared_ptr<MessageLayout>> messagesOnScreen_;
+    // Animated images on screen as of the last paint
+    std::vector<AnimatedImageArea> animatedImages_;
 
     static constexpr int leftPadding = 8;
     static constexpr int scrollbarPadding = 8;
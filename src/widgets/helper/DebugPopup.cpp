@@ -1,5 +1,7 @@
 #include "DebugPopup.hpp"
 
+#include "Application.hpp"
+#include "singletons/Emotes.hpp"
 #include "util/DebugCount.hpp"
 
 #include <QFontDatabase>
@@ -17,7 +19,17 @@ DebugPopup::DebugPopup()
 
     timer->setInterval(300);
     QObject::connect(timer, &QTimer::timeout, [text] {
-        text->setText(DebugCount::getDebugText());
+        const auto &budget = getApp()->emotes->gifTimer.budget();
+        auto throttled =
+            budget.mode() == AnimationBudget::Mode::Throttled;
+
+        text->setText(
+            DebugCount::getDebugText() +
+            QString("Animations: %1 (%2 ms/frame, %3 / %4 ms busy)\n")
+                .arg(throttled ? "throttled" : "full rate")
+                .arg(budget.frameLength())
+                .arg(budget.averageBusyTime(), 0, 'f', 1)
+                .arg(AnimationBudget::budget));
     });
     timer->start();
 
@@ -0,0 +1,364 @@
+#include "widgets/helper/EmoteGrid.hpp"
+
+#include "Application.hpp"
+#include "messages/Emote.hpp"
+#include "messages/Link.hpp"
+#include "singletons/Fonts.hpp"
+#include "singletons/Settings.hpp"
+#include "singletons/Theme.hpp"
+#include "singletons/TooltipPreviewImage.hpp"
+#include "singletons/WindowManager.hpp"
+#include "widgets/Scrollbar.hpp"
+#include "widgets/TooltipWidget.hpp"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QWheelEvent>
+
+#include <algorithm>
+
+namespace chatterino {
+
+namespace {
+
+    constexpr int margin = 8;
+    constexpr int baseCellSize = 32;
+
+}  // namespace
+
+EmoteGrid::EmoteGrid(QWidget *parent)
+    : BaseWidget(parent)
+    , scrollBar_(new Scrollbar(this))
+{
+    this->setMouseTracking(true);
+
+    this->scrollBar_->getCurrentValueChanged().connect([this] {
+        this->update();
+    });
+
+    // Images are only loaded once they are painted, repaint when they are
+    this->signalHolder_.managedConnect(getApp()->windows->layoutRequested,
+                                       [this](Channel *) {
+                                           if (this->isVisible())
+                                           {
+                                               this->update();
+                                           }
+                                       });
+    this->signalHolder_.managedConnect(
+        getApp()->windows->gifRepaintRequested, [this] {
+            if (this->isVisible() && this->paintedAnimatedEmote_)
+            {
+                this->update();
+            }
+        });
+}
+
+void EmoteGrid::setModel(EmoteGridModel model)
+{
+    this->model_ = std::move(model);
+    this->scrollBar_->setDesiredValue(0);
+    this->updateLayout();
+}
+
+void EmoteGrid::setPlaceholderText(const QString &text)
+{
+    this->placeholderText_ = text;
+    this->update();
+}
+
+Scrollbar &EmoteGrid::getScrollBar()
+{
+    return *this->scrollBar_;
+}
+
+int EmoteGrid::cellSize() const
+{
+    return int(baseCellSize * this->scale());
+}
+
+int EmoteGrid::titleHeight() const
+{
+    return getApp()
+               ->fonts->getFontMetrics(FontStyle::ChatMedium, this->scale())
+               .height() +
+           int(margin * this->scale());
+}
+
+int EmoteGrid::rowCount(const EmoteGridSection &section) const
+{
+    if (section.items.empty())
+    {
+        return 1;
+    }
+
+    return int((section.items.size() + this->columns_ - 1) / this->columns_);
+}
+
+void EmoteGrid::updateLayout()
+{
+    auto cell = this->cellSize();
+    auto gridWidth = this->width() - this->scrollBar_->width() -
+                     2 * int(margin * this->scale());
+
+    this->columns_ = std::max(1, gridWidth / cell);
+    this->gridLeft_ = int(margin * this->scale()) +
+                      (gridWidth - this->columns_ * cell) / 2;
+
+    this->sectionTops_.clear();
+    int y = 0;
+    for (size_t i = 0; i < this->model_.sectionCount(); i++)
+    {
+        this->sectionTops_.push_back(y);
+        y += this->titleHeight() +
+             this->rowCount(this->model_.section(i)) * cell;
+    }
+    this->contentHeight_ = y + int(margin * this->scale());
+
+    this->scrollBar_->setLargeChange(this->height());
+    this->scrollBar_->setSmallChange(cell);
+    this->scrollBar_->setMaximum(this->contentHeight_);
+    this->scrollBar_->setVisible(this->contentHeight_ > this->height());
+
+    this->update();
+}
+
+QRect EmoteGrid::cellRect(size_t section, size_t item) const
+{
+    auto cell = this->cellSize();
+    auto row = int(item) / this->columns_;
+    auto column = int(item) % this->columns_;
+    auto top = this->sectionTops_[section] + this->titleHeight() -
+               int(this->scrollBar_->getCurrentValue());
+
+    return {this->gridLeft_ + column * cell, top + row * cell, cell, cell};
+}
+
+const EmoteGridItem *EmoteGrid::itemAt(QPoint pos)
+{
+    auto y = pos.y() + int(this->scrollBar_->getCurrentValue());
+
+    // Last section whose title starts above y
+    auto it = std::upper_bound(this->sectionTops_.begin(),
+                               this->sectionTops_.end(), y);
+    if (it == this->sectionTops_.begin())
+    {
+        return nullptr;
+    }
+    auto section = size_t(std::distance(this->sectionTops_.begin(), it) - 1);
+
+    auto cell = this->cellSize();
+    auto gridY = y - this->sectionTops_[section] - this->titleHeight();
+    auto gridX = pos.x() - this->gridLeft_;
+    if (gridY < 0 || gridX < 0 || gridX >= this->columns_ * cell)
+    {
+        return nullptr;
+    }
+
+    auto index = size_t((gridY / cell) * this->columns_ + gridX / cell);
+    const auto &items = this->model_.section(section).items;
+    if (index >= items.size() || items[index].emote == nullptr)
+    {
+        return nullptr;
+    }
+
+    return &items[index];
+}
+
+void EmoteGrid::paintEvent(QPaintEvent *)
+{
+    QPainter painter(this);
+    painter.fillRect(this->rect(), this->theme->splits.background);
+    painter.setFont(
+        getApp()->fonts->getFont(FontStyle::ChatMedium, this->scale()));
+
+    this->paintedAnimatedEmote_ = false;
+
+    if (this->model_.empty())
+    {
+        painter.setPen(this->theme->messages.textColors.system);
+        painter.drawText(QRect(0, 0, this->width(), this->titleHeight()),
+                         Qt::AlignCenter, this->placeholderText_);
+        return;
+    }
+
+    auto offset = int(this->scrollBar_->getCurrentValue());
+    auto cell = this->cellSize();
+    auto titleHeight = this->titleHeight();
+    auto contentWidth = this->width() - this->scrollBar_->width();
+
+    for (size_t i = 0; i < this->model_.sectionCount(); i++)
+    {
+        auto top = this->sectionTops_[i] - offset;
+        auto bottom = top + titleHeight +
+                      this->rowCount(this->model_.section(i)) * cell;
+
+        if (bottom < 0)
+        {
+            continue;
+        }
+        if (top > this->height())
+        {
+            break;
+        }
+
+        this->model_.resolveSection(i);
+        const auto &section = this->model_.section(i);
+
+        painter.setPen(this->theme->messages.textColors.regular);
+        painter.drawText(QRect(0, top, contentWidth, titleHeight),
+                         Qt::AlignCenter, section.title);
+
+        if (section.items.empty())
+        {
+            painter.setPen(this->theme->messages.textColors.system);
+            painter.drawText(QRect(0, top + titleHeight, contentWidth, cell),
+                             Qt::AlignCenter, "no emotes available");
+            continue;
+        }
+
+        // Only the visible rows
+        auto gridTop = top + titleHeight;
+        auto firstRow = std::max(0, -gridTop / cell);
+        auto lastRow = std::min(this->rowCount(section) - 1,
+                                (this->height() - gridTop) / cell);
+
+        for (auto row = firstRow; row <= lastRow; row++)
+        {
+            for (auto column = 0; column < this->columns_; column++)
+            {
+                auto index = size_t(row * this->columns_ + column);
+                if (index >= section.items.size())
+                {
+                    break;
+                }
+
+                this->paintItem(painter, section.items[index],
+                                this->cellRect(i, index));
+            }
+        }
+    }
+}
+
+void EmoteGrid::paintItem(QPainter &painter, const EmoteGridItem &item,
+                          const QRect &rect)
+{
+    if (item.emote == nullptr)
+    {
+        return;
+    }
+
+    const auto &image = item.emote->images.getImageOrLoaded(this->scale());
+    if (image->isEmpty())
+    {
+        return;
+    }
+
+    // Requests the image if it isn't loaded yet, layoutRequested repaints
+    // the grid once it is
+    auto pixmap = image->pixmapOrLoad();
+    if (!pixmap)
+    {
+        return;
+    }
+
+    this->paintedAnimatedEmote_ |= image->animated();
+
+    auto padding = int(2 * this->scale());
+    auto available = rect.size() - QSize(2 * padding, 2 * padding);
+    auto size = QSize(int(image->width() * this->scale()),
+                      int(image->height() * this->scale()));
+    if (size.width() > available.width() || size.height() > available.height())
+    {
+        size.scale(available, Qt::KeepAspectRatio);
+    }
+
+    QRect target(QPoint(), size);
+    target.moveCenter(rect.center());
+    painter.drawPixmap(target, *pixmap);
+}
+
+void EmoteGrid::resizeEvent(QResizeEvent *)
+{
+    this->scrollBar_->setGeometry(this->width() - this->scrollBar_->width(), 0,
+                                  this->scrollBar_->width(), this->height());
+    this->scrollBar_->raise();
+
+    this->updateLayout();
+}
+
+void EmoteGrid::scaleChangedEvent(float /*newScale*/)
+{
+    this->updateLayout();
+}
+
+void EmoteGrid::wheelEvent(QWheelEvent *event)
+{
+    if (event->modifiers() & Qt::ControlModifier)
+    {
+        event->ignore();
+        return;
+    }
+
+    if (this->scrollBar_->isVisible())
+    {
+        float mouseMultiplier = getSettings()->mouseScrollMultiplier;
+        this->scrollBar_->offset(-event->angleDelta().y() * mouseMultiplier);
+    }
+}
+
+void EmoteGrid::mouseMoveEvent(QMouseEvent *event)
+{
+    auto tooltipWidget = TooltipWidget::instance();
+    const auto *item = this->itemAt(event->pos());
+
+    if (item == nullptr)
+    {
+        this->setCursor(Qt::ArrowCursor);
+        tooltipWidget->hide();
+        return;
+    }
+
+    this->setCursor(Qt::PointingHandCursor);
+
+    auto &tooltipPreviewImage = TooltipPreviewImage::instance();
+    tooltipPreviewImage.setImageScale(0, 0);
+    if (getSettings()->emotesTooltipPreview.getValue() == 1 ||
+        (getSettings()->emotesTooltipPreview.getValue() &&
+         event->modifiers() == Qt::ShiftModifier))
+    {
+        tooltipPreviewImage.setImage(item->emote->images.getImage(3.0));
+    }
+    else
+    {
+        tooltipPreviewImage.setImage(nullptr);
+    }
+
+    auto tooltip = item->emote->tooltip.string;
+    tooltipWidget->moveTo(this, event->globalPos());
+    tooltipWidget->setWordWrap(false);
+    tooltipWidget->setText(tooltip.isEmpty() ? item->name : tooltip);
+    tooltipWidget->adjustSize();
+    tooltipWidget->setWindowFlag(Qt::WindowStaysOnTopHint, true);
+    tooltipWidget->show();
+    tooltipWidget->raise();
+}
+
+void EmoteGrid::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton)
+    {
+        return;
+    }
+
+    if (const auto *item = this->itemAt(event->pos()))
+    {
+        this->linkClicked.invoke(Link(Link::InsertText, item->insertText));
+    }
+}
+
+void EmoteGrid::leaveEvent(QEvent *)
+{
+    TooltipWidget::instance()->hide();
+}
+
+}  // namespace chatterino
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "widgets/BaseWidget.hpp"
+#include "widgets/helper/EmoteGridModel.hpp"
+
+#include <pajlada/signals/signal.hpp>
+
+namespace chatterino {
+
+struct Link;
+class Scrollbar;
+
+/**
+ * @brief Shows the emotes of an EmoteGridModel in fixed size cells
+ *
+ * Only the visible rows are painted, so only the images of visible emotes
+ * are loaded. Sections are resolved when they are first shown.
+ **/
+class EmoteGrid : public BaseWidget
+{
+public:
+    EmoteGrid(QWidget *parent = nullptr);
+
+    void setModel(EmoteGridModel model);
+    // Shown if the model has no sections
+    void setPlaceholderText(const QString &text);
+
+    Scrollbar &getScrollBar();
+
+    pajlada::Signals::Signal<Link> linkClicked;
+
+protected:
+    void paintEvent(QPaintEvent *) override;
+    void resizeEvent(QResizeEvent *) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *) override;
+    void scaleChangedEvent(float newScale) override;
+
+private:
+    void updateLayout();
+    int cellSize() const;
+    int titleHeight() const;
+    // Rows of a section, sections without items show a text in one row
+    int rowCount(const EmoteGridSection &section) const;
+    QRect cellRect(size_t section, size_t item) const;
+    const EmoteGridItem *itemAt(QPoint pos);
+    void paintItem(QPainter &painter, const EmoteGridItem &item,
+                   const QRect &rect);
+
+    EmoteGridModel model_;
+    QString placeholderText_;
+    Scrollbar *scrollBar_;
+
+    int columns_ = 1;
+    int gridLeft_ = 0;
+    // Content y of each section's title
+    std::vector<int> sectionTops_;
+    int contentHeight_ = 0;
+
+    // Set while painting, the grid is repainted with the gif timer if true
+    bool paintedAnimatedEmote_ = false;
+};
+
+}  // namespace chatterino
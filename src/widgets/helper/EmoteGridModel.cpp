@@ -0,0 +1,132 @@
+#include "widgets/helper/EmoteGridModel.hpp"
+
+namespace chatterino {
+
+namespace {
+
+    // How many names are compared between checks for cancellation
+    constexpr size_t cancellationInterval = 256;
+
+}  // namespace
+
+EmoteNameIndex::EmoteNameIndex(const std::vector<EmoteGridSection> &sections)
+{
+    for (size_t i = 0; i < sections.size(); i++)
+    {
+        const auto &items = sections[i].items;
+        for (size_t j = 0; j < items.size(); j++)
+        {
+            this->entries_.push_back({items[j].name.toLower(), {i, j}});
+        }
+    }
+}
+
+boost::optional<std::vector<EmoteNameIndex::Position>> EmoteNameIndex::search(
+    const QString &text, const std::function<bool()> &isCancelled) const
+{
+    auto lowerText = text.toLower();
+    std::vector<Position> positions;
+
+    for (size_t i = 0; i < this->entries_.size(); i++)
+    {
+        if (i % cancellationInterval == 0 && isCancelled && isCancelled())
+        {
+            return boost::none;
+        }
+
+        const auto &entry = this->entries_[i];
+        if (entry.lowerName.contains(lowerText))
+        {
+            positions.push_back(entry.position);
+        }
+    }
+
+    return positions;
+}
+
+void EmoteGridModel::addSection(EmoteGridSection section)
+{
+    this->resolved_.push_back(!section.resolver);
+    this->sections_.push_back(std::move(section));
+    this->nameIndex_.reset();
+}
+
+bool EmoteGridModel::empty() const
+{
+    return this->sections_.empty();
+}
+
+size_t EmoteGridModel::sectionCount() const
+{
+    return this->sections_.size();
+}
+
+const EmoteGridSection &EmoteGridModel::section(size_t index) const
+{
+    return this->sections_.at(index);
+}
+
+void EmoteGridModel::resolveSection(size_t index)
+{
+    if (this->resolved_.at(index))
+    {
+        return;
+    }
+    this->resolved_[index] = true;
+
+    auto &section = this->sections_[index];
+    for (auto &item : section.items)
+    {
+        if (item.emote == nullptr)
+        {
+            item.emote = section.resolver(item);
+        }
+    }
+}
+
+std::shared_ptr<const EmoteNameIndex> EmoteGridModel::nameIndex() const
+{
+    if (this->nameIndex_ == nullptr)
+    {
+        this->nameIndex_ = std::make_shared<EmoteNameIndex>(this->sections_);
+    }
+
+    return this->nameIndex_;
+}
+
+EmoteGridModel EmoteGridModel::filtered(
+    const std::vector<EmoteNameIndex::Position> &positions) const
+{
+    EmoteGridModel model;
+
+    // The positions are sorted by section, so each section is only added once
+    boost::optional<size_t> currentSection;
+    EmoteGridSection section;
+
+    for (const auto &position : positions)
+    {
+        if (currentSection != position.section)
+        {
+            if (currentSection)
+            {
+                model.addSection(std::move(section));
+            }
+
+            const auto &source = this->sections_.at(position.section);
+            section = EmoteGridSection{source.title, {}, source.resolver};
+            currentSection = position.section;
+        }
+
+        section.items.push_back(
+            this->sections_[position.section].items.at(position.item));
+    }
+
+    if (currentSection)
+    {
+        model.addSection(std::move(section));
+    }
+
+    return model;
+}
+
+}  // namespace chatterino
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <QString>
+#include <boost/optional.hpp>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace chatterino {
+
+struct Emote;
+using EmotePtr = std::shared_ptr<const Emote>;
+
+struct EmoteGridItem {
+    // Searched by the filter and shown if the emote has no tooltip
+    QString name;
+    // Inserted into the input when the item is clicked
+    QString insertText;
+    // Passed to the section's resolver, e.g. the Twitch emote id
+    QString id;
+    // Only set once the section is resolved if the section has a resolver
+    EmotePtr emote;
+};
+
+struct EmoteGridSection {
+    using Resolver = std::function<EmotePtr(const EmoteGridItem &)>;
+
+    QString title;
+    std::vector<EmoteGridItem> items;
+    // Creates the emotes of the items when the section is first shown.
+    // Creating thousands of Twitch emotes up front is slow.
+    Resolver resolver;
+};
+
+/**
+ * @brief Lower case names of all emotes of an EmoteGridModel
+ *
+ * Immutable, so that it can be searched on a worker thread while the user
+ * keeps typing.
+ **/
+class EmoteNameIndex
+{
+public:
+    struct Position {
+        size_t section;
+        size_t item;
+    };
+
+    explicit EmoteNameIndex(const std::vector<EmoteGridSection> &sections);
+
+    // Returns the positions of all emotes whose name contains text, ignoring
+    // case, in the order of the model. Returns none as soon as isCancelled
+    // returns true.
+    boost::optional<std::vector<Position>> search(
+        const QString &text, const std::function<bool()> &isCancelled) const;
+
+private:
+    struct Entry {
+        QString lowerName;
+        Position position;
+    };
+
+    std::vector<Entry> entries_;
+};
+
+/**
+ * @brief Sections of emotes shown by an EmoteGrid
+ **/
+class EmoteGridModel
+{
+public:
+    void addSection(EmoteGridSection section);
+
+    bool empty() const;
+    size_t sectionCount() const;
+    const EmoteGridSection &section(size_t index) const;
+
+    // Creates the emotes of the section with its resolver, only once
+    void resolveSection(size_t index);
+
+    // Built on the first call
+    std::shared_ptr<const EmoteNameIndex> nameIndex() const;
+
+    // Returns a model with only the items at the positions, which must come
+    // from the index of this model. Sections without items are left out.
+    EmoteGridModel filtered(
+        const std::vector<EmoteNameIndex::Position> &positions) const;
+
+private:
+    std::vector<EmoteGridSection> sections_;
+    std::vector<bool> resolved_;
+    mutable std::shared_ptr<const EmoteNameIndex> nameIndex_;
+};
+
+}  // namespace chatterino
@@ -10,6 +10,7 @@
 namespace chatterino {
 
 ResizingTextEdit::ResizingTextEdit()
+    : statusLabel_(new QLabel(this))
 {
     auto sizePolicy = this->sizePolicy();
     sizePolicy.setHeightForWidth(true);
@@ -28,6 +29,38 @@ ResizingTextEdit::ResizingTextEdit()
 
     this->setFocusPolicy(Qt::ClickFocus);
     this->installEventFilter(this);
+
+    this->statusLabel_->hide();
+    this->statusLabel_->setTextFormat(Qt::RichText);
+    this->statusLabel_->setTextInteractionFlags(Qt::LinksAccessibleByMouse);
+    QObject::connect(this->statusLabel_, &QLabel::linkActivated,
+                     [this](const QString &link) {
+                         this->statusLinkActivated.invoke(link);
+                     });
+}
+
+void ResizingTextEdit::setStatusText(const QString &text)
+{
+    this->statusLabel_->setText(text);
+    this->statusLabel_->setVisible(!text.isEmpty());
+    this->moveStatusLabel();
+}
+
+void ResizingTextEdit::moveStatusLabel()
+{
+    // Not a child of the viewport, those get moved around when scrolling
+    auto area = this->viewport()->geometry();
+    this->statusLabel_->adjustSize();
+    this->statusLabel_->move(area.right() - this->statusLabel_->width(),
+                             area.bottom() - this->statusLabel_->height());
+    this->statusLabel_->raise();
+}
+
+void ResizingTextEdit::resizeEvent(QResizeEvent *event)
+{
+    QTextEdit::resizeEvent(event);
+
+    this->moveStatusLabel();
 }
 
 QSize ResizingTextEdit::sizeHint() const
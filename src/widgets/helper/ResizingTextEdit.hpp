@@ -2,6 +2,7 @@
 
 #include <QCompleter>
 #include <QKeyEvent>
+#include <QLabel>
 #include <QTextEdit>
 #include <pajlada/signals/signal.hpp>
 
@@ -21,16 +22,23 @@ public:
     pajlada::Signals::NoArgSignal focused;
     pajlada::Signals::NoArgSignal focusLost;
     pajlada::Signals::Signal<const QMimeData *> imagePasted;
+    // Emitted with the href of a link in the status text
+    pajlada::Signals::Signal<QString> statusLinkActivated;
 
     void setCompleter(QCompleter *c);
     QCompleter *getCompleter() const;
 
+    // Shows a small status text (e.g. the progress of image uploads) in the
+    // bottom right corner. Hidden if text is empty.
+    void setStatusText(const QString &text);
+
 protected:
     int heightForWidth(int) const override;
     void keyPressEvent(QKeyEvent *event) override;
 
     void focusInEvent(QFocusEvent *event) override;
     void focusOutEvent(QFocusEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
 
     bool canInsertFromMimeData(const QMimeData *source) const override;
     void insertFromMimeData(const QMimeData *source) override;
@@ -39,9 +47,11 @@ private:
     // hadSpace is set to true in case the "textUnderCursor" word was after a
     // space
     QString textUnderCursor(bool *hadSpace = nullptr) const;
+    void moveStatusLabel();
 
     QCompleter *completer_ = nullptr;
     bool completionInProgress_ = false;
+    QLabel *statusLabel_;
 
     bool eventFilter(QObject *widget, QEvent *event) override;
 private slots:
@@ -607,6 +607,9 @@ void GeneralPage::initLayout(GeneralPageView &layout)
     }
 
     layout.addCheckbox("Restart on crash", s.restartOnCrash);
+    layout.addCheckbox("Reuse the layout of frequently repeated words when "
+                       "painting messages",
+                       s.cacheTextRuns);
 
 #if defined(Q_OS_LINUX) && !defined(NO_QTKEYCHAIN)
     if (!getPaths()->isPortable())
@@ -681,6 +684,8 @@ void GeneralPage::initLayout(GeneralPageView &layout)
     // TODO: Change phrasing to use better english once we can tag settings, right now it's kept as history instead of historical so that the setting shows up when the user searches for history
     layout.addIntInput("Max number of history messages to load on connect",
                        s.twitchMessageHistoryLimit, 10, 800, 10);
+    layout.addIntInput("Connections used to receive chat (requires restart)",
+                       s.twitchReadConnections, 1, 8, 1);
 
     layout.addCheckbox("Enable experimental IRC support (requires restart)",
                        s.enableExperimentalIrc);
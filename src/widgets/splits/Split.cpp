@@ -245,6 +245,18 @@ Split::Split(QWidget *parent)
             upload(source, this->getChannel(), *this->input_->ui_.textEdit);
         });
 
+    this->input_->ui_.textEdit->statusLinkActivated.connect(
+        [](const QString &link) {
+            if (link == "retry")
+            {
+                retryUploads();
+            }
+            else if (link == "cancel")
+            {
+                cancelUploads();
+            }
+        });
+
     getSettings()->imageUploaderEnabled.connect(
         [this](const bool &val) {
             this->setAcceptDrops(val);
@@ -216,6 +216,11 @@ SplitHeader::SplitHeader(Split *_split)
     getSettings()->headerStreamTitle.connect(_, this->managedConnections_);
     getSettings()->headerGame.connect(_, this->managedConnections_);
     getSettings()->headerUptime.connect(_, this->managedConnections_);
+
+    // The viewer count and uptime are hidden in streamer mode
+    this->managedConnections_.managedConnect(streamerModeChanged(), [this] {
+        this->updateChannelText();
+    });
 }
 
 void SplitHeader::initializeLayout()
@@ -44,8 +44,20 @@ SplitInput::SplitInput(Split *_chatWidget)
         auto completer =
             new QCompleter(&this->split_->getChannel()->completionModel);
         this->ui_.textEdit->setCompleter(completer);
+        this->updateQueuedMessages();
     });
 
+    // queued messages
+    this->managedConnections_.managedConnect(
+        getApp()->twitch->queuedMessagesChanged,
+        [this](const QString &channelName) {
+            if (channelName == this->split_->getChannel()->getName())
+            {
+                this->updateQueuedMessages();
+            }
+        });
+    this->updateQueuedMessages();
+
     // misc
     this->installKeyPressedEvent();
     this->addShortcuts();
@@ -83,6 +95,12 @@ void SplitInput::initLayout()
             box.emplace<QLabel>().assign(&this->ui_.textEditLength);
         textEditLength->setAlignment(Qt::AlignRight);
 
+        auto queuedMessages =
+            box.emplace<EffectLabel>().assign(&this->ui_.queuedMessages);
+        queuedMessages->setToolTip("Messages waiting for the Twitch rate "
+                                   "limit. Click to cancel them.");
+        queuedMessages->hide();
+
         box->addStretch(1);
         box.emplace<EffectLabel>().assign(&this->ui_.emoteButton);
     }
@@ -109,6 +127,13 @@ void SplitInput::initLayout()
         this->openEmotePopup();
     });
 
+    // cancel queued messages
+    QObject::connect(this->ui_.queuedMessages, &EffectLabel::leftClicked,
+                     [this] {
+                         getApp()->twitch->cancelQueuedMessages(
+                             this->split_->getChannel()->getName());
+                     });
+
     // clear channelview selection when selecting in the input
     QObject::connect(this->ui_.textEdit, &QTextEdit::copyAvailable,
                      [this](bool available) {
@@ -138,6 +163,8 @@ void SplitInput::scaleChangedEvent(float scale)
         getApp()->fonts->getFont(FontStyle::ChatMedium, this->scale()));
     this->ui_.textEditLength->setFont(
         getApp()->fonts->getFont(FontStyle::ChatMedium, this->scale()));
+    this->ui_.queuedMessages->getLabel().setFont(
+        getApp()->fonts->getFont(FontStyle::ChatMedium, this->scale()));
 }
 
 void SplitInput::themeChangedEvent()
@@ -153,6 +180,7 @@ void SplitInput::themeChangedEvent()
 
     this->updateEmoteButton();
     this->ui_.textEditLength->setPalette(palette);
+    this->ui_.queuedMessages->getLabel().setPalette(palette);
 
     this->ui_.textEdit->setStyleSheet(this->theme->splits.input.styleSheet);
 #if (QT_VERSION >= QT_VERSION_CHECK(5, 12, 0))
@@ -733,6 +761,21 @@ void SplitInput::editTextChanged()
     this->ui_.textEditLength->setText(labelText);
 }
 
+void SplitInput::updateQueuedMessages()
+{
+    auto channel = this->split_->getChannel();
+
+    size_t count = 0;
+    if (channel->isTwitchChannel())
+    {
+        count = getApp()->twitch->queuedMessageCount(channel->getName());
+    }
+
+    this->ui_.queuedMessages->getLabel().setText(
+        QString("%1 queued ").arg(count) + QChar(0x00D7));
+    this->ui_.queuedMessages->setVisible(count > 0);
+}
+
 void SplitInput::paintEvent(QPaintEvent *)
 {
     QPainter painter(this);
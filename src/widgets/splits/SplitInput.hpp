@@ -51,6 +51,7 @@ private:
     void onCursorPositionChanged();
     void onTextChanged();
     void updateEmoteButton();
+    void updateQueuedMessages();
     void updateCompletionPopup();
     void showCompletionPopup(const QString &text, bool emoteCompletion);
     void hideCompletionPopup();
@@ -64,6 +65,7 @@ private:
     struct {
         ResizingTextEdit *textEdit;
         QLabel *textEditLength;
+        EffectLabel *queuedMessages;
         EffectLabel *emoteButton;
 
         QHBoxLayout *hbox;
@@ -0,0 +1,145 @@
+#include "providers/irc/AbstractIrcServer.hpp"
+
+#include "providers/twitch/TwitchHelpers.hpp"
+
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QStringList>
+
+#include <functional>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+// Two read connections that are never opened, messages are fed to them by
+// emitting messageReceived like Communi does
+class MockIrcServer : public AbstractIrcServer
+{
+public:
+    MockIrcServer()
+    {
+        this->initializeIrc();
+        this->connect();
+    }
+
+    // Feeds the raw line to every read connection, like Twitch does for
+    // messages that are sent to the account
+    void receiveOnAll(const QString &line)
+    {
+        for (auto *connection : this->readConnections)
+        {
+            this->receive(connection, line);
+        }
+    }
+
+    void receive(IrcConnection *connection, const QString &line)
+    {
+        auto *message =
+            Communi::IrcMessage::fromData(line.toUtf8(), connection);
+        emit connection->messageReceived(message);
+    }
+
+    std::vector<IrcConnection *> readConnections;
+    QStringList received;
+
+protected:
+    void initializeConnection(IrcConnection *connection,
+                              ConnectionType type) override
+    {
+        if (type & Read)
+        {
+            this->readConnections.push_back(connection);
+        }
+    }
+
+    std::shared_ptr<Channel> createChannel(const QString &channelName) override
+    {
+        (void)channelName;
+        return nullptr;
+    }
+
+    void readConnectionMessageReceived(Communi::IrcMessage *message) override
+    {
+        this->received.append(message->command());
+    }
+
+    bool hasSeparateWriteConnection() const override
+    {
+        return true;
+    }
+
+    int readConnectionCount() const override
+    {
+        return 2;
+    }
+
+    bool isAccountWideMessage(Communi::IrcMessage *message) const override
+    {
+        return chatterino::isAccountWideMessage(message);
+    }
+};
+
+// The connections live in the GUI thread
+void runInGuiThread(const std::function<void()> &fn)
+{
+    QMetaObject::invokeMethod(qApp, fn, Qt::BlockingQueuedConnection);
+}
+
+}  // namespace
+
+TEST(AbstractIrcServer, WhisperIsHandledOnce)
+{
+    runInGuiThread([] {
+        MockIrcServer server;
+        ASSERT_EQ(server.readConnections.size(), 2u);
+
+        server.receiveOnAll(
+            "@badges=;color=;display-name=pajlada;emotes=;message-id=1;"
+            "thread-id=11148817_117166826;turbo=0;user-id=11148817;"
+            "user-type= :pajlada!pajlada@pajlada.tmi.twitch.tv WHISPER "
+            "testaccount_420 :hello");
+
+        EXPECT_EQ(server.received, QStringList{"WHISPER"});
+    });
+}
+
+TEST(AbstractIrcServer, AccountWideMessagesAreHandledOnce)
+{
+    runInGuiThread([] {
+        MockIrcServer server;
+
+        server.receiveOnAll(
+            "@badge-info=;badges=;color=;display-name=testaccount_420;"
+            "emote-sets=0;user-id=117166826;user-type= :tmi.twitch.tv "
+            "GLOBALUSERSTATE");
+        server.receiveOnAll(
+            ":tmi.twitch.tv NOTICE * :Login authentication failed");
+        server.receiveOnAll(":tmi.twitch.tv NOTICE #jtv :Some notice");
+
+        EXPECT_EQ(server.received,
+                  (QStringList{"GLOBALUSERSTATE", "NOTICE", "NOTICE"}));
+    });
+}
+
+TEST(AbstractIrcServer, ChannelMessagesAreHandledPerConnection)
+{
+    runInGuiThread([] {
+        MockIrcServer server;
+        ASSERT_EQ(server.readConnections.size(), 2u);
+
+        // Each connection only receives the messages of its own channels
+        server.receive(server.readConnections[0],
+                       "@msg-id=slow_on :tmi.twitch.tv NOTICE #pajlada "
+                       ":This room is now in slow mode.");
+        server.receive(server.readConnections[1],
+                       ":tmi.twitch.tv CLEARCHAT #forsen");
+        server.receive(server.readConnections[1],
+                       "@msg-id=slow_on :tmi.twitch.tv NOTICE #forsen "
+                       ":This room is now in slow mode.");
+
+        EXPECT_EQ(server.received,
+                  (QStringList{"NOTICE", "CLEARCHAT", "NOTICE"}));
+    });
+}
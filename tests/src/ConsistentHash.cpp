@@ -0,0 +1,74 @@
+#include "util/ConsistentHash.hpp"
+
+#include <gtest/gtest.h>
+#include <QString>
+
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+QString channelName(int i)
+{
+    return QString("channel%1").arg(i);
+}
+
+}  // namespace
+
+TEST(ConsistentHash, SingleShard)
+{
+    EXPECT_EQ(consistentShard("pajlada", 1), 0);
+    EXPECT_EQ(consistentShard("pajlada", 0), 0);
+    EXPECT_EQ(consistentShard("", 1), 0);
+}
+
+TEST(ConsistentHash, Stable)
+{
+    for (int i = 0; i < 100; i++)
+    {
+        auto shard = consistentShard(channelName(i), 4);
+        EXPECT_GE(shard, 0);
+        EXPECT_LT(shard, 4);
+        EXPECT_EQ(consistentShard(channelName(i), 4), shard);
+    }
+}
+
+TEST(ConsistentHash, Distribution)
+{
+    const int keyCount = 2000;
+    const int shardCount = 4;
+
+    std::vector<int> counts(shardCount);
+    for (int i = 0; i < keyCount; i++)
+    {
+        counts[consistentShard(channelName(i), shardCount)]++;
+    }
+
+    for (auto count : counts)
+    {
+        // Expected 500 per shard
+        EXPECT_GT(count, 400);
+        EXPECT_LT(count, 600);
+    }
+}
+
+TEST(ConsistentHash, AddingShardOnlyMovesKeysToIt)
+{
+    int moved = 0;
+    for (int i = 0; i < 1000; i++)
+    {
+        auto before = consistentShard(channelName(i), 3);
+        auto after = consistentShard(channelName(i), 4);
+
+        if (before != after)
+        {
+            EXPECT_EQ(after, 3);
+            moved++;
+        }
+    }
+
+    // Roughly a quarter of the keys should move to the new shard
+    EXPECT_GT(moved, 150);
+    EXPECT_LT(moved, 350);
+}
@@ -0,0 +1,99 @@
+#include "widgets/helper/EmoteGridModel.hpp"
+
+#include "messages/Emote.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+EmoteGridSection makeSection(const QString &title,
+                             const std::vector<QString> &names)
+{
+    EmoteGridSection section{title, {}, {}};
+    for (const auto &name : names)
+    {
+        section.items.push_back({name, name, name, nullptr});
+    }
+    return section;
+}
+
+std::vector<QString> itemNames(const EmoteGridSection &section)
+{
+    std::vector<QString> names;
+    for (const auto &item : section.items)
+    {
+        names.push_back(item.name);
+    }
+    return names;
+}
+
+}  // namespace
+
+TEST(EmoteGridModel, FiltersCaseInsensitive)
+{
+    EmoteGridModel model;
+    model.addSection(makeSection("Twitch", {"Kappa", "PogChamp", "KappaHD"}));
+    model.addSection(makeSection("BetterTTV", {"FeelsBadMan", "monkaS"}));
+    model.addSection(makeSection("FrankerFaceZ", {"ZreknarF", "kappaRoss"}));
+
+    auto positions = model.nameIndex()->search("KAPPA", {});
+    ASSERT_TRUE(positions);
+
+    auto filtered = model.filtered(*positions);
+    ASSERT_EQ(filtered.sectionCount(), 2U);
+    EXPECT_EQ(filtered.section(0).title, "Twitch");
+    EXPECT_EQ(itemNames(filtered.section(0)),
+              (std::vector<QString>{"Kappa", "KappaHD"}));
+    EXPECT_EQ(filtered.section(1).title, "FrankerFaceZ");
+    EXPECT_EQ(itemNames(filtered.section(1)),
+              (std::vector<QString>{"kappaRoss"}));
+}
+
+TEST(EmoteGridModel, NoMatches)
+{
+    EmoteGridModel model;
+    model.addSection(makeSection("Twitch", {"Kappa"}));
+
+    auto positions = model.nameIndex()->search("forsen", {});
+    ASSERT_TRUE(positions);
+    EXPECT_TRUE(positions->empty());
+    EXPECT_TRUE(model.filtered(*positions).empty());
+}
+
+TEST(EmoteGridModel, SearchCanBeCancelled)
+{
+    EmoteGridModel model;
+    model.addSection(makeSection("Twitch", {"Kappa"}));
+
+    auto positions = model.nameIndex()->search("Kappa", [] {
+        return true;
+    });
+    EXPECT_FALSE(positions);
+}
+
+TEST(EmoteGridModel, ResolvesSectionsOnce)
+{
+    int resolved = 0;
+    auto section = makeSection("Twitch", {"Kappa", "Keepo"});
+    section.resolver = [&resolved](const EmoteGridItem &item) {
+        resolved++;
+        return std::make_shared<const Emote>(Emote{EmoteName{item.name}});
+    };
+
+    EmoteGridModel model;
+    model.addSection(section);
+    EXPECT_TRUE(model.section(0).items[0].emote == nullptr);
+
+    model.resolveSection(0);
+    model.resolveSection(0);
+    EXPECT_EQ(resolved, 2);
+    EXPECT_EQ(model.section(0).items[1].emote->name.string, "Keepo");
+
+    // Resolved items are kept when filtering
+    auto filtered = model.filtered({{0, 1}});
+    filtered.resolveSection(0);
+    EXPECT_EQ(resolved, 2);
+    EXPECT_EQ(filtered.section(0).items[0].emote->name.string, "Keepo");
+}
@@ -0,0 +1,160 @@
+#include "controllers/filters/FilterCache.hpp"
+
+#include "messages/Message.hpp"
+
+#include <gtest/gtest.h>
+#include <QString>
+
+using namespace chatterino;
+
+namespace {
+
+MessagePtr makeMessage(const QString &text)
+{
+    auto message = std::make_shared<Message>();
+    message->messageText = text;
+    return message;
+}
+
+const FilterCache::Context CONTEXT{};
+
+filterparser::ContextMap makeContext(const MessagePtr &message,
+                                     bool live = false)
+{
+    return {
+        {"channel.live", live},
+        {"message.content", message->messageText},
+        {"message.length", message->messageText.length()},
+    };
+}
+
+}  // namespace
+
+TEST(FilterCache, StoresResults)
+{
+    FilterCache cache;
+    FilterRecord filter("long", "message.length > 3");
+    auto message = makeMessage("hello");
+
+    EXPECT_FALSE(cache.get(message, filter, CONTEXT));
+
+    cache.insert(message, filter, CONTEXT, true);
+    auto result = cache.get(message, filter, CONTEXT);
+    ASSERT_TRUE(result);
+    EXPECT_TRUE(*result);
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(FilterCache, EditedFilterDoesNotReuseResults)
+{
+    FilterCache cache;
+    FilterRecord filter("long", "message.length > 3");
+    // Editing a filter creates a new record with the same id
+    FilterRecord edited("long", "message.length > 10", filter.getId());
+    auto message = makeMessage("hello");
+
+    EXPECT_NE(filter.getVersion(), edited.getVersion());
+
+    cache.insert(message, filter, CONTEXT, true);
+    EXPECT_FALSE(cache.get(message, edited, CONTEXT));
+}
+
+TEST(FilterCache, DropsOldestResults)
+{
+    FilterCache cache(2);
+    FilterRecord filter("long", "message.length > 3");
+    auto first = makeMessage("a");
+    auto second = makeMessage("b");
+    auto third = makeMessage("c");
+
+    cache.insert(first, filter, CONTEXT, false);
+    cache.insert(second, filter, CONTEXT, false);
+    cache.insert(third, filter, CONTEXT, false);
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_FALSE(cache.get(first, filter, CONTEXT));
+    EXPECT_TRUE(cache.get(second, filter, CONTEXT));
+    EXPECT_TRUE(cache.get(third, filter, CONTEXT));
+}
+
+TEST(FilterCache, FilterMessageOnlyBuildsContextOnMiss)
+{
+    FilterCache cache;
+    QList<FilterRecordPtr> filters{
+        std::make_shared<FilterRecord>("long", "message.length > 3"),
+        std::make_shared<FilterRecord>("kappa",
+                                       "message.content contains \"Kappa\""),
+    };
+    auto message = makeMessage("hello Kappa");
+
+    int contextsBuilt = 0;
+    auto buildContext = [&] {
+        contextsBuilt++;
+        return makeContext(message);
+    };
+
+    EXPECT_TRUE(filterMessage(cache, filters, message, CONTEXT, buildContext));
+    EXPECT_EQ(contextsBuilt, 1);
+    EXPECT_EQ(cache.size(), 2u);
+
+    // A second view showing the same message
+    EXPECT_TRUE(filterMessage(cache, filters, message, CONTEXT, buildContext));
+    EXPECT_EQ(contextsBuilt, 1);
+}
+
+TEST(FilterCache, FilterMessageStopsAtFirstRejection)
+{
+    FilterCache cache;
+    QList<FilterRecordPtr> filters{
+        std::make_shared<FilterRecord>("long", "message.length > 3"),
+        std::make_shared<FilterRecord>("kappa",
+                                       "message.content contains \"Kappa\""),
+    };
+    auto message = makeMessage("hi");
+
+    EXPECT_FALSE(filterMessage(cache, filters, message, CONTEXT, [&] {
+        return makeContext(message);
+    }));
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(FilterCache, InvalidFilterRejects)
+{
+    FilterCache cache;
+    QList<FilterRecordPtr> filters{
+        std::make_shared<FilterRecord>("broken", "message.length >"),
+    };
+    auto message = makeMessage("hello");
+
+    EXPECT_FALSE(filterMessage(cache, filters, message, CONTEXT, [&] {
+        return makeContext(message);
+    }));
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(FilterCache, ContextIsPartOfTheKey)
+{
+    FilterCache cache;
+    QList<FilterRecordPtr> filters{
+        std::make_shared<FilterRecord>("live", "channel.live"),
+    };
+    auto message = makeMessage("hello");
+
+    FilterCache::Context offline{false, false};
+    FilterCache::Context live{true, false};
+
+    // e.g. the background refilter or /mentions, while the channel is
+    // offline
+    EXPECT_FALSE(filterMessage(cache, filters, message, offline, [&] {
+        return makeContext(message, false);
+    }));
+
+    // A view of the channel once it went live mustn't reuse that result
+    EXPECT_TRUE(filterMessage(cache, filters, message, live, [&] {
+        return makeContext(message, true);
+    }));
+
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_FALSE(*cache.get(message, *filters[0], offline));
+    EXPECT_TRUE(*cache.get(message, *filters[0], live));
+}
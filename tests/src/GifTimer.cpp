@@ -0,0 +1,52 @@
+#include "singletons/helper/GifTimer.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+TEST(AnimationBudget, StaysAtFullRateWhenIdle)
+{
+    AnimationBudget budget;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        ASSERT_EQ(budget.addFrame(2), AnimationBudget::Mode::Full);
+    }
+    ASSERT_EQ(budget.frameLength(), AnimationBudget::fullFrameLength);
+}
+
+TEST(AnimationBudget, ThrottlesUnderLoad)
+{
+    AnimationBudget budget;
+
+    // a single slow frame shouldn't throttle
+    ASSERT_EQ(budget.addFrame(50), AnimationBudget::Mode::Full);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        budget.addFrame(50);
+    }
+    ASSERT_EQ(budget.mode(), AnimationBudget::Mode::Throttled);
+    ASSERT_EQ(budget.frameLength(), AnimationBudget::throttledFrameLength);
+}
+
+TEST(AnimationBudget, ResumesAfterLoadDrops)
+{
+    AnimationBudget budget;
+
+    for (int i = 0; i < 20; ++i)
+    {
+        budget.addFrame(50);
+    }
+    ASSERT_EQ(budget.mode(), AnimationBudget::Mode::Throttled);
+
+    // the first calm frames keep the throttle (hysteresis)
+    budget.addFrame(0);
+    ASSERT_EQ(budget.mode(), AnimationBudget::Mode::Throttled);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        budget.addFrame(0);
+    }
+    ASSERT_EQ(budget.mode(), AnimationBudget::Mode::Full);
+}
@@ -0,0 +1,425 @@
+#include "util/ImageUploader.hpp"
+
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QImage>
+#include <QPointer>
+#include <QRegularExpression>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <thread>
+
+using namespace chatterino;
+
+namespace {
+
+// Zlib level Qt's PNG writer uses for a quality
+int pngCompressionLevel(int quality)
+{
+    return (100 - quality) * 9 / 91;
+}
+
+// Minimal HTTP server on localhost that stands in for the upload host
+class FakeUploadServer
+{
+public:
+    FakeUploadServer()
+    {
+        this->server_.listen(QHostAddress::LocalHost, 0);
+
+        QObject::connect(&this->server_, &QTcpServer::newConnection, [this] {
+            while (auto *socket = this->server_.nextPendingConnection())
+            {
+                QObject::connect(socket, &QTcpSocket::readyRead,
+                                 [this, socket] {
+                                     this->read(socket);
+                                 });
+            }
+        });
+    }
+
+    QUrl url() const
+    {
+        return QUrl(QString("http://127.0.0.1:%1/upload")
+                        .arg(this->server_.serverPort()));
+    }
+
+    // Answers the oldest request that hasn't been answered yet
+    void respond()
+    {
+        if (this->pending_.empty())
+        {
+            return;
+        }
+
+        auto socket = this->pending_.front();
+        this->pending_.pop_front();
+        if (socket == nullptr)
+        {
+            return;
+        }
+
+        socket->write("HTTP/1.1 " + QByteArray::number(this->status) +
+                      " Status\r\nContent-Type: application/json\r\n"
+                      "Content-Length: " +
+                      QByteArray::number(this->body.size()) + "\r\n\r\n" +
+                      this->body);
+    }
+
+    int pendingCount() const
+    {
+        return int(this->pending_.size());
+    }
+
+    // Requests are answered right away unless this is set
+    bool holdResponses = false;
+    int status = 200;
+    QByteArray body = R"({"link": "https://i.example.com/abc.png",)"
+                      R"( "delete": "https://i.example.com/delete/abc"})";
+
+    int requestCount = 0;
+
+private:
+    void read(QTcpSocket *socket)
+    {
+        static const QRegularExpression contentLength(
+            R"(content-length:\s*(\d+))",
+            QRegularExpression::CaseInsensitiveOption);
+
+        auto &buffer = this->buffers_[socket];
+        buffer += socket->readAll();
+
+        while (true)
+        {
+            auto headerEnd = buffer.indexOf("\r\n\r\n");
+            if (headerEnd < 0)
+            {
+                return;
+            }
+
+            auto headers = QString::fromLatin1(buffer.left(headerEnd));
+            auto match = contentLength.match(headers);
+            auto length = match.hasMatch() ? match.captured(1).toInt() : 0;
+            auto requestEnd = headerEnd + 4 + length;
+            if (buffer.size() < requestEnd)
+            {
+                return;
+            }
+            buffer.remove(0, requestEnd);
+
+            this->requestCount++;
+            this->pending_.push_back(socket);
+            if (!this->holdResponses)
+            {
+                this->respond();
+            }
+        }
+    }
+
+    QTcpServer server_;
+    QHash<QTcpSocket *, QByteArray> buffers_;
+    std::deque<QPointer<QTcpSocket>> pending_;
+};
+
+// ImageUploader, its encoders and the network callbacks all use the GUI
+// thread, the tests themselves run on a different one (see main.cpp)
+void runInGuiThread(const std::function<void()> &fn)
+{
+    QMetaObject::invokeMethod(qApp, fn, Qt::BlockingQueuedConnection);
+}
+
+bool waitFor(const std::function<bool()> &condition, int timeoutMs = 5000)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!condition())
+    {
+        if (timer.elapsed() > timeoutMs)
+        {
+            return false;
+        }
+
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+RawImageData makeImageData()
+{
+    return {"not really a png", "png", QString()};
+}
+
+int countState(const std::vector<ImageUploader::Item> &items,
+               ImageUploader::State state)
+{
+    return int(std::count_if(items.begin(), items.end(),
+                             [state](const ImageUploader::Item &item) {
+                                 return item.state == state;
+                             }));
+}
+
+}  // namespace
+
+TEST(ImageUploader, SmallImagesStayLossless)
+{
+    auto encoding = chooseImageEncoding(QSize(300, 200), false);
+    EXPECT_STREQ(encoding.format, "png");
+    EXPECT_EQ(encoding.quality, 50);
+}
+
+TEST(ImageUploader, MediumImagesCompressFaster)
+{
+    auto encoding = chooseImageEncoding(QSize(1280, 1024), true);
+    EXPECT_STREQ(encoding.format, "png");
+
+    // Level 0 would store the image without compressing it
+    auto level = pngCompressionLevel(encoding.quality);
+    EXPECT_GE(level, 1);
+    EXPECT_LT(level, pngCompressionLevel(
+                         chooseImageEncoding(QSize(300, 200), true).quality));
+}
+
+TEST(ImageUploader, EncodeMediumImageCompresses)
+{
+    // A window screenshot with some transparency, so it stays PNG
+    QImage image(1280, 1024, QImage::Format_ARGB32);
+    for (int y = 0; y < image.height(); y++)
+    {
+        auto *line = reinterpret_cast<QRgb *>(image.scanLine(y));
+        for (int x = 0; x < image.width(); x++)
+        {
+            line[x] = (x / 8 + y / 16) % 3 == 0 ? qRgba(30, 30, 30, 255)
+                                                : qRgba(220, 220, 220, 255);
+        }
+    }
+    image.setPixel(0, 0, qRgba(0, 0, 0, 0));
+
+    auto data = encodeImage(image);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->format, "png");
+    EXPECT_LT(data->data.size(), image.width() * image.height() * 4 / 10);
+}
+
+TEST(ImageUploader, LargeOpaqueImagesUseJpeg)
+{
+    EXPECT_STREQ(chooseImageEncoding(QSize(2560, 1440), false).format,
+                 "jpeg");
+    // JPEG would drop the transparency
+    EXPECT_STREQ(chooseImageEncoding(QSize(2560, 1440), true).format, "png");
+}
+
+TEST(ImageUploader, EncodeImage)
+{
+    QImage image(16, 16, QImage::Format_RGB32);
+    image.fill(Qt::red);
+
+    auto data = encodeImage(image, "/tmp/red.png");
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->format, "png");
+    EXPECT_EQ(data->filePath, "/tmp/red.png");
+
+    auto decoded = QImage::fromData(data->data, "png");
+    ASSERT_FALSE(decoded.isNull());
+    EXPECT_EQ(decoded.size(), image.size());
+    EXPECT_EQ(decoded.pixel(8, 8), image.pixel(8, 8));
+}
+
+TEST(ImageUploader, EncodeLargeScreenshot)
+{
+    // Opaque, even though it has an alpha channel
+    QImage image(2560, 1440, QImage::Format_ARGB32);
+    image.fill(Qt::blue);
+
+    auto data = encodeImage(image);
+    ASSERT_TRUE(data);
+    EXPECT_EQ(data->format, "jpeg");
+    EXPECT_FALSE(QImage::fromData(data->data, "jpeg").isNull());
+}
+
+TEST(ImageUploader, EncodeNullImage)
+{
+    EXPECT_FALSE(encodeImage(QImage()));
+}
+
+TEST(ImageUploader, UploadsAndExtractsLinks)
+{
+    runInGuiThread([] {
+        FakeUploadServer server;
+        ImageUploader::Options options;
+        options.url = server.url();
+        options.linkPattern = "{link}";
+        options.deletionLinkPattern = "{delete}";
+
+        auto uploader = std::make_shared<ImageUploader>([&] {
+            return options;
+        });
+
+        std::vector<ImageUploader::Result> results;
+        uploader->uploaded.connect([&](const ImageUploader::Result &result) {
+            results.push_back(result);
+        });
+
+        auto id = uploader->add(makeImageData());
+
+        ASSERT_TRUE(waitFor([&] {
+            return results.size() == 1;
+        }));
+        EXPECT_EQ(results[0].id, id);
+        EXPECT_EQ(results[0].link, "https://i.example.com/abc.png");
+        EXPECT_EQ(results[0].deletionLink,
+                  "https://i.example.com/delete/abc");
+        EXPECT_TRUE(uploader->items().empty());
+        EXPECT_EQ(server.requestCount, 1);
+    });
+}
+
+TEST(ImageUploader, PausesOnFailureUntilRetry)
+{
+    runInGuiThread([] {
+        FakeUploadServer server;
+        server.status = 500;
+        ImageUploader::Options options;
+        options.url = server.url();
+        options.maxConcurrentUploads = 1;
+
+        auto uploader = std::make_shared<ImageUploader>([&] {
+            return options;
+        });
+
+        int failures = 0;
+        int uploads = 0;
+        uploader->failed.connect([&](const ImageUploader::Error &) {
+            failures++;
+        });
+        uploader->uploaded.connect([&](const ImageUploader::Result &) {
+            uploads++;
+        });
+
+        uploader->add(makeImageData());
+        uploader->add(makeImageData());
+
+        ASSERT_TRUE(waitFor([&] {
+            return failures == 1;
+        }));
+        // The second image doesn't get uploaded while the first one failed
+        waitFor(
+            [] {
+                return false;
+            },
+            200);
+        EXPECT_EQ(server.requestCount, 1);
+        EXPECT_TRUE(uploader->hasFailed());
+        auto items = uploader->items();
+        ASSERT_EQ(items.size(), 2u);
+        EXPECT_EQ(items[0].state, ImageUploader::State::Failed);
+        EXPECT_EQ(items[1].state, ImageUploader::State::Queued);
+
+        server.status = 200;
+        uploader->retry();
+
+        ASSERT_TRUE(waitFor([&] {
+            return uploads == 2;
+        }));
+        EXPECT_EQ(server.requestCount, 3);
+        EXPECT_FALSE(uploader->hasFailed());
+        EXPECT_TRUE(uploader->items().empty());
+    });
+}
+
+TEST(ImageUploader, LimitsConcurrentUploads)
+{
+    runInGuiThread([] {
+        FakeUploadServer server;
+        server.holdResponses = true;
+        ImageUploader::Options options;
+        options.url = server.url();
+        options.maxConcurrentUploads = 2;
+
+        auto uploader = std::make_shared<ImageUploader>([&] {
+            return options;
+        });
+
+        int uploads = 0;
+        uploader->uploaded.connect([&](const ImageUploader::Result &) {
+            uploads++;
+        });
+
+        for (int i = 0; i < 4; i++)
+        {
+            uploader->add(makeImageData());
+        }
+
+        ASSERT_TRUE(waitFor([&] {
+            return server.pendingCount() == 2;
+        }));
+        waitFor(
+            [] {
+                return false;
+            },
+            200);
+        EXPECT_EQ(server.requestCount, 2);
+        auto items = uploader->items();
+        EXPECT_EQ(countState(items, ImageUploader::State::Uploading), 2);
+        EXPECT_EQ(countState(items, ImageUploader::State::Queued), 2);
+
+        // A finished upload makes room for the next one
+        server.respond();
+        ASSERT_TRUE(waitFor([&] {
+            return uploads == 1 && server.requestCount == 3;
+        }));
+        EXPECT_EQ(server.pendingCount(), 2);
+
+        server.holdResponses = false;
+        while (server.pendingCount() > 0)
+        {
+            server.respond();
+        }
+        ASSERT_TRUE(waitFor([&] {
+            return uploads == 4;
+        }));
+        EXPECT_EQ(server.requestCount, 4);
+    });
+}
+
+TEST(ImageUploader, ClearWhileEncoding)
+{
+    runInGuiThread([] {
+        FakeUploadServer server;
+        ImageUploader::Options options;
+        options.url = server.url();
+
+        auto uploader = std::make_shared<ImageUploader>([&] {
+            return options;
+        });
+
+        QImage image(16, 16, QImage::Format_RGB32);
+        image.fill(Qt::red);
+        uploader->add(image);
+
+        auto items = uploader->items();
+        ASSERT_EQ(items.size(), 1u);
+        EXPECT_EQ(items[0].state, ImageUploader::State::Encoding);
+
+        uploader->clear();
+        EXPECT_TRUE(uploader->items().empty());
+
+        // The encoder finishes, but the image mustn't be uploaded anymore
+        waitFor(
+            [] {
+                return false;
+            },
+            500);
+        EXPECT_TRUE(uploader->items().empty());
+        EXPECT_EQ(server.requestCount, 0);
+    });
+}
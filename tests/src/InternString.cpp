@@ -0,0 +1,111 @@
+#include "util/InternString.hpp"
+
+#include <gtest/gtest.h>
+#include <QString>
+
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+TEST(InternString, EmptyStrings)
+{
+    auto before = internedStringCount();
+
+    EXPECT_TRUE(internString(QString()).isNull());
+    EXPECT_TRUE(internString(QString("")).isEmpty());
+
+    // Empty strings are never added to the table
+    EXPECT_EQ(internedStringCount(), before);
+}
+
+TEST(InternString, SharesOneBuffer)
+{
+    // Built separately, so both have their own buffer
+    QString first = QString("forsen") + "_dedup";
+    QString second = QString("forsen_") + "dedup";
+    ASSERT_NE(first.constData(), second.constData());
+
+    auto internedFirst = internString(first);
+    auto internedSecond = internString(second);
+
+    EXPECT_EQ(internedFirst, "forsen_dedup");
+    EXPECT_EQ(internedFirst.constData(), internedSecond.constData());
+    EXPECT_NE(internedFirst.constData(),
+              internString("forsen_other").constData());
+}
+
+TEST(InternString, CountsDistinctStrings)
+{
+    auto before = internedStringCount();
+
+    std::vector<QString> interned;
+    for (int i = 0; i < 10; i++)
+    {
+        interned.push_back(internString(QString("count_%1").arg(i)));
+    }
+    EXPECT_EQ(internedStringCount(), before + 10);
+
+    // Interning them again doesn't add anything
+    for (int i = 0; i < 10; i++)
+    {
+        interned.push_back(internString(QString("count_%1").arg(i)));
+    }
+    EXPECT_EQ(internedStringCount(), before + 10);
+}
+
+TEST(InternString, PrunesUnusedStrings)
+{
+    constexpr int count = 100'000;
+    auto before = internedStringCount();
+
+    // None of these are kept, so the table drops them while it grows
+    for (int i = 0; i < count; i++)
+    {
+        internString(QString("unused_%1").arg(i));
+    }
+
+    EXPECT_LT(internedStringCount(), before + count);
+}
+
+TEST(InternString, ConcurrentInterning)
+{
+    constexpr int threadCount = 8;
+    constexpr int stringCount = 2000;
+
+    std::vector<std::vector<QString>> results(threadCount);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&results, t] {
+            auto &result = results[t];
+            result.reserve(stringCount);
+
+            // Every thread walks the strings in a different order
+            for (int i = 0; i < stringCount; i++)
+            {
+                auto index = (i + t * 251) % stringCount;
+                result.push_back(
+                    internString(QString("concurrent_%1").arg(index)));
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        for (int i = 0; i < stringCount; i++)
+        {
+            auto index = (i + t * 251) % stringCount;
+            const auto &string = results[t][i];
+
+            ASSERT_EQ(string, QString("concurrent_%1").arg(index));
+            // The first thread interned the strings in order
+            ASSERT_EQ(string.constData(), results[0][index].constData());
+        }
+    }
+}
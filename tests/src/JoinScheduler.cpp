@@ -0,0 +1,227 @@
+#include "providers/irc/JoinScheduler.hpp"
+
+#include <gtest/gtest.h>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+// Minimal IRC server on localhost that records every line it receives
+class FakeIrcServer
+{
+public:
+    FakeIrcServer()
+    {
+        this->server_.listen(QHostAddress::LocalHost, 0);
+
+        QObject::connect(&this->server_, &QTcpServer::newConnection, [this] {
+            auto *socket = this->server_.nextPendingConnection();
+            QObject::connect(socket, &QTcpSocket::readyRead, [this, socket] {
+                this->buffer_ += socket->readAll();
+
+                int end;
+                while ((end = this->buffer_.indexOf("\r\n")) >= 0)
+                {
+                    this->lines.append(
+                        QString::fromUtf8(this->buffer_.left(end)));
+                    this->buffer_.remove(0, end + 2);
+                }
+            });
+        });
+    }
+
+    quint16 port() const
+    {
+        return this->server_.serverPort();
+    }
+
+    QStringList lines;
+
+private:
+    QTcpServer server_;
+    QByteArray buffer_;
+};
+
+bool waitFor(const std::function<bool()> &condition, int timeoutMs = 2000)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    while (!condition())
+    {
+        if (timer.elapsed() > timeoutMs)
+        {
+            return false;
+        }
+
+        QCoreApplication::processEvents();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return true;
+}
+
+class JoinSchedulerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        this->socket.connectToHost(QHostAddress::LocalHost,
+                                   this->server.port());
+        ASSERT_TRUE(waitFor([this] {
+            return this->socket.state() == QAbstractSocket::ConnectedState;
+        }));
+    }
+
+    std::unique_ptr<JoinScheduler> makeScheduler(
+        int budget, int cooldown,
+        JoinScheduler::ConnectionFunction connection = nullptr)
+    {
+        return std::make_unique<JoinScheduler>(
+            budget, cooldown,
+            [this](const QString &line, int connection) {
+                this->socket.write(line.toUtf8() + "\r\n");
+                this->connections.push_back(connection);
+            },
+            [this](const QString &channelName) {
+                return this->priorities.value(channelName, 0);
+            },
+            nullptr, std::move(connection));
+    }
+
+    bool waitForLines(int count)
+    {
+        return waitFor([this, count] {
+            return this->server.lines.size() >= count;
+        });
+    }
+
+    FakeIrcServer server;
+    QTcpSocket socket;
+    QHash<QString, int> priorities;
+    std::vector<int> connections;
+};
+
+}  // namespace
+
+TEST_F(JoinSchedulerTest, PacksChannelsIntoOneLine)
+{
+    auto scheduler = this->makeScheduler(18, 100);
+
+    for (const auto &channel : {"a", "b", "c", "d", "e"})
+    {
+        scheduler->join(channel);
+    }
+    // Duplicates are ignored
+    scheduler->join("a");
+
+    ASSERT_TRUE(this->waitForLines(1));
+    EXPECT_EQ(this->server.lines, QStringList{"JOIN #a,#b,#c,#d,#e"});
+    EXPECT_EQ(scheduler->queuedCount(), 0);
+}
+
+TEST_F(JoinSchedulerTest, JoinsByPriorityWithinBudget)
+{
+    const int cooldown = 100;
+    auto scheduler = this->makeScheduler(2, cooldown);
+
+    this->priorities = {{"c4", 2}, {"c2", 1}};
+    for (const auto &channel : {"c1", "c2", "c3", "c4", "c5"})
+    {
+        scheduler->join(channel);
+    }
+
+    ASSERT_TRUE(this->waitForLines(1));
+    EXPECT_EQ(this->server.lines.back(), "JOIN #c4,#c2");
+    EXPECT_EQ(scheduler->queuedCount(), 3);
+
+    // The user switched tabs while we were waiting for the budget
+    this->priorities = {{"c5", 2}};
+
+    ASSERT_TRUE(this->waitForLines(2));
+    EXPECT_EQ(this->server.lines.back(), "JOIN #c5,#c1");
+
+    ASSERT_TRUE(this->waitForLines(3));
+    EXPECT_EQ(this->server.lines.back(), "JOIN #c3");
+    EXPECT_EQ(scheduler->queuedCount(), 0);
+}
+
+TEST_F(JoinSchedulerTest, SplitsLongLines)
+{
+    auto scheduler = this->makeScheduler(100, 100);
+
+    const int channelCount = 60;
+    for (int i = 0; i < channelCount; i++)
+    {
+        scheduler->join(QString("channel_with_a_long_name_%1").arg(i));
+    }
+
+    ASSERT_TRUE(waitFor([&] {
+        int joined = 0;
+        for (const auto &line : this->server.lines)
+        {
+            joined += line.count('#');
+        }
+        return joined == channelCount;
+    }));
+
+    EXPECT_GT(this->server.lines.size(), 1);
+    for (const auto &line : this->server.lines)
+    {
+        EXPECT_TRUE(line.startsWith("JOIN #"));
+        EXPECT_LE(line.size(), JoinScheduler::MAX_LINE_LENGTH);
+    }
+}
+
+TEST_F(JoinSchedulerTest, CancelAndClear)
+{
+    auto scheduler = this->makeScheduler(18, 100);
+
+    scheduler->join("a");
+    scheduler->join("b");
+    scheduler->cancel("a");
+
+    ASSERT_TRUE(this->waitForLines(1));
+    EXPECT_EQ(this->server.lines, QStringList{"JOIN #b"});
+
+    scheduler->join("c");
+    scheduler->clear();
+
+    EXPECT_FALSE(waitFor(
+        [this] {
+            return this->server.lines.size() >= 2;
+        },
+        300));
+}
+
+TEST_F(JoinSchedulerTest, SplitsLinesByConnection)
+{
+    auto scheduler = this->makeScheduler(3, 100, [](const QString &channel) {
+        return channel.startsWith("odd") ? 1 : 0;
+    });
+
+    this->priorities = {{"odd_b", 1}};
+    for (const auto &channel : {"even_a", "odd_b", "even_c", "odd_d"})
+    {
+        scheduler->join(channel);
+    }
+
+    // The budget is shared between both connections
+    ASSERT_TRUE(this->waitForLines(2));
+    EXPECT_EQ(this->server.lines,
+              (QStringList{"JOIN #even_a,#even_c", "JOIN #odd_b"}));
+    EXPECT_EQ(this->connections, (std::vector<int>{0, 1}));
+
+    ASSERT_TRUE(this->waitForLines(3));
+    EXPECT_EQ(this->server.lines.back(), "JOIN #odd_d");
+    EXPECT_EQ(this->connections.back(), 1);
+}
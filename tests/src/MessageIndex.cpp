@@ -0,0 +1,152 @@
+#include "messages/MessageIndex.hpp"
+
+#include "messages/Message.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+MessagePtr makeMessage(const QString &id, const QString &loginName)
+{
+    auto message = std::make_shared<Message>();
+    message->id = id;
+    message->loginName = loginName;
+    return message;
+}
+
+}  // namespace
+
+TEST(MessageIndex, FindsAppendedMessages)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "pajlada");
+    auto c = makeMessage("c", "forsen");
+
+    index.pushBack(a);
+    index.pushBack(b);
+    index.pushBack(c);
+
+    EXPECT_EQ(index.size(), 3U);
+    EXPECT_EQ(index.findById("b"), boost::optional<size_t>(1));
+    EXPECT_EQ(index.findById("d"), boost::none);
+    EXPECT_EQ(index.positionOf(c.get()), boost::optional<size_t>(2));
+    EXPECT_EQ(index.findByUser("forsen"), (std::vector<size_t>{0, 2}));
+    EXPECT_TRUE(index.findByUser("nymn").empty());
+}
+
+TEST(MessageIndex, ShiftsPositionsWhenEvicting)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "pajlada");
+    auto c = makeMessage("c", "forsen");
+
+    index.pushBack(a);
+    index.pushBack(b);
+    index.pushBack(c);
+    index.popFront(a);
+
+    EXPECT_EQ(index.size(), 2U);
+    EXPECT_EQ(index.findById("a"), boost::none);
+    EXPECT_EQ(index.positionOf(a.get()), boost::none);
+    EXPECT_EQ(index.findById("c"), boost::optional<size_t>(1));
+    EXPECT_EQ(index.findByUser("forsen"), (std::vector<size_t>{1}));
+}
+
+TEST(MessageIndex, ShiftsPositionsWhenAddingAtStart)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "pajlada");
+    auto c = makeMessage("c", "forsen");
+
+    index.pushBack(c);
+    index.pushFront({a, b});
+
+    EXPECT_EQ(index.size(), 3U);
+    EXPECT_EQ(index.findById("a"), boost::optional<size_t>(0));
+    EXPECT_EQ(index.findById("c"), boost::optional<size_t>(2));
+    EXPECT_EQ(index.findByUser("forsen"), (std::vector<size_t>{0, 2}));
+
+    index.popFront(a);
+    EXPECT_EQ(index.findById("b"), boost::optional<size_t>(0));
+    EXPECT_EQ(index.findByUser("forsen"), (std::vector<size_t>{1}));
+}
+
+TEST(MessageIndex, ReplacesMessages)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto b = makeMessage("b", "pajlada");
+    auto c = makeMessage("c", "forsen");
+    auto replacement = makeMessage("d", "forsen");
+
+    index.pushBack(a);
+    index.pushBack(b);
+    index.pushBack(c);
+    index.replace(b, replacement);
+
+    EXPECT_EQ(index.size(), 3U);
+    EXPECT_EQ(index.findById("b"), boost::none);
+    EXPECT_EQ(index.positionOf(b.get()), boost::none);
+    EXPECT_EQ(index.findById("d"), boost::optional<size_t>(1));
+    EXPECT_TRUE(index.findByUser("pajlada").empty());
+    EXPECT_EQ(index.findByUser("forsen"), (std::vector<size_t>{0, 1, 2}));
+}
+
+TEST(MessageIndex, FindsNewestMessageWithId)
+{
+    MessageIndex index;
+    auto a = makeMessage("a", "forsen");
+    auto copy = makeMessage("a", "forsen");
+
+    index.pushBack(a);
+    index.pushBack(copy);
+    EXPECT_EQ(index.findById("a"), boost::optional<size_t>(1));
+
+    // Evicting the older one keeps the newer one
+    index.popFront(a);
+    EXPECT_EQ(index.findById("a"), boost::optional<size_t>(0));
+}
+
+TEST(MessageIndex, IgnoresMessagesWithoutIdOrUser)
+{
+    MessageIndex index;
+    auto system = makeMessage("", "");
+
+    index.pushBack(system);
+    EXPECT_EQ(index.size(), 1U);
+    EXPECT_EQ(index.positionOf(system.get()), boost::optional<size_t>(0));
+    EXPECT_EQ(index.findById(""), boost::none);
+    EXPECT_TRUE(index.findByUser("").empty());
+
+    index.popFront(system);
+    EXPECT_EQ(index.size(), 0U);
+}
+
+TEST(MessageIndex, FindsMessagesAboutUser)
+{
+    MessageIndex index;
+    auto message = makeMessage("a", "forsen");
+    auto timeout = std::make_shared<Message>();
+    timeout->timeoutUser = "forsen";
+    auto sub = std::make_shared<Message>();
+    sub->flags.set(MessageFlag::Subscription);
+    sub->messageText = "Forsen subscribed at Tier 1.";
+    auto other = makeMessage("b", "pajlada");
+
+    index.pushBack(message);
+    index.pushBack(timeout);
+    index.pushBack(sub);
+    index.pushBack(other);
+
+    EXPECT_EQ(index.findByUser("forsen"), (std::vector<size_t>{0, 1, 2}));
+    EXPECT_EQ(index.findByUser("FORSEN"), (std::vector<size_t>{0, 1, 2}));
+
+    index.popFront(message);
+    index.popFront(timeout);
+    EXPECT_EQ(index.findByUser("forsen"), (std::vector<size_t>{0}));
+}
@@ -0,0 +1,114 @@
+#include "messages/layouts/MessageLayout.hpp"
+
+#include "Application.hpp"
+#include "common/Args.hpp"
+#include "messages/Message.hpp"
+#include "messages/MessageBuilder.hpp"
+#include "messages/MessageElement.hpp"
+#include "messages/layouts/MessageLayoutElement.hpp"
+#include "singletons/Paths.hpp"
+#include "singletons/Settings.hpp"
+
+#include <gtest/gtest.h>
+#include <QApplication>
+#include <QStandardPaths>
+
+#include <functional>
+
+using namespace chatterino;
+
+namespace {
+
+const MessageElementFlags LAYOUT_FLAGS{MessageElementFlag::Default};
+
+// Laying out messages needs the fonts and themes of the application.
+// Settings are kept in Qt's test locations, away from the user's.
+void initApplication()
+{
+    // Never destroyed, like in the real application
+    static auto *app = [] {
+        QStandardPaths::setTestModeEnabled(true);
+        initArgs(*qApp);
+
+        auto *paths = new Paths;
+        auto *settings = new Settings(paths->settingsDirectory);
+        return new Application(*settings, *paths);
+    }();
+    (void)app;
+}
+
+// getApp() must only be used from the GUI thread
+void runInGuiThread(const std::function<void()> &fn)
+{
+    QMetaObject::invokeMethod(qApp, fn, Qt::BlockingQueuedConnection);
+}
+
+MessagePtr makeMessage()
+{
+    MessageBuilder builder;
+    builder.emplace<TextElement>("pajlada:", MessageElementFlag::Username,
+                                 MessageColor::Text,
+                                 FontStyle::ChatMediumBold);
+    builder.emplace<TextElement>("hello chat, this message gets selected",
+                                 MessageElementFlag::Text);
+    return builder.release();
+}
+
+}  // namespace
+
+TEST(MessageLayout, SelectsTextAfterDeleteCache)
+{
+    runInGuiThread([] {
+        initApplication();
+
+        MessageLayout layout(makeMessage());
+        layout.layout(500, 1.f, LAYOUT_FLAGS);
+
+        // Both on the only line, the first one on the username
+        const QPoint inside(30, layout.getHeight() / 2);
+        const QPoint pastEnd(490, layout.getHeight() / 2);
+
+        QString text;
+        layout.addSelectionText(text);
+        auto insideIndex = layout.getSelectionIndex(inside);
+        auto endIndex = layout.getSelectionIndex(pastEnd);
+        auto lastIndex = layout.getLastCharacterIndex();
+        ASSERT_FALSE(text.isEmpty());
+        ASSERT_GT(endIndex, insideIndex);
+
+        // Released like a view that stayed hidden for a while, the message
+        // gets laid out again when it's selected
+        layout.deleteCache();
+        EXPECT_EQ(layout.getSelectionIndex(inside), insideIndex);
+        EXPECT_EQ(layout.getSelectionIndex(pastEnd), endIndex);
+
+        layout.deleteCache();
+        QString textAfterRelease;
+        layout.addSelectionText(textAfterRelease);
+        EXPECT_EQ(textAfterRelease, text);
+
+        layout.deleteCache();
+        EXPECT_EQ(layout.getLastCharacterIndex(), lastIndex);
+
+        layout.deleteCache();
+        EXPECT_NE(layout.getElementAt(inside), nullptr);
+    });
+}
+
+TEST(MessageLayout, DeleteCacheBeforeLayout)
+{
+    runInGuiThread([] {
+        initApplication();
+
+        // Never laid out, there's nothing to select and nothing to lay out
+        // again
+        MessageLayout layout(makeMessage());
+        layout.deleteCache();
+
+        QString text;
+        layout.addSelectionText(text);
+        EXPECT_TRUE(text.isEmpty());
+        EXPECT_EQ(layout.getSelectionIndex(QPoint(30, 5)), 0);
+        EXPECT_EQ(layout.getElementAt(QPoint(30, 5)), nullptr);
+    });
+}
@@ -0,0 +1,119 @@
+#include "messages/layouts/MessageLayoutCache.hpp"
+
+#include "messages/Message.hpp"
+#include "messages/MessageElement.hpp"
+#include "messages/layouts/MessageLayoutContainer.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+MessageLayoutCache::Key makeKey(const Message *message, int width = 500)
+{
+    MessageLayoutCache::Key key{};
+    key.message = message;
+    key.width = width;
+    key.scale = 1.f;
+    key.flags = MessageElementFlag::Text;
+    return key;
+}
+
+}  // namespace
+
+TEST(MessageLayoutCache, SharesContainers)
+{
+    MessageLayoutCache cache;
+    Message message;
+    auto container = std::make_shared<MessageLayoutContainer>();
+
+    EXPECT_EQ(cache.get(makeKey(&message)), nullptr);
+
+    cache.insert(makeKey(&message), container);
+    EXPECT_EQ(cache.get(makeKey(&message)), container);
+}
+
+TEST(MessageLayoutCache, KeyIncludesLayoutParameters)
+{
+    MessageLayoutCache cache;
+    Message message;
+    Message other;
+    cache.insert(makeKey(&message),
+                 std::make_shared<MessageLayoutContainer>());
+
+    EXPECT_EQ(cache.get(makeKey(&other)), nullptr);
+    EXPECT_EQ(cache.get(makeKey(&message, 400)), nullptr);
+
+    auto key = makeKey(&message);
+    key.scale = 1.5f;
+    EXPECT_EQ(cache.get(key), nullptr);
+
+    key = makeKey(&message);
+    key.flags.set(MessageElementFlag::Timestamp);
+    EXPECT_EQ(cache.get(key), nullptr);
+
+    key = makeKey(&message);
+    key.messageFlags.set(MessageFlag::Disabled);
+    EXPECT_EQ(cache.get(key), nullptr);
+
+    key = makeKey(&message);
+    key.generation++;
+    EXPECT_EQ(cache.get(key), nullptr);
+
+    key = makeKey(&message);
+    key.settingsVersion++;
+    EXPECT_EQ(cache.get(key), nullptr);
+
+    key = makeKey(&message);
+    key.expanded = true;
+    EXPECT_EQ(cache.get(key), nullptr);
+}
+
+TEST(MessageLayoutCache, DoesNotKeepContainersAlive)
+{
+    MessageLayoutCache cache;
+    Message message;
+    auto container = std::make_shared<MessageLayoutContainer>();
+    std::weak_ptr<MessageLayoutContainer> weak = container;
+
+    cache.insert(makeKey(&message), container);
+    container.reset();
+
+    EXPECT_TRUE(weak.expired());
+    EXPECT_EQ(cache.get(makeKey(&message)), nullptr);
+}
+
+TEST(MessageLayoutCache, RemoveOnlyRemovesSameContainer)
+{
+    MessageLayoutCache cache;
+    Message message;
+    auto container = std::make_shared<MessageLayoutContainer>();
+    auto other = std::make_shared<MessageLayoutContainer>();
+
+    cache.insert(makeKey(&message), container);
+
+    cache.remove(makeKey(&message), other.get());
+    EXPECT_EQ(cache.get(makeKey(&message)), container);
+
+    cache.remove(makeKey(&message), container.get());
+    EXPECT_EQ(cache.get(makeKey(&message)), nullptr);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(MessageLayoutCache, RemovesExpiredEntries)
+{
+    MessageLayoutCache cache;
+    std::vector<Message> messages(2000);
+    auto alive = std::make_shared<MessageLayoutContainer>();
+
+    cache.insert(makeKey(&messages[0]), alive);
+    for (size_t i = 1; i < messages.size(); i++)
+    {
+        cache.insert(makeKey(&messages[i]),
+                     std::make_shared<MessageLayoutContainer>());
+    }
+
+    EXPECT_LT(cache.size(), messages.size());
+    EXPECT_EQ(cache.get(makeKey(&messages[0])), alive);
+}
@@ -0,0 +1,95 @@
+#include "util/MonotonicArena.hpp"
+
+#include <gtest/gtest.h>
+#include <QString>
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace chatterino;
+
+namespace {
+
+struct Tracked {
+    Tracked(std::vector<int> &_log, int _id)
+        : log(_log)
+        , id(_id)
+    {
+    }
+
+    ~Tracked()
+    {
+        this->log.push_back(this->id);
+    }
+
+    std::vector<int> &log;
+    int id;
+    QString payload{"some text that needs to be freed"};
+};
+
+}  // namespace
+
+TEST(MonotonicArena, DestroysInReverseOrder)
+{
+    std::vector<int> log;
+
+    {
+        MonotonicArena arena;
+        for (int i = 0; i < 5; i++)
+        {
+            auto *object = arena.create<Tracked>(log, i);
+            EXPECT_EQ(object->id, i);
+        }
+
+        EXPECT_TRUE(log.empty());
+    }
+
+    EXPECT_EQ(log, (std::vector<int>{4, 3, 2, 1, 0}));
+}
+
+TEST(MonotonicArena, ClearKeepsOneBlock)
+{
+    std::vector<int> log;
+    MonotonicArena arena(64);
+
+    for (int i = 0; i < 100; i++)
+    {
+        arena.create<Tracked>(log, i);
+    }
+    EXPECT_GT(arena.blockCount(), 1u);
+
+    arena.clear();
+    EXPECT_EQ(log.size(), 100u);
+    EXPECT_EQ(arena.blockCount(), 1u);
+
+    // Filling the arena again with the same amount of objects reuses the
+    // largest block
+    for (int i = 0; i < 10; i++)
+    {
+        arena.create<Tracked>(log, i);
+    }
+    EXPECT_EQ(arena.blockCount(), 1u);
+
+    arena.release();
+    EXPECT_EQ(log.size(), 110u);
+    EXPECT_EQ(arena.blockCount(), 0u);
+}
+
+TEST(MonotonicArena, Alignment)
+{
+    MonotonicArena arena(64);
+
+    for (int i = 0; i < 50; i++)
+    {
+        arena.create<char>('a');
+        auto *value = arena.create<double>(1.5);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(value) % alignof(double),
+                  0u);
+        EXPECT_EQ(*value, 1.5);
+    }
+
+    // Larger than a block
+    auto *big = arena.create<std::array<char, 1000>>();
+    EXPECT_NE(big, nullptr);
+}
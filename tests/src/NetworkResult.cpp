@@ -0,0 +1,56 @@
+#include "common/NetworkResult.hpp"
+
+#include <gtest/gtest.h>
+#include <QString>
+#include <QStringList>
+
+using namespace chatterino;
+
+namespace {
+
+// Collects all strings (keys excluded) of a document
+struct StringCollector
+    : rapidjson::BaseReaderHandler<rapidjson::UTF8<>, StringCollector> {
+    QStringList strings;
+    int objects = 0;
+
+    bool Key(const char * /*str*/, rapidjson::SizeType /*length*/,
+             bool /*copy*/)
+    {
+        return true;
+    }
+
+    bool String(const char *str, rapidjson::SizeType length, bool /*copy*/)
+    {
+        this->strings.append(QString::fromUtf8(str, int(length)));
+        return true;
+    }
+
+    bool StartObject()
+    {
+        this->objects++;
+        return true;
+    }
+};
+
+}  // namespace
+
+TEST(NetworkResult, ParseRapidJsonSax)
+{
+    NetworkResult result(
+        R"({"messages":["a","b ä"],"error":null,"x":{"y":"c"}})", 200);
+
+    StringCollector collector;
+    ASSERT_TRUE(result.parseRapidJsonSax(collector));
+
+    EXPECT_EQ(collector.strings, QStringList({"a", "b ä", "c"}));
+    EXPECT_EQ(collector.objects, 2);
+}
+
+TEST(NetworkResult, ParseRapidJsonSaxInvalid)
+{
+    NetworkResult result(R"({"messages":["a",)", 200);
+
+    StringCollector collector;
+    EXPECT_FALSE(result.parseRapidJsonSax(collector));
+}
@@ -0,0 +1,106 @@
+#include "providers/twitch/RecentMessagesReader.hpp"
+
+#include "common/NetworkResult.hpp"
+#include "providers/twitch/TwitchChannel.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+RecentMessagesReader readJson(const QByteArray &json, bool *ok = nullptr)
+{
+    RecentMessagesReader reader;
+    auto parsed = NetworkResult(json, 200).parseRapidJsonSax(reader);
+    if (ok != nullptr)
+    {
+        *ok = parsed;
+    }
+    return reader;
+}
+
+}  // namespace
+
+TEST(RecentMessagesReader, ReadsMessagesAndErrorCode)
+{
+    auto json = R"({
+        "messages": [":a!a@a PRIVMSG #b :hello", ":a!a@a PRIVMSG #b :bye"],
+        "error": null,
+        "error_code": "channel_not_joined"
+    })";
+
+    bool ok = false;
+    auto reader = readJson(json, &ok);
+
+    EXPECT_TRUE(ok);
+    ASSERT_EQ(reader.messages.size(), 2u);
+    EXPECT_EQ(reader.messages[0], ":a!a@a PRIVMSG #b :hello");
+    EXPECT_EQ(reader.messages[1], ":a!a@a PRIVMSG #b :bye");
+    EXPECT_EQ(reader.errorCode, "channel_not_joined");
+}
+
+TEST(RecentMessagesReader, IgnoresNestedKeys)
+{
+    auto reader = readJson(R"({
+        "meta": {
+            "messages": ["nested"],
+            "error_code": "nested"
+        },
+        "other": [["not a message"], {"messages": ["nested"]}],
+        "messages": [
+            "first",
+            ["nested"],
+            {"messages": ["nested"], "text": "nested"},
+            "second"
+        ]
+    })");
+
+    ASSERT_EQ(reader.messages.size(), 2u);
+    EXPECT_EQ(reader.messages[0], "first");
+    EXPECT_EQ(reader.messages[1], "second");
+    EXPECT_TRUE(reader.errorCode.isEmpty());
+}
+
+TEST(RecentMessagesReader, NullErrorCode)
+{
+    auto reader = readJson(R"({"messages": [], "error_code": null})");
+
+    EXPECT_TRUE(reader.messages.empty());
+    EXPECT_TRUE(reader.errorCode.isEmpty());
+}
+
+TEST(RecentMessagesReader, UnescapesStrings)
+{
+    auto reader = readJson(R"({"messages": [
+        "@display-name=a\\sb :a!a@a PRIVMSG #b :\"hi\" \\ \u00e4 \ud83d\udc27"
+    ]})");
+
+    ASSERT_EQ(reader.messages.size(), 1u);
+    EXPECT_EQ(QString::fromUtf8(reader.messages[0]),
+              QString::fromUtf8("@display-name=a\\sb :a!a@a PRIVMSG #b "
+                                ":\"hi\" \\ \xc3\xa4 \xf0\x9f\x90\xa7"));
+}
+
+TEST(RecentMessagesReader, RestoresZeroWidthJoiners)
+{
+    // Twitch replaces the joiner in combined emoji with ESCAPE_TAG
+    auto json = QString(R"({"messages": [":a!a@a PRIVMSG #b :%1%2%3"]})")
+                    .arg(QChar(0x2764), ESCAPE_TAG, QChar(0xFE0F))
+                    .toUtf8();
+
+    auto reader = readJson(json);
+
+    ASSERT_EQ(reader.messages.size(), 1u);
+    EXPECT_EQ(QString::fromUtf8(reader.messages[0]),
+              QString(":a!a@a PRIVMSG #b :%1%2%3")
+                  .arg(QChar(0x2764), ZERO_WIDTH_JOINER, QChar(0xFE0F)));
+}
+
+TEST(RecentMessagesReader, InvalidJson)
+{
+    bool ok = true;
+    readJson(R"({"messages": ["unterminated)", &ok);
+
+    EXPECT_FALSE(ok);
+}
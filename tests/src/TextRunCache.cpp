@@ -0,0 +1,65 @@
+#include "messages/layouts/TextRunCache.hpp"
+
+#include "singletons/Fonts.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+TextRunCache::Key makeKey(const QString &text, int generation = 0)
+{
+    return {text, FontStyle::ChatMedium, 1.f, generation};
+}
+
+}  // namespace
+
+TEST(TextRunCache, PreparesRepeatedRuns)
+{
+    TextRunCache cache;
+    QFont font;
+
+    // drawn directly the first time
+    EXPECT_EQ(cache.get(makeKey("LUL"), font), nullptr);
+
+    auto *run = cache.get(makeKey("LUL"), font);
+    ASSERT_NE(run, nullptr);
+    EXPECT_EQ(run->text(), "LUL");
+    EXPECT_EQ(run->textFormat(), Qt::PlainText);
+
+    EXPECT_EQ(cache.get(makeKey("LUL", 1), font), nullptr);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(TextRunCache, SkipsLongRuns)
+{
+    TextRunCache cache;
+    QFont font;
+    QString text(TextRunCache::maxLength + 1, 'a');
+
+    EXPECT_EQ(cache.get(makeKey(text), font), nullptr);
+    EXPECT_EQ(cache.get(makeKey(text), font), nullptr);
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(TextRunCache, EvictsLeastRecentlyUsed)
+{
+    TextRunCache cache(2048);
+    QFont font;
+
+    for (int i = 0; i < 100; i++)
+    {
+        auto key = makeKey(QString::number(i));
+        cache.get(key, font);
+        cache.get(key, font);
+
+        // keep the first run in use
+        cache.get(makeKey("0"), font);
+    }
+
+    EXPECT_LE(cache.usedBytes(), 2048u);
+    EXPECT_LT(cache.size(), 100u);
+    EXPECT_NE(cache.get(makeKey("0"), font), nullptr);
+    EXPECT_EQ(cache.get(makeKey("1"), font), nullptr);
+}
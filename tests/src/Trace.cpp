@@ -0,0 +1,119 @@
+#include "debug/Trace.hpp"
+
+#include <gtest/gtest.h>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+using namespace chatterino;
+
+namespace {
+
+QJsonArray dumpEvents()
+{
+    auto path = QDir::temp().filePath("chatterino-test-trace.json");
+    EXPECT_TRUE(Trace::dump(path));
+
+    QFile file(path);
+    EXPECT_TRUE(file.open(QIODevice::ReadOnly));
+
+    QJsonParseError error;
+    auto doc = QJsonDocument::fromJson(file.readAll(), &error);
+    EXPECT_EQ(error.error, QJsonParseError::NoError);
+
+    file.remove();
+
+    return doc.object().value("traceEvents").toArray();
+}
+
+int countEvents(const QJsonArray &events, const QString &name,
+                const QString &phase)
+{
+    int count = 0;
+    for (const auto &event : events)
+    {
+        auto object = event.toObject();
+        if (object.value("name").toString() == name &&
+            object.value("ph").toString() == phase)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+}  // namespace
+
+TEST(Trace, DisabledRecordsNothing)
+{
+    Trace::setEnabled(false);
+    Trace::clear();
+
+    {
+        TraceScope scope("disabled scope");
+    }
+    Trace::counter("disabled counter", 1);
+
+    auto events = dumpEvents();
+    EXPECT_EQ(countEvents(events, "disabled scope", "X"), 0);
+    EXPECT_EQ(countEvents(events, "disabled counter", "C"), 0);
+}
+
+TEST(Trace, SpansAndCounters)
+{
+    Trace::clear();
+    Trace::setEnabled(true);
+
+    for (int i = 0; i < 3; i++)
+    {
+        TraceScope scope("test scope");
+    }
+    Trace::counter("test counter", 42);
+
+    Trace::setEnabled(false);
+
+    auto events = dumpEvents();
+    EXPECT_EQ(countEvents(events, "test scope", "X"), 3);
+    ASSERT_EQ(countEvents(events, "test counter", "C"), 1);
+
+    for (const auto &event : events)
+    {
+        auto object = event.toObject();
+        if (object.value("name").toString() == "test counter")
+        {
+            EXPECT_EQ(object.value("args").toObject().value("value").toInt(),
+                      42);
+        }
+    }
+}
+
+TEST(Trace, RingBufferKeepsNewestEvents)
+{
+    Trace::clear();
+    Trace::setEnabled(true);
+
+    for (size_t i = 0; i < Trace::RING_SIZE + 10; i++)
+    {
+        Trace::counter("ring counter", int64_t(i));
+    }
+
+    Trace::setEnabled(false);
+
+    auto events = dumpEvents();
+    EXPECT_EQ(countEvents(events, "ring counter", "C"), int(Trace::RING_SIZE));
+
+    int64_t lowest = INT64_MAX;
+    for (const auto &event : events)
+    {
+        auto object = event.toObject();
+        if (object.value("name").toString() == "ring counter")
+        {
+            auto value =
+                object.value("args").toObject().value("value").toDouble();
+            lowest = std::min<int64_t>(lowest, int64_t(value));
+        }
+    }
+    EXPECT_EQ(lowest, 10);
+}
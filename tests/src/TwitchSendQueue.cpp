@@ -0,0 +1,180 @@
+#include "providers/twitch/TwitchSendQueue.hpp"
+
+#include <gtest/gtest.h>
+#include <QString>
+#include <QStringList>
+
+#include <chrono>
+
+using namespace chatterino;
+using namespace std::chrono_literals;
+
+namespace {
+
+class TwitchSendQueueTest : public ::testing::Test
+{
+protected:
+    TwitchSendQueueTest()
+        : queue(
+              [this](const QString &channelName, const QString &message) {
+                  this->sent.push_back(channelName + ":" + message);
+              },
+              [this] {
+                  return this->now;
+              })
+    {
+    }
+
+    // Advances the mock clock to the time returned by process() and
+    // processes again, like the timer in TwitchIrcServer does
+    void runUntilEmpty()
+    {
+        while (auto next = this->queue.process())
+        {
+            ASSERT_GT(*next, this->now);
+            this->now = *next;
+        }
+    }
+
+    TwitchSendQueue::Clock::time_point now{};
+    QStringList sent;
+    TwitchSendQueue queue;
+};
+
+}  // namespace
+
+TEST_F(TwitchSendQueueTest, SendsRightAwayWithinLimits)
+{
+    EXPECT_TRUE(this->queue.enqueue("a", "1", false));
+    EXPECT_TRUE(this->queue.enqueue("b", "2", false));
+
+    EXPECT_FALSE(this->queue.process().has_value());
+    EXPECT_EQ(this->sent, (QStringList{"a:1", "b:2"}));
+    EXPECT_EQ(this->queue.pendingCount(), 0);
+}
+
+TEST_F(TwitchSendQueueTest, SpacesMessagesPerChannel)
+{
+    this->queue.enqueue("a", "1", false);
+    this->queue.enqueue("a", "2", false);
+    this->queue.enqueue("b", "3", false);
+    this->queue.enqueue("a", "4", false);
+
+    auto next = this->queue.process();
+    // The spacing of a doesn't hold back b
+    EXPECT_EQ(this->sent, (QStringList{"a:1", "b:3"}));
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(*next - this->now, TwitchSendQueue::NORMAL_LIMITS.minSpacing);
+    EXPECT_EQ(this->queue.pendingCount("a"), 2);
+
+    // Nothing is sent early
+    this->now += 1s;
+    this->queue.process();
+    EXPECT_EQ(this->sent.size(), 2);
+
+    this->runUntilEmpty();
+    EXPECT_EQ(this->sent, (QStringList{"a:1", "b:3", "a:2", "a:4"}));
+    EXPECT_EQ(this->now.time_since_epoch(),
+              2 * TwitchSendQueue::NORMAL_LIMITS.minSpacing);
+}
+
+TEST_F(TwitchSendQueueTest, HighRateLimitSpacing)
+{
+    this->queue.enqueue("a", "1", true);
+    this->queue.enqueue("a", "2", true);
+
+    auto next = this->queue.process();
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(*next - this->now, TwitchSendQueue::HIGH_LIMITS.minSpacing);
+}
+
+TEST_F(TwitchSendQueueTest, WaitsForWindow)
+{
+    const auto &limits = TwitchSendQueue::NORMAL_LIMITS;
+
+    for (size_t i = 0; i < limits.maxMessages + 5; i++)
+    {
+        this->queue.enqueue(QString::number(i), "x", false);
+    }
+
+    auto start = this->now;
+    auto next = this->queue.process();
+    EXPECT_EQ(this->sent.size(), int(limits.maxMessages));
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(*next, start + limits.window);
+
+    this->runUntilEmpty();
+    EXPECT_EQ(this->sent.size(), int(limits.maxMessages) + 5);
+    EXPECT_EQ(this->now, start + limits.window);
+}
+
+TEST_F(TwitchSendQueueTest, HighRateLimitCountsAllMessages)
+{
+    const auto &normal = TwitchSendQueue::NORMAL_LIMITS;
+    const auto &high = TwitchSendQueue::HIGH_LIMITS;
+
+    for (size_t i = 0; i < normal.maxMessages; i++)
+    {
+        this->queue.enqueue(QString("mod%1").arg(i), "x", true);
+    }
+    this->queue.process();
+    EXPECT_EQ(this->sent.size(), int(normal.maxMessages));
+
+    // Messages sent in moderated channels also count against the lower limit
+    this->queue.enqueue("pleb", "x", false);
+    this->queue.enqueue("mod", "x", true);
+    auto next = this->queue.process();
+
+    EXPECT_EQ(this->sent.back(), "mod:x");
+    EXPECT_EQ(this->queue.pendingCount("pleb"), 1);
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(*next, this->now + normal.window);
+
+    // The higher limit still applies to moderated channels
+    for (size_t i = normal.maxMessages + 1; i < high.maxMessages; i++)
+    {
+        this->queue.enqueue(QString("mod%1").arg(i), "x", true);
+    }
+    this->queue.enqueue("last", "x", true);
+    this->queue.process();
+    EXPECT_EQ(this->sent.size(), int(high.maxMessages));
+    EXPECT_EQ(this->queue.pendingCount("last"), 1);
+}
+
+TEST_F(TwitchSendQueueTest, CancelAndPendingSignal)
+{
+    QStringList changed;
+    this->queue.pendingChanged.connect([&](const QString &channelName) {
+        changed.push_back(channelName);
+    });
+
+    this->queue.enqueue("a", "1", false);
+    this->queue.enqueue("a", "2", false);
+    this->queue.enqueue("a", "3", false);
+    this->queue.process();
+    EXPECT_EQ(this->queue.pendingCount("a"), 2);
+
+    changed.clear();
+    this->queue.cancel("a");
+    EXPECT_EQ(this->queue.pendingCount("a"), 0);
+    EXPECT_EQ(changed, QStringList{"a"});
+
+    // Nothing is left to send
+    this->now += 1h;
+    EXPECT_FALSE(this->queue.process().has_value());
+    EXPECT_EQ(this->sent, QStringList{"a:1"});
+
+    changed.clear();
+    this->queue.cancel("a");
+    EXPECT_TRUE(changed.isEmpty());
+}
+
+TEST_F(TwitchSendQueueTest, RejectsWhenFull)
+{
+    for (size_t i = 0; i < TwitchSendQueue::MAX_PENDING; i++)
+    {
+        ASSERT_TRUE(this->queue.enqueue("a", "x", false));
+    }
+    EXPECT_FALSE(this->queue.enqueue("a", "x", false));
+    EXPECT_EQ(this->queue.pendingCount(), TwitchSendQueue::MAX_PENDING);
+}
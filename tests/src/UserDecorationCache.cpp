@@ -0,0 +1,73 @@
+#include "providers/twitch/UserDecorationCache.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace chatterino;
+
+namespace {
+
+UserDecorations makeDecorations(const QString &usernameText)
+{
+    UserDecorations decorations;
+    decorations.usernameText = usernameText;
+    return decorations;
+}
+
+}  // namespace
+
+TEST(UserDecorationCache, ComputesOncePerKey)
+{
+    UserDecorationCache cache;
+    int computed = 0;
+    auto compute = [&] {
+        computed++;
+        return makeDecorations("forsen");
+    };
+
+    auto first = cache.get("1\nforsen", compute);
+    auto second = cache.get("1\nforsen", compute);
+
+    EXPECT_EQ(computed, 1);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(first->usernameText, "forsen");
+
+    cache.get("1\nForsen", compute);
+    EXPECT_EQ(computed, 2);
+    EXPECT_EQ(cache.size(), 2U);
+}
+
+TEST(UserDecorationCache, RecomputesAfterInvalidate)
+{
+    UserDecorationCache cache;
+    UserDecorationCache other;
+    int computed = 0;
+    auto compute = [&] {
+        computed++;
+        return makeDecorations("pajlada");
+    };
+
+    cache.get("11148817\npajlada", compute);
+    other.get("11148817\npajlada", compute);
+    EXPECT_EQ(computed, 2);
+
+    UserDecorationCache::invalidate();
+
+    cache.get("11148817\npajlada", compute);
+    other.get("11148817\npajlada", compute);
+    EXPECT_EQ(computed, 4);
+    EXPECT_EQ(cache.size(), 1U);
+}
+
+TEST(UserDecorationCache, KeepsRecentUsers)
+{
+    UserDecorationCache cache;
+
+    for (size_t i = 0; i < UserDecorationCache::maxUserCount + 10; i++)
+    {
+        cache.get(QString::number(i), [] {
+            return makeDecorations("user");
+        });
+    }
+
+    EXPECT_EQ(cache.size(), UserDecorationCache::maxUserCount);
+}